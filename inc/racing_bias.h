@@ -0,0 +1,118 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_BIAS_H
+#define RACING_BIAS_H
+
+// STL
+#include <array>
+
+// Which end of the start line is further upwind
+enum FavouredEnd {
+	FAVOURED_NONE,
+	FAVOURED_STARBOARD,
+	FAVOURED_PORT
+};
+
+// Start line bias relative to the mean true wind direction. Angles in degrees, distances in metres.
+struct LineBias {
+	// Whether both ends of the line are known and there is sufficient wind history
+	bool isValid;
+	// Rolling mean true wind direction
+	double windDirection;
+	// Bearing of the start line, from the starboard end to the port end
+	double lineBearing;
+	double lineLength;
+	// Angle between the line and a line square to the wind, positive if the port end is favoured
+	double biasAngle;
+	FavouredEnd favouredEnd;
+	// How far upwind the favoured end is, ie. the distance gained by starting there
+	double metresGained;
+};
+
+// Compares the start line bearing with a rolling circular mean of the true wind direction.
+// The mean is maintained incrementally from running sums of the sine & cosine of each sample,
+// so adding a sample is constant time. The published bias is only updated when the mean wind
+// moves by more than a threshold, or the line changes, so that consumers (eg. the chart overlay)
+// can cache derived geometry until the revision changes.
+class StartLineBias {
+public:
+	StartLineBias();
+
+	// Ends of the start line, the starboard end is usually the committee boat
+	void SetStartLine(double starboardLatitude, double starboardLongitude, double portLatitude, double portLongitude);
+	void ClearStartLine(void);
+
+	// Duration of the rolling mean
+	void SetWindow(int seconds);
+
+	// Change in the mean wind direction (degrees) before the bias is recalculated
+	void SetThreshold(double degrees);
+
+	// Add a true wind direction sample. Returns true if the published bias has changed
+	bool AddWindSample(long long timeMilliseconds, double trueWindDirection);
+
+	const LineBias& GetBias(void) const { return bias; }
+
+	// Incremented whenever the published bias changes
+	unsigned int GetRevision(void) const { return revision; }
+
+	// Initial great circle bearing (degrees, 0 - 360) from the first point to the second
+	static double BearingBetweenPoints(double latitude1, double longitude1, double latitude2, double longitude2);
+
+	// Difference between two angles, normalised to -180 .. 180 degrees
+	static double AngleDifference(double angle1, double angle2);
+
+private:
+	// 8 minutes of samples at 1Hz
+	static const int HISTORY_SIZE = 512;
+	// Samples required before the mean is considered representative
+	static const int MINIMUM_SAMPLES = 10;
+
+	struct WindSample {
+		long long time;
+		double sine;
+		double cosine;
+	};
+	std::array<WindSample, HISTORY_SIZE> history;
+	int historyCount;
+	int historyNext;
+	double sumSine;
+	double sumCosine;
+	// Samples added since the sums were last recalculated from scratch
+	int samplesSinceResync;
+
+	long long windowMilliseconds;
+	double threshold;
+
+	bool hasStartLine;
+	double starboardLatitude;
+	double starboardLongitude;
+	double portLatitude;
+	double portLongitude;
+
+	LineBias bias;
+	unsigned int revision;
+
+	// Discard samples older than the window
+	void ExpireSamples(long long timeMilliseconds);
+
+	// Recalculate the published bias for the given mean wind direction
+	void Publish(double windDirection);
+};
+
+#endif
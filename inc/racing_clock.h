@@ -0,0 +1,77 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_CLOCK_H
+#define RACING_CLOCK_H
+
+// STL
+#include <array>
+#include <chrono>
+
+// Estimates the offset between GPS (UTC) time and the local monotonic clock.
+// Time stamps arrive from NMEA 0183 ZDA/RMC or NMEA 2000 PGN 126992, each delayed by a
+// variable amount of bus & processing latency. Latency can only make a sample arrive late,
+// so the sample with the largest offset in the window is the one least affected by jitter.
+// That minimum delay estimate is then lightly smoothed to follow any drift of the local clock.
+// A step in the offset is only accepted once several consecutive samples agree on it, so a single
+// bad time stamp does not move the clock.
+class GpsClock {
+public:
+	GpsClock();
+
+	// Add a GPS time stamp, in milliseconds since 1/1/1970 UTC, stamped with the local time it was received
+	void AddSample(long long gpsMilliseconds);
+	void AddSample(long long gpsMilliseconds, long long localMilliseconds);
+
+	// Whether enough samples have been received to trust the estimate
+	bool IsSynchronised(void) const;
+
+	// Current GPS time in milliseconds since 1/1/1970 UTC
+	long long GetUTCMilliseconds(void) const;
+
+	// Spread of the offsets in the window, an indication of bus latency jitter
+	long long GetJitter(void) const;
+
+	// Discard all samples, for example if the time source changes
+	void Reset(void);
+
+	// Local monotonic clock, unaffected by changes to the computer's wall clock
+	static long long GetLocalMilliseconds(void);
+
+	// Convert a UTC date & time to milliseconds since 1/1/1970
+	static long long ToEpochMilliseconds(int year, int month, int day, double secondsOfDay);
+
+private:
+	// Number of samples in the sliding window, at 1Hz this is 16 seconds
+	static const int WINDOW_SIZE = 16;
+	// Minimum number of samples before the estimate is used
+	static const int MINIMUM_SAMPLES = 3;
+	// Offsets that differ by more than this are a step, eg. first fix or time source change, not drift
+	static const long long STEP_THRESHOLD = 2000;
+
+	std::array<long long, WINDOW_SIZE> offsets;
+	int sampleCount;
+	int nextSample;
+	long long estimatedOffset;
+
+	// Samples that have stepped away from the estimate, held until there are enough to re-anchor to
+	std::array<long long, MINIMUM_SAMPLES> pendingOffsets;
+	int pendingCount;
+	bool AddPendingStep(long long offset);
+};
+
+#endif
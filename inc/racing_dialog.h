@@ -37,6 +37,9 @@
 
 #include <wx/log.h>
 
+// Bearing between the ends of the start line
+#include "racing_bias.h"
+
 // image for dialog icon
 extern wxBitmap pluginBitmap;
 
@@ -85,7 +88,6 @@ private:
 	double intersectLongitude;
 	// Distance & Bearing functions
 	bool CalculateIntersection(double latitude1, double longitude1, double  bearing1, double latitude2, double longitude2, double bearing2, double *lat3, double *lon3);
-	double BearingBetweenPoints(double latitude1, double longitude1, double latitude2, double longitude2);
 	double HaversineFormula(double latutude1, double longitude1, double latitude2, double longitude2);
 	double SphericalCosines(double latitude1, double longitude1, double latitude2, double longitude2);
 	double Bearing(double latitude1, double longitude1, double latitude2, double longitude2);
@@ -27,9 +27,149 @@
 
 #include <wx/graphics.h>
 #include <wx/dcbuffer.h>
+#include <wx/timer.h>
 
-#include "ocpn_plugin.h"
+// A quantity as displayed by the gauge, rounded to its display resolution. It is only considered
+// to have changed once the underlying value moves past the rounding boundary by the hysteresis 
+// (a fraction of the resolution), so that noise around a boundary does not cause repaints.
+class DisplayValue {
+public:
+	DisplayValue(double resolution, double hysteresis, bool isAngle = false);
+	// Returns true if the displayed value has changed
+	bool Update(double value);
+	double GetValue(void) const { return displayed; }
+private:
+	double resolution;
+	double hysteresis;
+	bool isAngle;
+	double displayed;
+};
+
+// The values drawn by the gauge, as rounded for display. Speeds are in knots, angles in degrees
+struct GaugeValues {
+	double magneticHeading = 0.0f;
+	double trueHeading = 0.0f;
+	double bearingToWaypoint = 0.0f;
+	// The wind angles are those of the needles as drawn, which may be part way through an animation
+	double apparentWindAngle = 0.0f;
+	double trueWindAngle = 0.0f;
+	double apparentWindSpeed = 0.0f;
+	double trueWindSpeed = 0.0f;
+	double boatSpeed = 0.0f;
+	double waterDepth = 0.0f;
+	double courseOverGround = 0.0f;
+	double speedOverGround = 0.0f;
+	double driftAngle = 0.0f;
+	double driftSpeed = 0.0f;
+	double velocityMadeGood = 0.0f;
+	bool nightMode = false;
+	bool displayBearingToWaypoint = false;
+	double timeToBurn = 0.0f;
+	double probabilityOver = 0.0f;
+	bool displayStartPrediction = false;
+	// The user's speed units, and the conversion from knots
+	wxString speedUnits = "kn";
+	double speedConversion = 1.0;
+};
+
+// Draws the "Wind Wizard" gauge into any device context, so the gauge can be rendered offscreen
+// into a wxMemoryDC, eg. to measure or compare its output, without a window or OpenCPN.
+// Layers that rarely change are cached as bitmaps and only rebuilt when the size, colour scheme,
+// display scaling or heading change, the needles and values are drawn on every call.
+class WindWizardRenderer {
+public:
+	WindWizardRenderer();
+
+	GaugeValues values;
+
+	// Draw the complete gauge, sized to fill the given size
+	void Render(wxDC& dc, const wxSize& size);
+
+	// Whether the gauge has been laid out, until then the regions below are unknown
+	bool IsLaidOut(void) const { return staticLayer.IsOk(); }
+	wxSize GetSize(void) const { return layerSize; }
+	double GetRadius(void) const { return radius; }
+	wxCoord GetLabelHeight(void) const { return labelHeight; }
+
+	// Screen regions occupied by the dynamic parts of the gauge
+	wxRect GetNeedleRect(double angle) const;
+	wxRect GetBearingRect(double bearing) const;
+	wxRect GetCornerRect(bool isRight, bool isBottom) const;
+	wxRect GetCentreRect(double yOffset, double height) const;
+
+	// Smoothed duration of Render (microseconds) and the number of frames rendered
+	double GetAverageRenderTime(void) const { return averageRenderTime; }
+	long long GetFrameCount(void) const { return frameCount; }
+
+private:
+	double CalculateOffset(double radius, double halfWidth);
+	wxString CreateLabel(double value, wxString units);
+
+	// Static parts of the gauge are cached, rebuilt only if the size, colour scheme or display scaling change
+	wxBitmap staticLayer;
+	wxSize layerSize;
+	bool layerNightMode = false;
+	double layerScale = 0.0f;
+	void BuildStaticLayer(void);
+	// The static layer plus the compass card, rebuilt only if the heading changes by a degree
+	wxBitmap cardLayer;
+	int cardHeading = -1;
+	void BuildCompassCard(void);
+	// Needles and values, drawn on every repaint
+	void DrawDynamicLayer(wxDC& dc, wxGraphicsContext* gc);
+	// Dimensions of the dial and fonts, calculated when the static layer is rebuilt
+	double xCentre = 0.0f;
+	double yCentre = 0.0f;
+	double radius = 0.0f;
+	double outerRing = 0.0f;
+	double innerRing = 0.0f;
+	wxFont textFont;
+	wxFont headingFont;
+	wxFont labelFont;
+	// Pen widths in proportion to the dial
+	int thickPen = 2;
+	int thinPen = 1;
+	// Height of the corner labels
+	wxCoord labelHeight = 0;
+
+	// Compass card labels and their angular offsets, calculated when the static layer is rebuilt
+	static const int COMPASS_LABEL_COUNT = 12;
+	wxString compassLabels[COMPASS_LABEL_COUNT];
+	double compassLabelOffsets[COMPASS_LABEL_COUNT];
 
+	// Formatted values and their extents, so labels are only formatted and measured when the displayed value changes
+	enum LabelSlot {
+		LABEL_HEADING,
+		LABEL_STW,
+		LABEL_VMG,
+		LABEL_SOG,
+		LABEL_TWS,
+		LABEL_AWS,
+		LABEL_BURN,
+		LABEL_DRIFT,
+		LABEL_COUNT
+	};
+	struct CachedLabel {
+		long long key = 0;
+		int generation = -1;
+		wxString units;
+		wxString text;
+		wxCoord width = 0;
+		wxCoord height = 0;
+	};
+	CachedLabel labelCache[LABEL_COUNT];
+	// Incremented whenever the fonts are recreated, invalidating the cache
+	int labelGeneration = 0;
+	CachedLabel* FindLabel(LabelSlot slot, long long key, const wxString& units = wxEmptyString);
+	CachedLabel& StoreLabel(LabelSlot slot, long long key, const wxString& text, wxDC& dc, const wxFont& font, const wxString& units = wxEmptyString);
+	CachedLabel& GetValueLabel(LabelSlot slot, double value, const wxString& units, wxDC& dc);
+
+	double averageRenderTime = 0.0;
+	long long frameCount = 0;
+};
+
+// The "Wind Wizard" gauge as a control. Decides what has changed and needs repainting, and animates
+// the needles, the drawing itself is left to the renderer
 class WindWizard : public wxControl {
 public:
 	WindWizard(wxWindow* parent);
@@ -49,7 +189,17 @@ public:
 	void SetDriftSpeed(double driftSpeed);
 	void SetDriftAngle(double driftAngle);
 	void ShowBearing(bool show);
+	void SetStartPrediction(double timeToBurn, double probabilityOver);
+	void ShowStartPrediction(bool show);
 	void SetNightMode(bool mode);
+	// Speed units as displayed, and the conversion from knots
+	void SetSpeedUnits(const wxString& units, double conversion);
+	// Physical pixels per logical pixel of the display, to scale the minimum size
+	void SetDisplayScale(double scale);
+	// Repaint only those regions of the gauge whose displayed values have changed
+	void UpdateDisplay(void);
+	// Frame rate at which the wind needles are interpolated between updates, zero to disable
+	void SetAnimationRate(int framesPerSecond);
 
 protected:
 	void OnPaint(wxPaintEvent& evt);
@@ -58,25 +208,53 @@ protected:
 
 private:
 	wxWindow* parentWindow;
-	double CalculateOffset(double radius, double halfWidth);
-	wxString CreateLabel(double value, wxString units);
 	double NormalizeHeading(double& heading);
-	double magneticHeading = 0.0f;
-	double trueHeading = 0.0f;
-	double bearingToWaypoint = 0.0f;
-	double apparentWindAngle = 0.0f;
-	double trueWindAngle = 0.0f;
-	double trueWindDirection = 0.0f;
-	double apparentWindSpeed = 0.0f;
-	double trueWindSpeed = 0.0f;
-	double boatSpeed = 0.0f;
-	double waterDepth = 0.0f;
-	double courseOverGround = 0.0f;
-	double speedOverGround = 0.0f;
-	double driftAngle = 0.0f;
-	double driftSpeed = 0.0f;
-	double velocityMadeGood;
-	bool nightMode = false;
-	bool displayBearingToWaypoint = false;
+
+	WindWizardRenderer renderer;
+	// Shorthand for the values drawn by the renderer
+	GaugeValues& values;
+
+	// Display resolution & hysteresis of each displayed quantity
+	DisplayValue magneticHeadingDisplay = DisplayValue(1.0, 0.25, true);
+	DisplayValue bearingDisplay = DisplayValue(1.0, 0.25, true);
+	DisplayValue apparentWindAngleDisplay = DisplayValue(1.0, 0.25, true);
+	DisplayValue trueWindAngleDisplay = DisplayValue(1.0, 0.25, true);
+	DisplayValue apparentWindSpeedDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue trueWindSpeedDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue boatSpeedDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue speedOverGroundDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue velocityMadeGoodDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue driftAngleDisplay = DisplayValue(1.0, 0.25, true);
+	DisplayValue driftSpeedDisplay = DisplayValue(0.1, 0.25);
+	DisplayValue timeToBurnDisplay = DisplayValue(1.0, 0.25);
+
+	// Regions to be repainted by the next call to UpdateDisplay
+	wxRegion dirtyRegion;
+	bool isFullRefresh = true;
+	void Invalidate(const wxRect& rect);
+	void InvalidateAll(void);
+
+	// Needle animation. The wind needles move from where they are drawn to their latest value
+	// over the interval between updates, so sensor rate and render rate are independent
+	struct NeedleAnimation {
+		double start;
+		double target;
+	};
+	NeedleAnimation apparentWindNeedle = { 0.0, 0.0 };
+	NeedleAnimation trueWindNeedle = { 0.0, 0.0 };
+	wxTimer animationTimer;
+	long long animationStart = 0;
+	long long animationDuration = 1000;
+	long long lastUpdateTime = 0;
+	// Configured frame rate, and the current frame rate which may be reduced if painting is too slow
+	int animationRate = 0;
+	int frameRate = 0;
+	// Number of consecutive frames within budget
+	int framesWithinBudget = 0;
+	void OnAnimationTimer(wxTimerEvent& event);
+	void StartAnimation(void);
+	void MoveNeedle(double& drawnAngle, const NeedleAnimation& needle, double fraction);
+	void AdjustFrameRate(void);
+	static long long GetMilliseconds(void);
 };
-#endif
\ No newline at end of file
+#endif
@@ -31,6 +31,9 @@
 // pIDC implements a layer on top of OpenGL
 #include "pidc.h"
 
+// OpenCPN display scaling
+#include "ocpn_plugin.h"
+
 class RacingGraphics : public piDC {
 private:
     double scaleFactor = 1.0f;
@@ -63,6 +66,19 @@ public:
         return scaleFactor;
     };
 
+    // Physical pixels per logical pixel of the display. OpenGL overlays are drawn in physical
+    // pixels, so sizes given in logical pixels are multiplied by this
+    static double GetDisplayScaleFactor() {
+#if defined (__WXMSW__)
+        // Windows reports logical per physical pixel, eg. 0.5 at 200%
+        double dipFactor = OCPN_GetWinDIPScaleFactor();
+        double factor = dipFactor > 0.0 ? 1.0 / dipFactor : 1.0;
+#else
+        double factor = OCPN_GetDisplayContentScaleFactor();
+#endif
+        return factor > 0.0 ? factor : 1.0;
+    };
+
     void SetContentScaleFactor(double factor) { 
         scaleFactor = factor; 
     };
@@ -0,0 +1,148 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_HISTORY_H
+#define RACING_HISTORY_H
+
+// Pre compiled headers
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <wx/dcbuffer.h>
+
+// STL
+#include <array>
+#include <deque>
+#include <utility>
+
+// Strip chart of the true wind direction and speed over the last 5, 20 or 60 minutes,
+// with the rolling mean direction and the extremes of the shifts either side of it.
+// The traces are drawn into a bitmap used as a circular buffer of columns, so each new sample only
+// draws a single column and scrolling is a matter of where the bitmap is split when it is blitted.
+// Each column holds the minimum & maximum of the samples within it, so the cost of a sample is the
+// same however long the window, and no shift is lost when the history is downsampled.
+// The bitmap is only redrawn in full when the size, window or colour scheme change, or a sample
+// falls outside the vertical scale.
+class WindHistory : public wxControl {
+public:
+	WindHistory(wxWindow* parent);
+	virtual ~WindHistory();
+
+	// Add a sample, expected once per second. Direction in degrees true, speed in knots
+	void AddSample(double trueWindDirection, double trueWindSpeed);
+
+	// Duration of the chart in minutes, 5, 20 or 60
+	void SetWindow(int minutes);
+	int GetWindow(void) const { return windowSeconds / 60; }
+
+	void SetNightMode(bool mode);
+
+	// The user's speed units for the labels, and the conversion from knots
+	void SetSpeedUnits(const wxString& units, double conversion);
+
+protected:
+	void OnPaint(wxPaintEvent& evt);
+	void OnEraseBackground(wxEraseEvent& evt);
+	void OnSize(wxSizeEvent& evt);
+	// Clicking the chart cycles through the windows
+	void OnLeftClick(wxMouseEvent& evt);
+
+private:
+	// An hour of samples at 1Hz, sufficient for the longest window
+	static const int HISTORY_SIZE = 3600;
+
+	// Directions are unwrapped, so that a shift through north is continuous
+	struct WindSample {
+		double direction;
+		double speed;
+	};
+	std::array<WindSample, HISTORY_SIZE> history;
+	int historyCount;
+	int historyNext;
+	long long sampleNumber;
+	double previousDirection;
+	double unwrappedDirection;
+
+	// Rolling statistics over the window
+	int windowSeconds;
+	int windowCount;
+	double sumDirection;
+	double sumSpeed;
+	// Monotonic queues of (sample number, value) giving the sliding window extremes in constant time
+	std::deque<std::pair<long long, double>> minimumDirections;
+	std::deque<std::pair<long long, double>> maximumDirections;
+	std::deque<std::pair<long long, double>> maximumSpeeds;
+	void ResetStatistics(void);
+	void AddToStatistics(const WindSample& sample);
+	const WindSample& GetSample(int age) const;
+
+	// The chart, a circular buffer of columns, below a strip of labels
+	wxBitmap plot;
+	wxSize plotSize;
+	int labelHeight;
+	int directionHeight;
+	bool isPlotValid;
+	bool plotNightMode;
+	int columnCount;
+	int columnWidth;
+	int secondsPerColumn;
+	// Next column to be drawn, the oldest column is drawn to its right
+	int nextColumn;
+	void RebuildPlot(void);
+
+	// Samples accumulated for the column being filled
+	struct Column {
+		int samples;
+		double minimumDirection;
+		double maximumDirection;
+		double minimumSpeed;
+		double maximumSpeed;
+		double lastDirection;
+		double lastSpeed;
+	};
+	Column column;
+	// Last values of the previous column, so consecutive columns join up
+	bool hasPreviousColumn;
+	double previousColumnDirection;
+	double previousColumnSpeed;
+	void ResetColumn(void);
+	void AccumulateColumn(const WindSample& sample);
+	void DrawColumn(wxDC& dc, int index);
+
+	// Vertical scales, chosen when the plot is rebuilt
+	double directionCentre;
+	double directionRange;
+	double speedMaximum;
+	int DirectionToY(double direction) const;
+	int SpeedToY(double speed) const;
+	bool IsWithinScale(const WindSample& sample) const;
+
+	bool nightMode;
+	wxString speedUnits;
+	double speedConversion;
+	wxColour GetDirectionColour(void) const;
+	wxColour GetSpeedColour(void) const;
+	wxColour GetTextColour(void) const;
+
+	// Repaint if the chart can be seen
+	void UpdateDisplay(void);
+};
+
+#endif
@@ -0,0 +1,109 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_OCS_H
+#define RACING_OCS_H
+
+// STL
+#include <array>
+
+// Results of the On Course Side (over early) prediction.
+// Distances are in metres, speeds in metres/second, times in seconds.
+// Values that cannot be calculated are NaN.
+struct OcsPrediction {
+	// Whether both ends of the start line have been pinged
+	bool isValid;
+	// Perpendicular distance from the bow to the start line, negative when on the course side
+	double distanceToLine;
+	// Speed towards the start line and its rate of change
+	double closingSpeed;
+	double acceleration;
+	// Time until the bow reaches the start line at the current speed & acceleration
+	double timeToLine;
+	// Whether the projected crossing is between the ends of the start line
+	bool isWithinLine;
+	// Time until the gun, time to burn (positive if early) and probability of being over at the gun
+	double timeToGun;
+	double timeToBurn;
+	double probabilityOver;
+};
+
+// Predicts when the bow will reach the start line and whether it will be over at the gun.
+// The closing speed history over the last few seconds gives the acceleration (least squares)
+// and the noise of the speed estimate, which together with the position uncertainty
+// determine the spread of the predicted position at the gun.
+// Independent of wxWidgets and OpenCPN so recorded starts can be replayed through it.
+class OcsPredictor {
+public:
+	OcsPredictor();
+
+	// Ends of the start line, the starboard end is usually the committee boat
+	void SetStartLine(double starboardLatitude, double starboardLongitude, double portLatitude, double portLongitude);
+	void ClearStartLine(void);
+	bool HasStartLine(void) const;
+
+	// One sigma uncertainty (metres) of the bow position relative to the line, eg. GPS error & ping radius
+	void SetPositionUncertainty(double metres);
+
+	// Update with the latest bow position, course (degrees) and speed (metres/second) over ground.
+	// If the time to the gun is unknown, pass NaN
+	const OcsPrediction& Update(long long timeMilliseconds, double latitude, double longitude,
+		double courseOverGround, double speedOverGround, double secondsToGun);
+
+	const OcsPrediction& GetPrediction(void) const { return prediction; }
+
+	// Discard the speed history, eg. after the start
+	void Reset(void);
+
+private:
+	// Closing speed history used for the acceleration estimate
+	static const int HISTORY_SIZE = 64;
+	// Acceleration is only applied over a short horizon (seconds), thereafter speed is assumed constant
+	static const int ACCELERATION_HORIZON = 5;
+
+	struct SpeedSample {
+		double time;
+		double speed;
+	};
+	std::array<SpeedSample, HISTORY_SIZE> history;
+	int historyCount;
+	int historyNext;
+	long long timeOrigin;
+
+	bool hasStartLine;
+	double originLatitude;
+	double originLongitude;
+	double metresPerDegreeLongitude;
+	// Start line, from the starboard end to the port end, in metres east & north
+	double lineEast;
+	double lineNorth;
+	double lineLength;
+
+	double positionUncertainty;
+	OcsPrediction prediction;
+
+	// Least squares fit of the closing speed history, returns false if too few samples
+	bool EstimateAcceleration(double& acceleration, double& speedNoise, double& accelerationNoise) const;
+
+	// Distance travelled towards the line after the given time
+	static double DistanceTravelled(double speed, double acceleration, double seconds);
+
+	// Time to travel the given distance towards the line, NaN if never
+	static double TimeToTravel(double speed, double acceleration, double distance);
+};
+
+#endif
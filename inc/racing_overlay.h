@@ -0,0 +1,239 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_OVERLAY_H
+#define RACING_OVERLAY_H
+
+// Pre compiled headers
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include "ocpn_plugin.h"
+
+// OpenCPN Device Context Abstraction Layer
+#include "racing_graphics.h"
+
+// wxGraphicsContext for the non OpenGL overlay
+#include <wx/graphics.h>
+
+// FavouredEnd
+#include "racing_bias.h"
+
+// Projection of positions to the screen
+#include "racing_projection.h"
+
+// Performance track
+#include "racing_track.h"
+
+// STL
+#include <vector>
+
+// Everything the chart overlay draws, gathered by the plugin for each frame.
+// Positions in degrees, angles in degrees true, NaN if unavailable.
+struct OverlayInputs {
+	// Start line, coloured by the risk of being over early
+	bool showStartLine;
+	bool hasStartLine;
+	double starboardLatitude;
+	double starboardLongitude;
+	double portLatitude;
+	double portLongitude;
+	wxColour startLineColour;
+	// True wind direction, drawn at the starboard end
+	double trueWindDirection;
+	// Favoured end of the start line and the line square to the wind
+	FavouredEnd favouredEnd;
+	double squareLineLatitude;
+	double squareLineLongitude;
+	wxString biasLabel;
+	// Ring and apparent wind arrow centred on the boat
+	bool showWindAngles;
+	double boatLatitude;
+	double boatLongitude;
+	double ringRadius;
+	double apparentWindDirection;
+	double apparentWindSpeed;
+	// Our recent track, coloured by performance. Owned by the plugin, compared by revision
+	bool showTrack;
+	const TrackHistory* track;
+	unsigned int trackRevision;
+};
+
+// Interleaved position & colour, the layout expected by glVertexPointer & glColorPointer
+struct OverlayVertex {
+	float x;
+	float y;
+	unsigned char red;
+	unsigned char green;
+	unsigned char blue;
+	unsigned char alpha;
+};
+
+// All of the overlay's geometry, gathered into one batch of triangles and one batch of lines
+// so that it can be drawn with two calls, regardless of how many primitives or colours it contains.
+// Lines wider than one pixel are converted to triangles, as glLineWidth is not reliable on all drivers.
+class OverlayVertexBuffer {
+public:
+	OverlayVertexBuffer();
+
+	// Discard the geometry, retaining the allocated memory
+	void Clear(void);
+	bool IsEmpty(void) const { return triangles.empty() && lines.empty(); }
+
+	void AddLine(double x1, double y1, double x2, double y2, const wxColour& colour, double width = 1.0);
+	// Line whose colour blends from one end to the other
+	void AddGradientLine(double x1, double y1, const wxColour& colour1, double x2, double y2, const wxColour& colour2, double width = 1.0);
+	void AddDashedLine(double x1, double y1, double x2, double y2, const wxColour& colour, double dashLength, double gapLength, double width = 1.0);
+	void AddTriangle(double x1, double y1, double x2, double y2, double x3, double y3, const wxColour& colour);
+	// Filled convex polygon
+	void AddPolygon(int count, const wxPoint* points, const wxColour& colour);
+	// Outline of a polygon, or polyline
+	void AddLines(int count, const wxPoint* points, const wxColour& colour, double width = 1.0);
+	// Outline of a circle
+	void AddCircle(double x, double y, double radius, const wxColour& colour, double width = 1.0);
+
+	// Draw both batches with the currently bound GL context
+	void Draw(piDC* dc) const;
+
+private:
+	std::vector<OverlayVertex> triangles;
+	std::vector<OverlayVertex> lines;
+
+	static OverlayVertex MakeVertex(double x, double y, const wxColour& colour);
+};
+
+// Projected geometry shared by the OpenGL and device context overlays, in screen co-ordinates
+struct OverlayGeometry {
+	bool hasStartLine;
+	wxPoint starboardPoint;
+	wxPoint portPoint;
+	bool hasFavouredEnd;
+	wxPoint favouredPoint;
+	wxPoint unfavouredPoint;
+	wxPoint squarePoint;
+	bool hasLabel;
+	wxPoint labelPoint;
+	bool hasTrueWindArrow;
+	wxPoint trueWindArrow[4];
+	bool hasRing;
+	wxPoint boatPoint;
+	int ringRadius;
+	bool hasApparentWindArrow;
+	wxPoint apparentWindArrow[4];
+	wxColour apparentWindColour;
+	// Every track sample projected, and the subset to be drawn at this scale
+	bool hasTrack;
+	std::vector<float> trackX;
+	std::vector<float> trackY;
+	std::vector<unsigned int> trackIndices;
+	// Size of the viewport
+	int width;
+	int height;
+	// Pixels per logical pixel, the density at which line widths, arrows and markers were generated
+	double scale;
+	// Everything drawn, so that work can be skipped when it is off screen
+	wxRect boundingBox;
+};
+
+// Chart overlay for one canvas. Lives for the lifetime of the plugin so that drawing resources,
+// the OpenGL vertex buffer or the device context paths & brushes, are reused from frame to frame.
+// The geometry is only recalculated when the viewport or one of the inputs changes, and each
+// renderer only rebuilds its resources when the geometry changes.
+class CanvasOverlay {
+public:
+	CanvasOverlay();
+	~CanvasOverlay();
+
+	// Draw the overlay using OpenGL
+	void RenderGL(wxGLContext* context, PlugIn_ViewPort* vp, const OverlayInputs& inputs);
+
+	// Draw the overlay on a device context, when OpenGL is not available
+	void RenderDC(wxDC& dc, PlugIn_ViewPort* vp, const OverlayInputs& inputs);
+
+	// Average time (microseconds) spent drawing each frame, and the number of frames drawn
+	double GetAverageFrameTime(void) const;
+	long long GetFrameCount(void) const { return frameCount; }
+
+private:
+	// Persistent drawing context, recreated only if OpenCPN's GL context changes
+	RacingGraphics* graphics;
+
+	// Projection for the current viewport, and the inputs from which the geometry was calculated
+	ProjectionCache projection;
+	bool isGeometryValid;
+	OverlayInputs geometryInputs;
+	OverlayGeometry geometry;
+	// Incremented whenever the geometry is recalculated
+	unsigned int geometryRevision;
+
+	// OpenGL resources, and the geometry revision from which they were built
+	OverlayVertexBuffer vertexBuffer;
+	unsigned int vertexBufferRevision;
+
+	// Device context resources. Paths & brushes belong to the renderer rather than to a
+	// graphics context, so they outlive the context created for each frame.
+	wxGraphicsRenderer* renderer;
+	unsigned int pathRevision;
+	wxGraphicsPath ringPath;
+	wxGraphicsBrush ringBrush;
+	wxGraphicsPath apparentWindPath;
+	wxGraphicsBrush apparentWindBrush;
+	// Reused when drawing the track in runs of the same colour
+	std::vector<wxPoint> trackRun;
+
+	// Font for the bias label, recreated only when the scale changes
+	wxFont labelFont;
+	double labelFontScale;
+	void UpdateLabelFont(double scale);
+
+	// Frame time counter
+	long long frameCount;
+	double totalFrameTime;
+	void CountFrame(long long microseconds);
+
+	// Recalculate the geometry if the viewport, inputs or display scale have changed
+	void UpdateGeometry(PlugIn_ViewPort* vp, const OverlayInputs& inputs, double scale);
+
+	// Rebuild the renderer specific resources from the geometry
+	void BuildVertexBuffer(void);
+	void BuildPaths(wxGraphicsContext* context);
+
+	// Project the track and choose the level of detail for the chart scale
+	void UpdateTrackGeometry(PlugIn_ViewPort* vp, const TrackHistory* track);
+
+	// Whether a segment lies entirely beyond one edge of the viewport
+	static bool IsSegmentCulled(float x1, float y1, float x2, float y2, int width, int height);
+
+	// Whether any of the overlay is within the viewport
+	static bool IsVisible(const wxRect& boundingBox, PlugIn_ViewPort* vp);
+
+	static bool IsSameInputs(const OverlayInputs& inputs1, const OverlayInputs& inputs2);
+
+	// An arrow pointing in the direction from which the wind blows, from the inner to the outer radius
+	static void CalculateArrow(wxPoint* arrow, wxPoint centre, double direction, double innerRadius, double outerRadius);
+
+	// Colour of the apparent wind arrow for different wind speed ranges
+	static wxColour GetWindSpeedColour(double windSpeed);
+
+	// Colour of the track, in 5% bands from red below 70% of the target speed to green at 100% or more
+	static wxColour GetEfficiencyColour(float efficiency);
+};
+
+#endif
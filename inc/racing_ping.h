@@ -0,0 +1,74 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_PING_H
+#define RACING_PING_H
+
+// STL
+#include <vector>
+
+// Averages the positions received while sitting on a start line mark.
+// A single GPS fix may be 3 - 5 metres out, so every fix received during the ping window
+// is collected, outliers are rejected using the median absolute deviation and the
+// remaining fixes averaged. The confidence radius is the radius around the estimate
+// containing 95% of the accepted fixes.
+class MarkSampler {
+public:
+	MarkSampler();
+
+	// Begin collecting positions for the given duration
+	void Start(long long durationMilliseconds, long long timeMilliseconds);
+
+	// Abandon the ping, eg. the dialog was closed
+	void Cancel(void);
+
+	bool IsSampling(void) const;
+
+	// Add a position fix. Returns true once the ping window has elapsed and the estimate is available
+	bool AddSample(double latitude, double longitude, long long timeMilliseconds);
+
+	// Whether the ping window has elapsed, in case position fixes have stopped arriving
+	bool IsElapsed(long long timeMilliseconds) const;
+
+	// Calculate the estimate from the samples collected so far, returns false if there are none
+	bool Finish(void);
+
+	// The estimated position of the mark
+	double GetLatitude(void) const { return estimatedLatitude; }
+	double GetLongitude(void) const { return estimatedLongitude; }
+
+	// Radius in metres containing 95% of the accepted samples
+	double GetConfidenceRadius(void) const { return confidenceRadius; }
+
+	int GetSampleCount(void) const { return static_cast<int>(latitudes.size()); }
+	int GetRejectedCount(void) const { return rejectedCount; }
+
+private:
+	std::vector<double> latitudes;
+	std::vector<double> longitudes;
+	bool isSampling;
+	long long endTime;
+	double estimatedLatitude;
+	double estimatedLongitude;
+	double confidenceRadius;
+	int rejectedCount;
+
+	// Median of a vector, note that the vector is partially sorted
+	static double Median(std::vector<double>& values);
+};
+
+#endif
@@ -61,12 +61,54 @@
 // "Wind Wizard" gauge, similar to B&G SailSteer
 #include "racing_gauge.h"
 
+// Wind history strip chart
+#include "racing_history.h"
+
 // OpenGL 
 #include "pidc.h"
 
 // OpenCPN Device Context Abstraction Layer
 #include "racing_graphics.h"
 
+// GPS synchronised clock
+#include "racing_clock.h"
+
+// Averaged pings of the start line marks
+#include "racing_ping.h"
+
+// Over early (OCS) prediction
+#include "racing_ocs.h"
+
+// Start line bias & favoured end
+#include "racing_bias.h"
+
+// Persistent per canvas chart overlay
+#include "racing_overlay.h"
+
+// Learned target boat speeds
+#include "racing_targets.h"
+
+// Track history for the performance track
+#include "racing_track.h"
+
+// NMEA 0183 sentence builder
+#include "racing_sentence.h"
+
+// Scheduling of the messages we generate
+#include "racing_scheduler.h"
+
+// TCP & UDP server for the sentences we generate
+#include "racing_server.h"
+
+// HTTP & WebSocket server for the live data page
+#include "racing_webserver.h"
+
+// SignalK deltas for the values we calculate
+#include "racing_signalk.h"
+
+// Shared memory export for analysis tools
+#include "racing_shared.h"
+
 // wxWidgets include files
 
 // AUI Manager
@@ -80,6 +122,8 @@
 #include <wx/string.h>
 
 // STL
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 // Plugin receives events from the Countdown Timer dialog
@@ -88,6 +132,41 @@ const int RACE_DIALOG_CLOSED = wxID_HIGHEST + 1;
 const int RACE_DIALOG_PORT = wxID_HIGHEST + 2;
 const int RACE_DIALOG_STBD = wxID_HIGHEST + 3;
 
+// Messages we generate, identified by the order in which they are added to the output scheduler
+const int OUTPUT_MWV = 0;
+const int OUTPUT_PGN130306 = 1;
+const int OUTPUT_PGN130306_TRUE_NORTH = 2;
+const int OUTPUT_PGN130577 = 3;
+const int OUTPUT_VPW = 4;
+const int OUTPUT_VDR = 5;
+const int OUTPUT_XDR_PERFORMANCE = 6;
+const int OUTPUT_XDR_START = 7;
+const int OUTPUT_LIVE_DATA = 8;
+const int OUTPUT_SIGNALK = 9;
+const int OUTPUT_SHARED_MEMORY = 10;
+
+// Tick of the output scheduler (milliseconds)
+const int OUTPUT_TICK = 50;
+
+// Messages are not sent once their inputs are older than this (milliseconds)
+const int MAXIMUM_INPUT_AGE = 3000;
+
+// SignalK paths we publish, identified by the order in which they are added to the delta writer
+const int SIGNALK_WIND_SPEED_TRUE = 0;
+const int SIGNALK_WIND_ANGLE_TRUE = 1;
+const int SIGNALK_WIND_DIRECTION_TRUE = 2;
+const int SIGNALK_VMG = 3;
+const int SIGNALK_TARGET_SPEED = 4;
+const int SIGNALK_POLAR_RATIO = 5;
+const int SIGNALK_LINE_DISTANCE = 6;
+const int SIGNALK_TIME_TO_START = 7;
+const int SIGNALK_TIME_TO_LINE = 8;
+const int SIGNALK_TIME_TO_BURN = 9;
+const int SIGNALK_LINE_BIAS = 10;
+const int SIGNALK_SET_TRUE = 11;
+const int SIGNALK_SET_MAGNETIC = 12;
+const int SIGNALK_DRIFT = 13;
+
 // Globally accessible variables used by the plugin, dialogs etc.
 
 // Note speed, distance values are stored using OpenCPN defaut units,
@@ -108,15 +187,36 @@ double trueWindSpeed = 0.0f;
 double driftSpeed = 0.0f;
 double driftAngle = 0.0f;
 
+// Local time (milliseconds) the apparent wind, boat speed and position, course & heading were last received,
+// so that messages derived from them are not sent once they are stale
+long long apparentWindTime = 0;
+long long boatSpeedTime = 0;
+long long navigationTime = 0;
+
+// Position of the bow, derived from the GPS antenna position and heading.
+// Calculated once per position update and used for all start line calculations
+double bowLatitude = 0.0f;
+double bowLongitude = 0.0f;
+
+// Distance & time to the start line and probability of being over early.
+// Updated at full position rate, displayed by the Countdown Timer, "Wind Wizard" and chart overlay
+OcsPrediction ocsPrediction;
+
 // Protect simultaneous read & write access to latitude and longitude
 wxMutex lockPositionFix;
 
+// Offset between GPS time and the local clock, used to schedule the start gun
+GpsClock gpsClock;
+
 // Toolbar state
 bool isCountdownTimerVisible;
 
 // "Wind Wizard" gauge state
 bool isWindWizardVisible = false;
 
+// Wind history strip chart state
+bool isWindHistoryVisible = false;
+
 // Bitmap used for both the plugin and dialogs
 wxBitmap pluginBitmap;
 
@@ -127,16 +227,45 @@ bool showStartline;
 bool showLayLines;
 // If we draw an arrow indicating apparent wind angle on the screen
 bool showWindAngles;
+// If we draw our recent track, coloured by performance against the target boat speed
+bool showPerformanceTrack;
 // If we draw only on one canvas or on both when in multi canvas mode
 bool showMultiCanvas;
 // If we calculate true wind angle and speed and transmit the NMEA 2000 Message
 bool generatePGN130306;
 // If we calculate true wind angle and speed and transmit the NMEA MWV Sentence
 bool generateMWVSentence;
+// If we transmit the set & drift of the current, NMEA 2000 PGN 130577
+bool generatePGN130577;
+// If we transmit the NMEA 0183 VPW, VDR and XDR sentences with velocity made good,
+// set & drift, and our performance & start line transducers
+bool generateVPWSentence;
+bool generateVDRSentence;
+bool generateXDRSentences;
+// If the generated sentences are also served over TCP & UDP, to crew tablets for example
+bool isServerEnabled;
+int serverTcpPort;
+wxString serverUdpAddress;
+int serverUdpPort;
+// If SignalK deltas are published for the values we calculate
+bool generateSignalKDeltas;
+// If the fused state is exported to a shared memory segment, and its name
+bool isSharedMemoryEnabled;
+wxString sharedMemoryName;
+// If the live data page is served to phones & tablets
+bool isLiveDataEnabled;
+int liveDataPort;
 // Not currently implemented
 int tackingAngle;
 // Default value for the Countdown timer interval
 int defaultTimerValue;
+// Duration (seconds) over which positions are averaged when pinging a start line mark
+int pingDuration;
+// Location of the GPS antenna (metres), distance aft of the bow and distance to starboard of the centreline
+double antennaForeAft;
+double antennaAthwartships;
+// Frame rate at which the "Wind Wizard" needles are animated between updates, zero to disable
+int gaugeFrameRate;
 
 // The Racing plugin
 #if (OCPN_API_VERSION_MINOR == 18)
@@ -212,12 +341,18 @@ private:
 	// Toolbar id
 	int racingToolbarId;
 
-	// Context Menu id
+	// Context Menu ids
 	int racingContextMenuId;
+	int historyContextMenuId;
 
 	// "Wind Wizard" gauge
 	WindWizard* windWizard;
 
+	// Wind history strip chart
+	WindHistory* windHistory;
+	// Duration of the strip chart (minutes)
+	int historyWindow;
+
 	// Settings Toolbox
 	RacingToolbox* racingToolbox;
 
@@ -241,21 +376,90 @@ private:
 	// either NMEA 2000 or NMEA 0183
 	DriverHandle GetNetworkInterface(std::string protocol);
 
-	// Transmit data over the NMEA 0183 connection
-	void SendNMEA0183(wxString sentence);
+	// Values derived from our inputs once a second, displayed by the gauge and sent in the
+	// generated sentences, so that all of them agree
+	struct DerivedData {
+		// Velocity made good to windward (knots), negative when running
+		double velocityMadeGood;
+		// Target boat speed (knots), and our boat speed as a percentage of it. NaN if unknown
+		double targetSpeed;
+		double polarPercentage;
+		// Direction the current flows towards (degrees true & magnetic) and its speed (knots)
+		double setTrue;
+		double setMagnetic;
+		double drift;
+		// Distance (metres) and time (seconds) to the start line, and the time to burn (seconds). NaN if unknown
+		double lineDistance;
+		double timeToLine;
+		double timeToBurn;
+	};
+	DerivedData derivedData;
+	void UpdateDerivedData(void);
+
+	// Send the NMEA 0183 VPW, VDR and XDR sentences
+	bool GenerateVelocityMadeGoodSentence(void);
+	bool GenerateDriftSentence(void);
+	bool GeneratePerformanceSentence(void);
+	bool GenerateStartSentence(void);
+
+	// Transmit a completed sentence over the NMEA 0183 connection
+	bool SendNMEA0183(const SentenceBuilder& sentence);
+
+	// Serves the generated sentences, independently of OpenCPN's connections
+	NmeaServer nmeaServer;
+
+	// Serves the live data page, the snapshot is serialised once for every connection
+	LiveDataServer liveDataServer;
+	JsonWriter liveDataWriter;
+	bool PublishLiveData(void);
+
+	// Publish a SignalK delta with the values changed since the last, over OpenCPN messaging
+	// and to the SignalK clients of the live data server
+	SignalKDeltaWriter signalKDelta;
+	bool PublishSignalKDelta(void);
+
+	// Export the fused state to shared memory, for analysis tools on the same computer
+	SharedMemoryExport sharedMemory;
+	bool PublishSharedMemory(void);
+
+	// Whether an input last updated at inputTime is recent enough to use
+	static bool IsInputCurrent(long long inputTime, long long now);
+
+	// Reused for every sentence we generate, and the payloads passed to the NMEA 0183 driver
+	SentenceBuilder sentenceBuilder;
+	PayloadPool n183Payloads;
 
 	// Send an OpenCPN Message
 	// Not clear whether this is supported
 	void SendOCPNMessage(PluginMsgId msg_id, wxString message);
 
 	// Send a NMEA0183 True Wind Sentence
-	void GenerateTrueWindSentence(void);
+	bool GenerateTrueWindSentence(void);
+
+	// Send a NMEA 2000 True Wind message, referenced to the boat
+	bool GenerateTrueWindMessage(void);
+
+	// Send a NMEA 2000 True Wind Direction message, referenced to true north
+	bool GenerateTrueWindDirectionMessage(void);
 
-	// Send a NMEA 2000 True Wind message
-	void GenerateTrueWindMessage(void);
+	// Send a NMEA 2000 Direction Data message with the set & drift of the current
+	bool GenerateDriftMessage(void);
 
-	// Calculate NMEA 0183 XOR Checksum
-	wxString ComputeChecksum(wxString sentence);
+	// Transmit a message over the NMEA 2000 connection, the payloads are reused
+	bool SendNMEA2000(const tN2kMsg& N2kMsg);
+	PayloadPool n2kPayloads;
+	// Register the PGN's of the enabled NMEA 2000 outputs
+	void RegisterTransmittedPGNs(void);
+	// Sequence identifier, shared by the messages sent on the same tick
+	unsigned char n2kSequenceId;
+
+	// Each generated message is sent at its own rate and priority
+	OutputScheduler outputScheduler;
+	wxTimer* outputTimer;
+	void OnOutputTimer(wxTimerEvent& event);
+	// Time the inputs of a message were last updated, and send it
+	long long GetOutputInputTime(int output);
+	bool SendOutput(int output);
 
 	// Maintain positions for the next waypoint / racing mark, so that a bearing can be calculated
 	bool isWaypointActive = false;
@@ -275,6 +479,14 @@ private:
 	void HandleVHW(ObservedEvt ev);
 	std::shared_ptr<ObservableListener> listener_vhw;
 
+	// NMEA 0183 ZDA Time & Date
+	void HandleZDA(ObservedEvt ev);
+	std::shared_ptr<ObservableListener> listener_zda;
+
+	// NMEA 0183 RMC Recommended Minimum, used for GPS time
+	void HandleRMC(ObservedEvt ev);
+	std::shared_ptr<ObservableListener> listener_rmc;
+
 	// OpenCPN's position, speed, heading etc.
 	// Used instead of parsing NMEA 0183, NMEA 2000 or Signalk position data
 	void HandleNavData(ObservedEvt ev);
@@ -292,6 +504,13 @@ private:
 	void HandleN2K_128267(ObservedEvt ev);
 	std::shared_ptr<ObservableListener> listener_128267;
 
+	// NMEA 2000 System Time
+	void HandleN2K_126992(ObservedEvt ev);
+	std::shared_ptr<ObservableListener> listener_126992;
+
+	// Convert NMEA 0183 hhmmss.ss time and the date to milliseconds since 1/1/1970
+	long long ParseNMEA0183Time(wxString utcTime, int year, int month, int day);
+
 	// SignalK listener
 #if (OCPN_API_VERSION_MINOR == 19)
 	void HandleSignalK(ObservedEvt ev);
@@ -321,6 +540,9 @@ private:
 	// Calculate Drift using difference between COG & Heading.
 	void CalculateDrift();
 
+	// Offset the GPS antenna position to the bow using the heading
+	void CalculateBowPosition();
+
 	// One second timer to update the "Wind Wizard" gauge
 	wxTimer* oneSecondTimer;
 	void OnTimerElapsed(wxTimerEvent& event);
@@ -338,6 +560,42 @@ private:
 	// OpenCPN's Own Ship Heading Predictor Length
 	int headingPredictorLength;
 
+	// Averages the positions received whilst pinging each end of the start line
+	MarkSampler starboardSampler;
+	MarkSampler portSampler;
+	void StartPing(int markId);
+	void CompletePing(int markId);
+
+	// Create or update in place the waypoint for an end of the start line
+	void UpdateStartLineMark(int markId, double latitude, double longitude, double confidenceRadius, int sampleCount);
+
+	// Predicts time to the line, time to burn and whether we'll be over at the gun
+	OcsPredictor ocsPredictor;
+	void UpdateStartLinePrediction(void);
+
+	// Colour of the start line on the chart, warns if we are likely to be over early
+	wxColour GetStartLineColour(void);
+
+	// Start line bias from the rolling mean true wind direction
+	StartLineBias startLineBias;
+	void UpdateStartLineBias(void);
+	// Geometry of the favoured end overlay, only recalculated when the bias revision changes
+	unsigned int biasRevision;
+	double squareLineLatitude;
+	double squareLineLongitude;
+	wxString biasLabel;
+
+	// Target boat speeds learned from our own performance, and our track coloured by them
+	PerformanceTargets performanceTargets;
+	TrackHistory trackHistory;
+	// Boat speed as a fraction of the target, NaN if unknown or the wind & boat speed are stale
+	double trackEfficiency;
+
+	// Chart overlay, one per canvas, kept for the lifetime of the plugin
+	CanvasOverlay* canvasOverlays[2];
+	// Gather everything the chart overlay draws
+	void GetOverlayInputs(OverlayInputs& inputs);
+
 	// Start line marks
 	wxString starboardMarkGuid;
 	wxString portMarkGuid;
@@ -345,6 +603,8 @@ private:
 	double starboardMarkLongitude;
 	double portMarkLatitude;
 	double portMarkLongitude;
+	double starboardMarkRadius;
+	double portMarkRadius;
 };
 
 #endif 
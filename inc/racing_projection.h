@@ -0,0 +1,123 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_PROJECTION_H
+#define RACING_PROJECTION_H
+
+// Pre compiled headers
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include "ocpn_plugin.h"
+
+// STL
+#include <array>
+#include <vector>
+
+// The parameters of a viewport that affect the projection of positions to the screen
+struct ViewportKey {
+	double latitude;
+	double longitude;
+	double scale;
+	double rotation;
+	double skew;
+	int width;
+	int height;
+	int projection;
+};
+
+// Positions stored as separate arrays, with the Mercator ordinate precalculated when each
+// position is added, so that projecting them to the screen is a branch free loop of multiplies
+// and adds the compiler can vectorise. Used for bulk geometry such as tracks.
+class GeoPointArray {
+public:
+	void Clear(void);
+	void Reserve(size_t count);
+	void Add(double latitude, double longitude);
+	// Discard the oldest positions
+	void Erase(size_t count);
+	size_t Size(void) const { return latitudes.size(); }
+
+	std::vector<double> latitudes;
+	std::vector<double> longitudes;
+	std::vector<double> mercatorY;
+};
+
+// Caches the projection of positions to screen co-ordinates for one canvas.
+// Individual positions are projected by OpenCPN and the results reused until the viewport changes.
+// For a Mercator chart the projection from longitude & Mercator ordinate to the screen is affine,
+// so it is calibrated once per viewport and bulk geometry is projected locally.
+class ProjectionCache {
+public:
+	ProjectionCache();
+
+	// Call at the start of each frame. Returns true if the viewport has changed
+	bool Update(PlugIn_ViewPort* vp);
+
+	// Incremented whenever the viewport changes
+	unsigned int GetRevision(void) const { return revision; }
+
+	// Screen co-ordinates of a single position
+	wxPoint GetPixel(double latitude, double longitude);
+
+	// Screen co-ordinates of many positions, x & y are resized to match
+	void ProjectPoints(const GeoPointArray& points, std::vector<float>& x, std::vector<float>& y);
+
+	// Whether bulk geometry is projected locally rather than by OpenCPN
+	bool IsAffine(void) const { return isAffine; }
+
+	// Mercator ordinate, unitless, of a latitude in degrees
+	static double MercatorY(double latitude);
+
+	static ViewportKey GetViewportKey(PlugIn_ViewPort* vp);
+	static bool IsSameViewport(const ViewportKey& key1, const ViewportKey& key2);
+
+private:
+	PlugIn_ViewPort viewport;
+	ViewportKey key;
+	bool isValid;
+	unsigned int revision;
+
+	// Screen = origin + (longitude - centre longitude) * lonAxis + (mercatorY - centre mercatorY) * mercatorAxis
+	bool isAffine;
+	double originX;
+	double originY;
+	double lonAxisX;
+	double lonAxisY;
+	double mercatorAxisX;
+	double mercatorAxisY;
+	double centreMercatorY;
+
+	// Small cache of individually projected positions, cleared when the viewport changes
+	static const int CACHE_SIZE = 16;
+	struct CachedPixel {
+		double latitude;
+		double longitude;
+		wxPoint pixel;
+	};
+	std::array<CachedPixel, CACHE_SIZE> pixels;
+	int pixelCount;
+	int pixelNext;
+
+	// Calibrate the affine projection from three positions projected by OpenCPN
+	void Calibrate(void);
+};
+
+#endif
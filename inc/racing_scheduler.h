@@ -0,0 +1,95 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SCHEDULER_H
+#define RACING_SCHEDULER_H
+
+// STL
+#include <string>
+#include <vector>
+
+// Counters for each output
+struct OutputStatistics {
+	// Messages transmitted
+	unsigned long long sent;
+	// Messages suppressed as their inputs were stale
+	unsigned long long stale;
+	// Messages not transmitted as the driver failed, or that were skipped as the scheduler fell behind
+	unsigned long long dropped;
+};
+
+// Schedules the messages we generate, each NMEA 0183 sentence or NMEA 2000 PGN being an output
+// with its own interval and priority. Outputs are identified by the order in which they are added.
+// Each output is given a phase within its interval, so outputs with the same interval are spread
+// across the period rather than all falling due on the same tick, and at most a few outputs are
+// sent on any one tick, the highest priority first, with the remainder deferred to the next tick.
+// Outputs keep to their own timeline, so a deferred output does not drift, and if an output falls
+// more than an interval behind the missed messages are counted as dropped rather than sent in a burst.
+class OutputScheduler {
+public:
+	OutputScheduler();
+
+	// Add an output, returning its identifier. Interval and maximum age of its inputs in milliseconds,
+	// a higher priority is sent first
+	int Add(const std::string& name, int interval, int priority, int maximumAge);
+
+	void SetInterval(int output, int interval);
+	void SetPriority(int output, int priority);
+	void SetEnabled(int output, bool enabled);
+	int GetInterval(int output) const;
+	int GetPriority(int output) const;
+
+	// Maximum number of outputs sent on a single tick
+	void SetTickBudget(int budget);
+
+	// Call on every tick. Returns the outputs due to be sent, highest priority first.
+	// The result is reused by the next call
+	const std::vector<int>& GetDue(long long now);
+
+	// Whether the inputs of an output, last updated at inputTime, are recent enough to send.
+	// If not the output is counted as stale
+	bool IsFresh(int output, long long inputTime, long long now);
+
+	// Record the result of sending an output returned by GetDue
+	void CountSent(int output);
+	void CountDropped(int output);
+
+	int GetCount(void) const { return static_cast<int>(outputs.size()); }
+	const std::string& GetName(int output) const;
+	const OutputStatistics& GetStatistics(int output) const;
+
+private:
+	struct Output {
+		std::string name;
+		int interval;
+		int priority;
+		int maximumAge;
+		bool enabled;
+		// Offset of the output within its interval, as a fraction of the interval
+		double phase;
+		// When the output is next due, zero until the scheduler first runs
+		long long nextDue;
+		OutputStatistics statistics;
+	};
+	std::vector<Output> outputs;
+	std::vector<int> due;
+	int tickBudget;
+
+	static int LimitInterval(int interval);
+};
+
+#endif
@@ -0,0 +1,94 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SENTENCE_H
+#define RACING_SENTENCE_H
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Size of the buffer passed to FormatFixedPoint
+const size_t FIXED_POINT_SIZE = 24;
+
+// Format a number as fixed point with up to six decimals, independently of the locale, so the
+// decimal separator is always a point. Returns the number of characters written, not null
+// terminated, or zero if the value is NaN or too large to represent
+size_t FormatFixedPoint(double value, int decimals, char* buffer);
+
+// Builds an NMEA 0183 sentence in a fixed buffer, without allocating memory.
+// Numbers are formatted as fixed point integers rather than with printf, and the checksum
+// is accumulated as each character is written, so completing a sentence is only a matter
+// of appending the checksum and CR LF.
+// eg. Begin("II", "MWV"); AddField(45.0, 2); AddField('T'); ... End();
+class SentenceBuilder {
+public:
+	SentenceBuilder();
+
+	// Start a sentence, eg. talker "II" and formatter "MWV", discarding any previous sentence
+	void Begin(const char* talker, const char* formatter);
+
+	// Each field is preceded by a comma. Numbers that are NaN are written as an empty field,
+	// the NMEA 0183 convention for data that is not available
+	void AddField(double value, int decimals);
+	void AddField(int value);
+	void AddField(char value);
+	void AddField(const char* value);
+	void AddEmptyField(void);
+
+	// Append the checksum and CR LF. Returns false if the sentence exceeded the maximum length
+	bool End(void);
+
+	// The sentence, only valid after End has returned true. Not null terminated
+	const char* GetData(void) const { return buffer.data(); }
+	size_t GetLength(void) const { return length; }
+
+	// Maximum length of a sentence, including the leading $ and trailing CR LF
+	static const size_t MAXIMUM_LENGTH = 82;
+
+private:
+	std::array<char, MAXIMUM_LENGTH> buffer;
+	size_t length;
+	unsigned char checksum;
+	bool isOverflow;
+
+	// Append a character and include it in the checksum
+	void Append(char character);
+	void AppendText(const char* text);
+	// Append the digits of a non negative integer
+	void AppendDigits(unsigned long long value, int minimumDigits);
+};
+
+// Payloads passed to the OpenCPN comms drivers, which take a shared pointer to a vector.
+// A payload is reused once nothing but the pool refers to it, so in the steady state sending a
+// message copies it into an existing vector rather than allocating a new one.
+class PayloadPool {
+public:
+	// A payload holding a copy of the data
+	std::shared_ptr<std::vector<uint8_t>> Get(const uint8_t* data, size_t length);
+	std::shared_ptr<std::vector<uint8_t>> Get(const char* data, size_t length);
+
+private:
+	// A driver may hold on to a payload briefly, a few spares avoid allocating when it does
+	static const int POOL_SIZE = 4;
+	std::array<std::shared_ptr<std::vector<uint8_t>>, POOL_SIZE> payloads;
+};
+
+#endif
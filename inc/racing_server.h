@@ -0,0 +1,94 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SERVER_H
+#define RACING_SERVER_H
+
+// STL
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The platform's socket type, without including the platform's socket headers
+#if defined (_WIN32)
+typedef uintptr_t SocketHandle;
+#else
+typedef int SocketHandle;
+#endif
+
+// Serves the sentences we generate to crew tablets and other devices on the local network,
+// independently of OpenCPN's connections. Sentences are broadcast over UDP and sent to any
+// number of TCP clients.
+// The sentences generated during a tick are appended to a single block, which the server thread
+// sends as is to every client, so there is no formatting or copying per client. All sockets are
+// non blocking and serviced by a single thread waiting in poll, woken when a block is flushed.
+// A client that stops reading is disconnected once too many blocks are waiting for it.
+class NmeaServer {
+public:
+	NmeaServer();
+	~NmeaServer();
+
+	// Listen for TCP clients on a port, and broadcast over UDP to an address & port.
+	// A port of zero disables TCP or UDP. Returns false if the sockets could not be opened
+	bool Start(int tcpPort, const std::string& udpAddress, int udpPort);
+	void Stop(void);
+	bool IsRunning(void) const { return isRunning; }
+
+	// Append a complete sentence, on the main thread, to be sent on the next Flush
+	void Append(const char* data, size_t length);
+	// Pass the sentences appended since the last flush to the server thread
+	void Flush(void);
+
+	int GetClientCount(void) const { return clientCount; }
+	// Clients disconnected as they were not reading
+	unsigned long long GetDroppedClients(void) const { return droppedClients; }
+
+private:
+	// Sentences for the current tick, only used by the main thread
+	std::string pending;
+
+	// Blocks flushed but not yet collected by the server thread
+	std::mutex lock;
+	std::vector<std::shared_ptr<const std::string>> flushed;
+
+	SocketHandle listener;
+	SocketHandle broadcaster;
+	// Loopback socket, a datagram to which wakes the server thread
+	SocketHandle waker;
+	// Network byte order
+	uint32_t broadcastAddress;
+	uint16_t broadcastPort;
+	uint16_t wakePort;
+
+	std::thread thread;
+	std::atomic<bool> isRunning;
+	std::atomic<bool> isStopping;
+	std::atomic<int> clientCount;
+	std::atomic<unsigned long long> droppedClients;
+
+	bool OpenSockets(int tcpPort, const std::string& udpAddress, int udpPort);
+	void Run(void);
+	void Wake(void);
+	void Broadcast(const std::string& block);
+	void CloseSockets(void);
+};
+
+#endif
@@ -0,0 +1,142 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SHARED_H
+#define RACING_SHARED_H
+
+// Layout of the shared memory segment, which external tools may include as is
+
+// STL
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Identifies the segment, and the version of its layout, incremented whenever the layout changes
+const uint32_t SHARED_MAGIC = 0x52414345; // "RACE"
+const uint32_t SHARED_VERSION = 1;
+
+// Number of recent samples kept, one minute at the default interval of 100 milliseconds
+const uint32_t SHARED_RING_SIZE = 600;
+
+// Default name of the segment, /opencpn-racing on Linux & macOS, Local\opencpn-racing on Windows
+const char SHARED_DEFAULT_NAME[] = "opencpn-racing";
+
+// The plugin's fused state at one instant. Speeds in knots, angles in degrees, distances in metres,
+// times in seconds. Values that are unknown, or whose inputs are stale, are NaN
+struct SharedSample {
+	// GPS time if known, otherwise the computer's clock, in milliseconds since 1/1/1970 UTC
+	int64_t utcMilliseconds;
+	double latitude;
+	double longitude;
+	double courseOverGround;
+	double speedOverGround;
+	double headingTrue;
+	double headingMagnetic;
+	double boatSpeed;
+	double waterDepth;
+	double apparentWindAngle;
+	double apparentWindSpeed;
+	double trueWindAngle;
+	double trueWindSpeed;
+	double trueWindDirection;
+	double velocityMadeGood;
+	double targetSpeed;
+	double polarPercentage;
+	double setTrue;
+	double drift;
+	double secondsToGun;
+	double lineDistance;
+	double timeToLine;
+	double timeToBurn;
+	double probabilityOver;
+	double lineBias;
+};
+
+// The segment. The writer increments sequence to an odd number before changing anything and to
+// the next even number once done, so a reader that sees the same even sequence before and after
+// copying what it needs has a consistent copy, without locks or system calls.
+// The latest sample is in current, and also in ring[(sampleCount - 1) % ringSize], with the
+// samples before it in the preceding ring entries.
+//
+// A reader, eg. on Linux & macOS, see tools/shared_reader.h for a complete one:
+//
+//   int fd = shm_open("/opencpn-racing", O_RDONLY, 0);
+//   const SharedHeader* shared = static_cast<const SharedHeader*>(
+//       mmap(nullptr, sizeof(SharedHeader), PROT_READ, MAP_SHARED, fd, 0));
+//   close(fd);
+//
+//   // The magic & version do not change once the plugin has opened the segment. Until they match,
+//   // nothing else in the segment may be used
+//   if ((shared->magic != SHARED_MAGIC) || (shared->version != SHARED_VERSION)) {
+//       // Not written by this version of the plugin, so map it again later
+//   }
+//
+//   SharedSample sample;
+//   uint32_t before, after, isActive;
+//   do {
+//       before = shared->sequence.load(std::memory_order_acquire);
+//       std::memcpy(&sample, &shared->current, sizeof(sample));
+//       isActive = shared->isActive;
+//       std::atomic_thread_fence(std::memory_order_acquire);
+//       after = shared->sequence.load(std::memory_order_relaxed);
+//   } while ((before & 1) || (before != after));
+//
+//   if (!isActive) {
+//       // The plugin has closed it, so map it again later
+//   }
+//
+// On Windows, OpenFileMappingA(FILE_MAP_READ, FALSE, "Local\\opencpn-racing") and MapViewOfFile.
+struct SharedHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t sampleSize;
+	uint32_t ringSize;
+	std::atomic<uint32_t> sequence;
+	// Cleared when the plugin closes the segment
+	uint32_t isActive;
+	// Samples written since the segment was opened
+	uint64_t sampleCount;
+	SharedSample current;
+	SharedSample ring[SHARED_RING_SIZE];
+};
+
+// Writes the fused state to a shared memory segment, for analysis tools on the same computer
+class SharedMemoryExport {
+public:
+	SharedMemoryExport();
+	~SharedMemoryExport();
+
+	// Create the segment, or reuse one left by a previous run. Returns false if it could not be mapped
+	bool Open(const std::string& name);
+	void Close(void);
+	bool IsOpen(void) const { return shared != nullptr; }
+
+	// Write a sample as the current one, and append it to the ring
+	void Write(const SharedSample& sample);
+
+private:
+	SharedHeader* shared;
+	std::string segmentName;
+#if defined (_WIN32)
+	void* mapping;
+#endif
+
+	void BeginWrite(void);
+	void EndWrite(void);
+};
+
+#endif
@@ -0,0 +1,71 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SIGNALK_H
+#define RACING_SIGNALK_H
+
+// For FIXED_POINT_SIZE
+#include "racing_sentence.h"
+
+// STL
+#include <array>
+#include <string>
+#include <vector>
+
+// Writes SignalK delta messages for the values we calculate, eg.
+// {"context":"vessels.self","updates":[{"$source":"racing-plugin","timestamp":"2026-10-18T10:15:30.250Z",
+// "values":[{"path":"environment.wind.speedTrue","value":6.17}]}]}
+// Paths are added once, then their values set as they are calculated. A delta includes only the
+// values whose formatted text has changed since they were last sent, or that have not been sent
+// for a while so that new subscribers soon see every value, batched into a single update.
+// The delta is written into a buffer reserved when the paths are added, so writing it does not allocate.
+class SignalKDeltaWriter {
+public:
+	SignalKDeltaWriter();
+
+	// Add a path with the number of decimals its value is sent with, returning its identifier
+	int Add(const char* path, int decimals);
+
+	// Set the value of a path, in SignalK's SI units. NaN is sent as null, data not available
+	void Set(int path, double value);
+
+	// Write a delta with the values to be sent, at a time in milliseconds since 1/1/1970 UTC.
+	// Returns false if there is nothing to send
+	bool Write(long long utcMilliseconds);
+
+	// The delta, only valid after Write has returned true
+	const std::string& GetDelta(void) const { return delta; }
+
+private:
+	struct Path {
+		std::string name;
+		int decimals;
+		double value;
+		// Text of the value last sent, an empty text is null
+		std::array<char, FIXED_POINT_SIZE> sent;
+		size_t sentLength;
+		bool isSent;
+		long long sentTime;
+	};
+	std::vector<Path> paths;
+	std::string delta;
+
+	void AppendTimestamp(long long utcMilliseconds);
+	void AppendDigits(int value, int digits);
+};
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_SOCKET_H
+#define RACING_SOCKET_H
+
+// Platform socket definitions shared by the servers. Only included by their implementations,
+// as the platform headers must not be mixed with those included by wxWidgets
+
+#include "racing_server.h"
+
+#if defined (_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef WSAPOLLFD PollDescriptor;
+#define PollSockets WSAPoll
+#define CloseSocket closesocket
+#define IsWouldBlock() (WSAGetLastError() == WSAEWOULDBLOCK)
+typedef int SocketLength;
+const SocketHandle NO_SOCKET = INVALID_SOCKET;
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef struct pollfd PollDescriptor;
+#define PollSockets poll
+#define CloseSocket close
+#define IsWouldBlock() ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+typedef socklen_t SocketLength;
+const SocketHandle NO_SOCKET = -1;
+#endif
+
+// STL
+#include <cstring>
+
+// Writing to a closed connection must not raise SIGPIPE and terminate OpenCPN
+#if defined (MSG_NOSIGNAL)
+const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+// Winsock must be initialised by each user, the calls are reference counted
+inline bool StartSockets(void) {
+#if defined (_WIN32)
+	WSADATA data;
+	return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+	return true;
+#endif
+}
+
+inline void FinishSockets(void) {
+#if defined (_WIN32)
+	WSACleanup();
+#endif
+}
+
+// Set a socket to non blocking
+inline bool SetNonBlocking(SocketHandle socketHandle) {
+#if defined (_WIN32)
+	u_long mode = 1;
+	return ioctlsocket(socketHandle, FIONBIO, &mode) == 0;
+#else
+	int flags = fcntl(socketHandle, F_GETFL, 0);
+	return (flags != -1) && (fcntl(socketHandle, F_SETFL, flags | O_NONBLOCK) == 0);
+#endif
+}
+
+// Enable a boolean socket option
+inline bool EnableOption(SocketHandle socketHandle, int level, int option) {
+	int enable = 1;
+	return setsockopt(socketHandle, level, option, reinterpret_cast<const char*>(&enable), sizeof(enable)) == 0;
+}
+
+// Options for an accepted TCP connection
+inline void SetClientOptions(SocketHandle socketHandle) {
+	SetNonBlocking(socketHandle);
+	EnableOption(socketHandle, IPPROTO_TCP, TCP_NODELAY);
+#if defined (SO_NOSIGPIPE)
+	EnableOption(socketHandle, SOL_SOCKET, SO_NOSIGPIPE);
+#endif
+}
+
+// Listen for TCP connections on a port, on every interface
+inline SocketHandle OpenListener(int port) {
+	SocketHandle listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener == NO_SOCKET) {
+		return NO_SOCKET;
+	}
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	if ((!EnableOption(listener, SOL_SOCKET, SO_REUSEADDR)) ||
+		(bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) ||
+		(listen(listener, SOMAXCONN) != 0) || (!SetNonBlocking(listener))) {
+		CloseSocket(listener);
+		return NO_SOCKET;
+	}
+	return listener;
+}
+
+// A loopback datagram socket bound to any free port. A datagram sent to it by WakeSocket
+// wakes a server thread waiting in poll. Returns the port in network byte order
+inline SocketHandle OpenWakeSocket(uint16_t& port) {
+	SocketHandle waker = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (waker == NO_SOCKET) {
+		return NO_SOCKET;
+	}
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = 0;
+	SocketLength length = sizeof(address);
+	if ((bind(waker, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) ||
+		(getsockname(waker, reinterpret_cast<sockaddr*>(&address), &length) != 0) || (!SetNonBlocking(waker))) {
+		CloseSocket(waker);
+		return NO_SOCKET;
+	}
+	port = address.sin_port;
+	return waker;
+}
+
+inline void WakeSocket(SocketHandle waker, uint16_t port) {
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = port;
+	const char signal = 0;
+	sendto(waker, &signal, 1, 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+}
+
+// Discard the datagrams that woke the thread
+inline void ClearWakeSocket(SocketHandle waker) {
+	char discard[64];
+	while (recv(waker, discard, sizeof(discard), 0) > 0) {
+	}
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_TARGETS_H
+#define RACING_TARGETS_H
+
+// STL
+#include <array>
+
+// Target boat speeds learned from our own performance, in the absence of a polar.
+// The targets are held in a table of true wind speed & true wind angle bins. Each bin tracks
+// the upper envelope of the boat speeds observed in it, rising quickly towards faster samples
+// and decaying slowly towards slower ones, so a single surf does not set an unreachable target.
+// Speeds in knots, angles in degrees.
+class PerformanceTargets {
+public:
+	PerformanceTargets();
+
+	void Clear(void);
+
+	// Learn from a sample. Returns the boat speed as a fraction of the target, NaN if there is no target yet
+	double Update(double trueWindSpeed, double trueWindAngle, double boatSpeed);
+
+	// Target boat speed, NaN if insufficient samples have been observed for this wind
+	double GetTargetSpeed(double trueWindSpeed, double trueWindAngle) const;
+
+private:
+	// 2 knot bins to 40 knots, 10 degree bins from 0 to 180 degrees
+	static const int SPEED_BINS = 20;
+	static const int ANGLE_BINS = 18;
+
+	struct Target {
+		double speed;
+		int samples;
+	};
+	std::array<Target, SPEED_BINS * ANGLE_BINS> targets;
+
+	// Index of the bin for a wind, -1 if out of range
+	static int GetSpeedBin(double trueWindSpeed);
+	static int GetAngleBin(double trueWindAngle);
+};
+
+#endif
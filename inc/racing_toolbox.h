@@ -34,9 +34,14 @@
 extern bool showStartline;
 extern bool showLayLines;
 extern bool showWindAngles;
+extern bool showPerformanceTrack;
 extern bool showMultiCanvas;
 extern int tackingAngle;
 extern int defaultTimerValue;
+extern int pingDuration;
+extern double antennaForeAft;
+extern double antennaAthwartships;
+extern int gaugeFrameRate;
 
 class RacingToolbox : public RacingToolboxBase {
 	
@@ -47,10 +52,15 @@ public:
 protected:
 	// Overridden methods from the base class
 	void OnCountdownTimerChanged(wxSpinEvent& event);
+	void OnPingDurationChanged(wxSpinEvent& event);
+	void OnAntennaForeAftChanged(wxSpinDoubleEvent& event);
+	void OnAntennaAthwartshipsChanged(wxSpinDoubleEvent& event);
+	void OnFrameRateChanged(wxSpinEvent& event);
 	void OnTackingAngleChanged(wxSpinEvent& event);
 	void OnWindAngleChanged(wxCommandEvent& event);
 	void OnStartLineChanged(wxCommandEvent& event);
 	void OnLayLinesChanged(wxCommandEvent& event);
+	void OnPerformanceTrackChanged(wxCommandEvent& event);
 	void OnCanvasChanged(wxCommandEvent& event);
 private:
 	bool settingsDirty;
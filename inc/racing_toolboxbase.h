@@ -32,19 +32,33 @@ class RacingToolboxBase : public wxPanel
 	protected:
 		wxStaticText* labelCountdownTimer;
 		wxSpinCtrl* spinCountdownTimer;
+		wxStaticText* labelPingDuration;
+		wxSpinCtrl* spinPingDuration;
+		wxStaticText* labelAntennaForeAft;
+		wxSpinCtrlDouble* spinAntennaForeAft;
+		wxStaticText* labelAntennaAthwartships;
+		wxSpinCtrlDouble* spinAntennaAthwartships;
+		wxStaticText* labelFrameRate;
+		wxSpinCtrl* spinFrameRate;
 		wxStaticText* labelTackingAngle;
 		wxSpinCtrl* spinTackingAngle;
 		wxCheckBox* chkWindAngle;
 		wxCheckBox* chkStartLine;
 		wxCheckBox* chkLayLines;
+		wxCheckBox* chkPerformanceTrack;
 		wxCheckBox* chkMultiCanvas;
 
 		// Virtual event handlers, override them in your derived class
 		virtual void OnCountdownTimerChanged( wxSpinEvent& event ) { event.Skip(); }
+		virtual void OnPingDurationChanged( wxSpinEvent& event ) { event.Skip(); }
+		virtual void OnAntennaForeAftChanged( wxSpinDoubleEvent& event ) { event.Skip(); }
+		virtual void OnAntennaAthwartshipsChanged( wxSpinDoubleEvent& event ) { event.Skip(); }
+		virtual void OnFrameRateChanged( wxSpinEvent& event ) { event.Skip(); }
 		virtual void OnTackingAngleChanged( wxSpinEvent& event ) { event.Skip(); }
 		virtual void OnWindAngleChanged( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnStartLineChanged( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnLayLinesChanged( wxCommandEvent& event ) { event.Skip(); }
+		virtual void OnPerformanceTrackChanged( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnCanvasChanged(wxCommandEvent& event) { event.Skip(); }
 
 	public:
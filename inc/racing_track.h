@@ -0,0 +1,80 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_TRACK_H
+#define RACING_TRACK_H
+
+// GeoPointArray
+#include "racing_projection.h"
+
+// STL
+#include <vector>
+
+// Our recent track, with the performance (fraction of target boat speed) at each sample.
+// Samples are kept at full rate, and completed chunks of samples are simplified with Douglas-Peucker
+// at a series of tolerances, each double the previous, forming a level of detail pyramid.
+// When drawn, the level whose tolerance is just below one pixel is chosen, so that a few thousand
+// vertices are drawn at any chart scale regardless of the duration of the track.
+class TrackHistory {
+public:
+	TrackHistory();
+
+	void Clear(void);
+
+	// Duration of the track retained (seconds)
+	void SetDuration(int seconds);
+
+	// Add a sample, efficiency is NaN if unknown
+	void Add(long long timeMilliseconds, double latitude, double longitude, double efficiency);
+
+	// Incremented whenever a sample is added or discarded
+	unsigned int GetRevision(void) const { return revision; }
+
+	const GeoPointArray& GetPoints(void) const { return points; }
+	const std::vector<float>& GetEfficiencies(void) const { return efficiencies; }
+
+	// Indices of the samples to draw, in order, at the given chart scale
+	void GetVisibleIndices(double pixelsPerMetre, std::vector<unsigned int>& indices) const;
+
+private:
+	// Chunks are simplified once complete, the incomplete chunk is drawn at full rate
+	static const int CHUNK_SIZE = 256;
+	// Tolerances from 0.5 metres to 1 kilometre
+	static const int LEVEL_COUNT = 12;
+
+	GeoPointArray points;
+	std::vector<long long> times;
+	std::vector<float> efficiencies;
+	long long durationMilliseconds;
+	unsigned int revision;
+
+	// For each level, the indices of the samples retained from each completed chunk, and where each chunk starts
+	std::vector<unsigned int> levels[LEVEL_COUNT];
+	std::vector<size_t> chunkOffsets[LEVEL_COUNT];
+
+	// Simplify the most recently completed chunk at each level
+	void SimplifyChunk(unsigned int first, unsigned int last);
+
+	// Douglas-Peucker, appending the retained indices from the input to the output
+	void Simplify(const std::vector<unsigned int>& input, size_t begin, size_t end, double tolerance,
+		std::vector<unsigned int>& output) const;
+
+	// Discard whole chunks older than the duration
+	void Expire(long long timeMilliseconds);
+};
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RACING_WEBSERVER_H
+#define RACING_WEBSERVER_H
+
+// For the platform's socket type
+#include "racing_server.h"
+
+// STL
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes a flat JSON object into a reused string, with numbers formatted independently of the locale.
+// eg. Begin(); AddField("trueWindSpeed", 12.3, 1); ... End();
+class JsonWriter {
+public:
+	// Start an object, discarding any previous one
+	void Begin(void);
+	// Numbers that are NaN are written as null
+	void AddField(const char* name, double value, int decimals);
+	void AddField(const char* name, bool value);
+	void End(void);
+
+	const std::string& GetText(void) const { return text; }
+
+private:
+	std::string text;
+	void AddName(const char* name);
+};
+
+// Serves a live data page to phones and tablets, eg. the countdown, start line and wind.
+// A browser loads the page over HTTP, which then opens a WebSocket on which the server pushes
+// each snapshot of the data as JSON. The latest snapshot can also be polled from /data.
+// Each snapshot is framed once on the main thread and the same frame is sent to every
+// connection. A connection that has not yet sent the previous snapshot only receives the
+// latest one, so a slow phone falls behind rather than accumulating a backlog.
+// SignalK clients may instead connect to /signalk/v1/stream, found from /signalk, on which every
+// delta we publish is sent. Deltas cannot be skipped, so a client too far behind is disconnected.
+// As with the NMEA 0183 server, all sockets are non blocking and serviced by a single thread.
+class LiveDataServer {
+public:
+	LiveDataServer();
+	~LiveDataServer();
+
+	// Listen for HTTP connections on a port. Returns false if the port could not be opened
+	bool Start(int port);
+	void Stop(void);
+	bool IsRunning(void) const { return isRunning; }
+
+	// Publish a snapshot, a JSON object, to every live data connection
+	void Publish(const std::string& json);
+	// Publish a SignalK delta to every SignalK connection
+	void PublishDelta(const std::string& json);
+
+	// Number of open WebSocket connections
+	int GetClientCount(void) const { return clientCount; }
+	// Connections closed as they had stopped reading
+	unsigned long long GetDroppedClients(void) const { return droppedClients; }
+
+private:
+	// The latest snapshot as a WebSocket frame, with the length of the frame header.
+	// Replaced by the main thread, the revision identifies which snapshot a connection has sent
+	std::mutex lock;
+	std::shared_ptr<const std::string> snapshot;
+	size_t snapshotHeaderLength;
+	unsigned long long snapshotRevision;
+	// SignalK deltas framed but not yet collected by the server thread
+	std::vector<std::shared_ptr<const std::string>> deltas;
+
+	// HTTP response with the page, built once
+	std::shared_ptr<const std::string> page;
+
+	SocketHandle listener;
+	SocketHandle waker;
+	uint16_t wakePort;
+
+	std::thread thread;
+	std::atomic<bool> isRunning;
+	std::atomic<bool> isStopping;
+	std::atomic<int> clientCount;
+	std::atomic<unsigned long long> droppedClients;
+
+	struct Connection;
+	void Run(void);
+	void Wake(void);
+	void CloseSockets(void);
+	// Read the HTTP request, or the frames received on a WebSocket
+	bool Receive(Connection& connection);
+	bool HandleRequest(Connection& connection);
+	bool HandleFrames(Connection& connection);
+	bool Send(Connection& connection);
+};
+
+#endif
@@ -26,11 +26,23 @@
 // For the Stopwatch/Countdown timer
 #include <wx/timer.h>
 
+#include <wx/log.h>
+#include <wx/msgdlg.h>
+
 #include <algorithm>
 
 // For OpenCPN User's display units
 #include <ocpn_plugin.h>
 
+// GPS synchronised clock for the start gun
+#include "racing_clock.h"
+
+// Over early (OCS) prediction
+#include "racing_ocs.h"
+
+// Bearing between the ends of the start line
+#include "racing_bias.h"
+
 // image for dialog icon
 extern wxBitmap pluginBitmap;
 
@@ -46,9 +58,19 @@ extern double currentLongitude;
 extern double courseOverGround;
 extern double speedOverGround;
 
+// Position of the bow, used for all start line calculations
+extern double bowLatitude;
+extern double bowLongitude;
+
+// Distance & time to the start line, calculated by the plugin for every position update
+extern OcsPrediction ocsPrediction;
+
 // Countdown Timer Value
 extern int defaultTimerValue;
 
+// GPS time, used to schedule the start gun at an absolute UTC time
+extern GpsClock gpsClock;
+
 class RacingWindow : public RacingWindowBase {
 	
 public:
@@ -65,6 +87,13 @@ public:
 	// Cleanup
 	void Close();
 
+	// Position of the start line marks, averaged by the plugin over the ping duration
+	void SetPortMark(double latitude, double longitude, double confidenceRadius);
+	void SetStarboardMark(double latitude, double longitude, double confidenceRadius);
+
+	// Seconds until the gun, NaN if the countdown is not running
+	double GetSecondsToGun(void);
+
 	
 protected:
 	//overridden methods from the base class
@@ -74,12 +103,21 @@ protected:
 	void OnPort(wxCommandEvent &event);
 	void OnStarboard(wxCommandEvent &event);
 	void OnCancel(wxCommandEvent &event);
+	void OnGunTime(wxCommandEvent &event);
 		
 private:
 	void Initialize(void);
 	void ResetTimer(void);
 	// Countdown timer
 	int totalSeconds;
+	// Whether the countdown is driven by GPS time towards a scheduled gun
+	bool isGunScheduled;
+	// Time of the start gun, milliseconds since 1/1/1970 UTC
+	long long gunTime;
+	// Local (steady clock) time at which the manual countdown was started
+	long long startTime;
+	// Re-arm the timer to fire as the next whole second of GPS time elapses
+	void ScheduleNextTick(long long remainingMilliseconds);
 	// Port and Starboard ends of the start line
 	double starboardLatitude;
 	double starboardLongitude;
@@ -95,7 +133,6 @@ private:
 	double intersectLongitude;
 	// Navigation Formula functions
 	bool CalculateIntersection(double latitude1, double longitude1, double  bearing1, double latitude2, double longitude2, double bearing2, double *lat3, double *lon3);
-	double BearingBetweenPoints(double latitude1, double longitude1, double latitude2, double longitude2);
 	double HaversineFormula(double latutude1, double longitude1, double latitude2, double longitude2);
 	double SphericalCosines(double latitude1, double longitude1, double latitude2, double longitude2);
 	double Bearing(double latitude1, double longitude1, double latitude2, double longitude2);
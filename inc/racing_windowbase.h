@@ -19,6 +19,7 @@
 #include <wx/image.h>
 #include <wx/icon.h>
 #include <wx/button.h>
+#include <wx/textctrl.h>
 #include <wx/sizer.h>
 #include <wx/frame.h>
 
@@ -37,11 +38,15 @@ class RacingWindowBase : public wxFrame
 		wxStaticText* labelTimer;
 		wxStaticText* labelTTG;
 		wxStaticText* labelDistance;
+		wxStaticText* labelBurn;
+		wxStaticText* labelOCS;
 		wxButton* buttonTimer;
 		wxButton* buttonreset;
 		wxButton* buttonPort;
 		wxButton* buttonStarboard;
 		wxButton* buttonCancel;
+		wxTextCtrl* textGunTime;
+		wxButton* buttonGunTime;
 
 		// Virtual event handlers, overide them in your derived class
 		virtual void OnClose( wxCloseEvent& event ) { event.Skip(); }
@@ -50,6 +55,7 @@ class RacingWindowBase : public wxFrame
 		virtual void OnPort( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnStarboard( wxCommandEvent& event ) { event.Skip(); }
 		virtual void OnCancel( wxCommandEvent& event ) { event.Skip(); }
+		virtual void OnGunTime( wxCommandEvent& event ) { event.Skip(); }
 
 
 	public:
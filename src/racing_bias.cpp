@@ -0,0 +1,215 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Start line bias and favoured end
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_bias.h"
+
+#include <limits>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Metres per degree of latitude, 1' = 1NM
+const double METRES_PER_DEGREE = 1852.0 * 60.0;
+
+// Default duration of the rolling mean (seconds)
+const int DEFAULT_WINDOW = 120;
+
+// Default change in mean wind direction (degrees) before the bias is recalculated
+const double DEFAULT_THRESHOLD = 2.0;
+
+// Below this gain (metres) the line is considered square
+const double SQUARE_LINE_TOLERANCE = 1.0;
+
+StartLineBias::StartLineBias() {
+	historyCount = 0;
+	historyNext = 0;
+	sumSine = 0.0;
+	sumCosine = 0.0;
+	samplesSinceResync = 0;
+	windowMilliseconds = DEFAULT_WINDOW * 1000LL;
+	threshold = DEFAULT_THRESHOLD;
+	hasStartLine = false;
+	starboardLatitude = 0.0;
+	starboardLongitude = 0.0;
+	portLatitude = 0.0;
+	portLongitude = 0.0;
+	revision = 0;
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	bias.isValid = false;
+	bias.windDirection = nan;
+	bias.lineBearing = nan;
+	bias.lineLength = nan;
+	bias.biasAngle = nan;
+	bias.favouredEnd = FAVOURED_NONE;
+	bias.metresGained = nan;
+}
+
+void StartLineBias::SetStartLine(double starboardLat, double starboardLon, double portLat, double portLon) {
+	starboardLatitude = starboardLat;
+	starboardLongitude = starboardLon;
+	portLatitude = portLat;
+	portLongitude = portLon;
+	hasStartLine = true;
+
+	// A new line always republishes, even if the wind is unchanged
+	if (historyCount >= MINIMUM_SAMPLES) {
+		Publish(atan2(sumSine, sumCosine) * 180.0 / M_PI);
+	}
+}
+
+void StartLineBias::ClearStartLine(void) {
+	hasStartLine = false;
+	bias.isValid = false;
+	bias.favouredEnd = FAVOURED_NONE;
+	revision++;
+}
+
+void StartLineBias::SetWindow(int seconds) {
+	windowMilliseconds = (seconds > 0 ? seconds : DEFAULT_WINDOW) * 1000LL;
+}
+
+void StartLineBias::SetThreshold(double degrees) {
+	threshold = fabs(degrees);
+}
+
+bool StartLineBias::AddWindSample(long long timeMilliseconds, double trueWindDirection) {
+
+	if (std::isnan(trueWindDirection)) {
+		return false;
+	}
+
+	ExpireSamples(timeMilliseconds);
+
+	// If the buffer is full, the oldest sample is overwritten
+	if (historyCount == HISTORY_SIZE) {
+		const WindSample& oldest = history[historyNext];
+		sumSine -= oldest.sine;
+		sumCosine -= oldest.cosine;
+		historyCount--;
+	}
+
+	WindSample& sample = history[historyNext];
+	sample.time = timeMilliseconds;
+	sample.sine = sin(trueWindDirection * M_PI / 180.0);
+	sample.cosine = cos(trueWindDirection * M_PI / 180.0);
+	sumSine += sample.sine;
+	sumCosine += sample.cosine;
+	historyNext = (historyNext + 1) % HISTORY_SIZE;
+	historyCount++;
+
+	// Adding & subtracting accumulates rounding errors, so occasionally recalculate the sums
+	samplesSinceResync++;
+	if (samplesSinceResync >= HISTORY_SIZE) {
+		sumSine = 0.0;
+		sumCosine = 0.0;
+		for (int i = 0; i < historyCount; i++) {
+			const WindSample& s = history[(historyNext + HISTORY_SIZE - historyCount + i) % HISTORY_SIZE];
+			sumSine += s.sine;
+			sumCosine += s.cosine;
+		}
+		samplesSinceResync = 0;
+	}
+
+	if ((!hasStartLine) || (historyCount < MINIMUM_SAMPLES)) {
+		return false;
+	}
+
+	double windDirection = atan2(sumSine, sumCosine) * 180.0 / M_PI;
+
+	// Only republish when the wind has shifted sufficiently
+	if ((bias.isValid) && (fabs(AngleDifference(windDirection, bias.windDirection)) < threshold)) {
+		return false;
+	}
+
+	Publish(windDirection);
+	return true;
+}
+
+void StartLineBias::ExpireSamples(long long timeMilliseconds) {
+	while (historyCount > 0) {
+		const WindSample& oldest = history[(historyNext + HISTORY_SIZE - historyCount) % HISTORY_SIZE];
+		if ((timeMilliseconds - oldest.time) <= windowMilliseconds) {
+			break;
+		}
+		sumSine -= oldest.sine;
+		sumCosine -= oldest.cosine;
+		historyCount--;
+	}
+}
+
+void StartLineBias::Publish(double windDirection) {
+
+	windDirection = fmod(windDirection + 360.0, 360.0);
+
+	// Over the length of a start line, a flat earth is accurate enough
+	double north = (portLatitude - starboardLatitude) * METRES_PER_DEGREE;
+	double east = (portLongitude - starboardLongitude) * METRES_PER_DEGREE * cos(starboardLatitude * M_PI / 180.0);
+
+	bias.windDirection = windDirection;
+	bias.lineBearing = BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
+	bias.lineLength = hypot(north, east);
+
+	// Looking upwind the starboard end is on the right, so a square line bears 90 degrees to the left of the wind.
+	// If the line is rotated clockwise from square, the port end is further upwind
+	bias.biasAngle = AngleDifference(bias.lineBearing, windDirection - 90.0);
+	bias.metresGained = bias.lineLength * fabs(sin(bias.biasAngle * M_PI / 180.0));
+
+	if (bias.metresGained < SQUARE_LINE_TOLERANCE) {
+		bias.favouredEnd = FAVOURED_NONE;
+	}
+	else {
+		bias.favouredEnd = bias.biasAngle > 0.0 ? FAVOURED_PORT : FAVOURED_STARBOARD;
+	}
+
+	bias.isValid = true;
+	revision++;
+}
+
+// Refer to http://www.movable-type.co.uk/scripts/latlong.html
+double StartLineBias::BearingBetweenPoints(double latitude1, double longitude1, double latitude2, double longitude2) {
+
+	double theta1 = latitude1 * M_PI / 180.0;
+	double theta2 = latitude2 * M_PI / 180.0;
+	double delta = (longitude2 - longitude1) * M_PI / 180.0;
+
+	double x = (cos(theta1) * sin(theta2)) - (sin(theta1) * cos(theta2) * cos(delta));
+	double y = sin(delta) * cos(theta2);
+	double bearing = atan2(y, x) * 180.0 / M_PI;
+
+	return bearing < 0.0 ? bearing + 360.0 : bearing;
+}
+
+double StartLineBias::AngleDifference(double angle1, double angle2) {
+	double difference = fmod(angle1 - angle2, 360.0);
+	if (difference > 180.0) {
+		difference -= 360.0;
+	}
+	else if (difference <= -180.0) {
+		difference += 360.0;
+	}
+	return difference;
+}
@@ -0,0 +1,130 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: GPS synchronised clock for the start gun
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_clock.h"
+
+#include <algorithm>
+#include <cmath>
+
+GpsClock::GpsClock() {
+	Reset();
+}
+
+void GpsClock::Reset(void) {
+	offsets.fill(0);
+	sampleCount = 0;
+	nextSample = 0;
+	estimatedOffset = 0;
+	pendingOffsets.fill(0);
+	pendingCount = 0;
+}
+
+void GpsClock::AddSample(long long gpsMilliseconds) {
+	AddSample(gpsMilliseconds, GetLocalMilliseconds());
+}
+
+void GpsClock::AddSample(long long gpsMilliseconds, long long localMilliseconds) {
+
+	long long offset = gpsMilliseconds - localMilliseconds;
+
+	// A large step is either a change of time source or a bad time stamp. Keep the current estimate
+	// until enough consecutive samples agree on the new offset, then restart the window from them
+	// rather than slowly slewing towards it.
+	if ((sampleCount > 0) && (std::llabs(offset - estimatedOffset) > STEP_THRESHOLD)) {
+		if (AddPendingStep(offset)) {
+			std::array<long long, MINIMUM_SAMPLES> stepOffsets = pendingOffsets;
+			Reset();
+			for (long long stepOffset : stepOffsets) {
+				offsets[nextSample++] = stepOffset;
+			}
+			sampleCount = MINIMUM_SAMPLES;
+			estimatedOffset = *std::max_element(stepOffsets.begin(), stepOffsets.end());
+		}
+		return;
+	}
+	pendingCount = 0;
+
+	offsets[nextSample] = offset;
+	nextSample = (nextSample + 1) % WINDOW_SIZE;
+	if (sampleCount < WINDOW_SIZE) {
+		sampleCount++;
+	}
+
+	// The least delayed sample has the largest offset
+	long long leastDelayed = *std::max_element(offsets.begin(), offsets.begin() + sampleCount);
+
+	if (sampleCount == 1) {
+		estimatedOffset = leastDelayed;
+	}
+	else {
+		// Simple first order filter to track drift between the local clock and GPS time
+		estimatedOffset += (leastDelayed - estimatedOffset) / 4;
+	}
+}
+
+// Returns true once MINIMUM_SAMPLES consecutive samples agree on a new offset
+bool GpsClock::AddPendingStep(long long offset) {
+	if ((pendingCount > 0) && (std::llabs(offset - pendingOffsets[0]) > STEP_THRESHOLD)) {
+		pendingCount = 0;
+	}
+	pendingOffsets[pendingCount++] = offset;
+	return pendingCount == MINIMUM_SAMPLES;
+}
+
+bool GpsClock::IsSynchronised(void) const {
+	return sampleCount >= MINIMUM_SAMPLES;
+}
+
+long long GpsClock::GetUTCMilliseconds(void) const {
+	return GetLocalMilliseconds() + estimatedOffset;
+}
+
+long long GpsClock::GetJitter(void) const {
+	if (sampleCount == 0) {
+		return 0;
+	}
+	auto range = std::minmax_element(offsets.begin(), offsets.begin() + sampleCount);
+	return *range.second - *range.first;
+}
+
+long long GpsClock::GetLocalMilliseconds(void) {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Days since 1/1/1970 for a date in the proleptic Gregorian calendar
+// Refer to http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+long long GpsClock::ToEpochMilliseconds(int year, int month, int day, double secondsOfDay) {
+
+	year -= month <= 2 ? 1 : 0;
+	long long era = (year >= 0 ? year : year - 399) / 400;
+	long long yearOfEra = year - (era * 400);
+	long long dayOfYear = ((153 * (month + (month > 2 ? -3 : 9))) + 2) / 5 + day - 1;
+	long long dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+	long long days = (era * 146097) + dayOfEra - 719468;
+
+	return (days * 86400000LL) + static_cast<long long>(std::llround(secondsOfDay * 1000.0));
+}
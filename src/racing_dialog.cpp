@@ -97,7 +97,7 @@ void RacingDialog::OnTimer(wxTimerEvent& event) {
 	if ((portMark) && (starboardMark)) {
 		// Calculate the bearing of the actual start line
 		// BUG BUG Should do this only once when we've pinged each end
-		double startLineBearing = BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
+		double startLineBearing = StartLineBias::BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
 	
 		// Determine if our current course crosses the start line
 		if (CalculateIntersection(starboardLatitude, starboardLongitude, startLineBearing, currentLatitude, currentLongitude, courseOverGround, &intersectLatitude, &intersectLongitude)) {
@@ -263,31 +263,6 @@ bool RacingDialog::CalculateIntersection(double latitude1, double longitude1, do
 	
 
 	
-	// BUG BUG UNUSED
-	//bearing
-	//const p1 = new LatLon(52.205, 0.119);
-	//const p2 = new LatLon(48.857, 2.351);
-	//const b1 = p1.initialBearingTo(p2); // 156.2°
-	//
-	double RacingDialog::BearingBetweenPoints(double lat1, double lon1, double lat2, double lon2) {
-
-		// tanθ = sindeltaLon⋅coslat2 / coslat1⋅sinlat2 − sinlat1⋅coslat2⋅cosdeltaLon
-		// see mathforum.org/library/drmath/view/55417.html for derivation
-
-		double theta1 = lat1 * M_PI / 180;
-		double theta2 = lat2 * M_PI / 180;
-		double delta = (lon2 - lon1) * M_PI / 180;;
-
-		double x = cos(theta1) * sin(theta2) - sin(theta1) * cos(theta2) * cos(delta);
-		double y = sin(delta) * cos(theta2);
-		double bearing = atan2(y, x);
-
-		return bearing * 180 / M_PI;;
-
-		// or
-		//return fmod(atan2(sin((lon1 * M_PI / 180 )- (lon2 * M_PI / 180))*cos((lat2 * M_PI / 180)), cos((lat1* M_PI / 180))*sin((lat2* M_PI / 180)) - sin((lat1* M_PI / 180))*cos((lat2* M_PI / 180))*cos((lon1* M_PI / 180) - (lon2* M_PI / 180))), (2 * M_PI));
-	}
-
 // Determine distamce between two points using the Haversine Formula
 // Good reference http://www.movable-type.co.uk/scripts/latlong.html
 double RacingDialog::HaversineFormula(double latutude1, double longitude1, double latitude2, double longitude2) {
@@ -26,8 +26,25 @@
 
 #include "racing_gauge.h"
 
+#include <algorithm>
+#include <climits>
+#include <chrono>
+
+// Fraction of each frame interval that painting may use before the frame rate is reduced
+const double FRAME_BUDGET = 0.25;
+
+// The frame rate is not reduced below this
+const int MINIMUM_FRAME_RATE = 5;
+
+// Minimum size of the gauge in logical pixels
+const int MINIMUM_SIZE = 250;
+
+// Pixel height of the text font relative to the radius of the dial, 11 pixels at the minimum size
+const double FONT_HEIGHT_RATIO = 0.11;
+const int MINIMUM_FONT_HEIGHT = 8;
+
 WindWizard::WindWizard(wxWindow* parent)
-	: wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE) {
+	: wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE), values(renderer.values) {
 
 #if defined (__WXMSW__)
 	this->SetBackgroundStyle(wxBG_STYLE_PAINT); // is/was needed for Microsoft Windows
@@ -39,11 +56,16 @@ WindWizard::WindWizard(wxWindow* parent)
 	Connect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(WindWizard::OnEraseBackground), NULL, this);
 	Connect(wxEVT_SIZE, wxSizeEventHandler(WindWizard::OnSize),NULL,this);
 
-	SetMinSize(wxSize(250, 250));
+	animationTimer.SetOwner(this);
+	Connect(animationTimer.GetId(), wxEVT_TIMER, wxTimerEventHandler(WindWizard::OnAnimationTimer), NULL, this);
+
+	SetMinSize(wxSize(MINIMUM_SIZE, MINIMUM_SIZE));
 
 }
 
 WindWizard::~WindWizard() {
+	animationTimer.Stop();
+	Disconnect(animationTimer.GetId(), wxEVT_TIMER, wxTimerEventHandler(WindWizard::OnAnimationTimer), NULL, this);
 	Disconnect(wxEVT_SIZE, wxSizeEventHandler(WindWizard::OnSize));
 	Disconnect(wxEVT_PAINT, wxPaintEventHandler(WindWizard::OnPaint));
 	Disconnect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(WindWizard::OnEraseBackground));
@@ -58,61 +80,347 @@ void WindWizard::OnSize(wxSizeEvent& event) {
 	//this->SetSize(event.GetSize());
 }
 
+DisplayValue::DisplayValue(double displayResolution, double displayHysteresis, bool angle) {
+	resolution = displayResolution;
+	hysteresis = displayHysteresis;
+	isAngle = angle;
+	displayed = NAN;
+}
+
+bool DisplayValue::Update(double value) {
+	if (isnan(value)) {
+		if (isnan(displayed)) {
+			return false;
+		}
+		displayed = NAN;
+		return true;
+	}
+
+	if (!isnan(displayed)) {
+		double difference = value - displayed;
+		if (isAngle) {
+			difference = remainder(difference, 360.0);
+		}
+		if (fabs(difference) < (resolution * (0.5 + hysteresis))) {
+			return false;
+		}
+	}
+
+	displayed = round(value / resolution) * resolution;
+	if (isAngle) {
+		displayed = fmod(displayed + 360.0, 360.0);
+	}
+	return true;
+}
+
 void WindWizard::SetMagneticHeading(double heading) {
-	magneticHeading = NormalizeHeading(heading);
+	// The compass card and bearing rotate, so everything must be redrawn
+	if (magneticHeadingDisplay.Update(NormalizeHeading(heading))) {
+		values.magneticHeading = magneticHeadingDisplay.GetValue();
+		InvalidateAll();
+	}
 }
 
 void WindWizard::SetTrueHeading(double heading) {
-	trueHeading = NormalizeHeading(heading);
+	values.trueHeading = NormalizeHeading(heading);
 }
 
 void WindWizard::SetBearing(double bearing) {
-	bearingToWaypoint = NormalizeHeading(bearing);
+	double previous = values.bearingToWaypoint;
+	if (bearingDisplay.Update(NormalizeHeading(bearing))) {
+		values.bearingToWaypoint = bearingDisplay.GetValue();
+		if (values.displayBearingToWaypoint) {
+			Invalidate(renderer.GetBearingRect(previous));
+			Invalidate(renderer.GetBearingRect(values.bearingToWaypoint));
+		}
+	}
 }
 
 void WindWizard::SetApparentWindAngle(double windAngle) {
-	apparentWindAngle = NormalizeHeading(windAngle);
+	if (apparentWindAngleDisplay.Update(NormalizeHeading(windAngle))) {
+		apparentWindNeedle.target = apparentWindAngleDisplay.GetValue();
+		StartAnimation();
+	}
 }
 
 void WindWizard::SetTrueWindAngle(double windAngle) {
-	trueWindAngle = NormalizeHeading(windAngle);
+	if (trueWindAngleDisplay.Update(NormalizeHeading(windAngle))) {
+		trueWindNeedle.target = trueWindAngleDisplay.GetValue();
+		StartAnimation();
+	}
 }
 
 void WindWizard::SetApparentWindSpeed(double windSpeed) {
-	apparentWindSpeed = windSpeed;
+	if (apparentWindSpeedDisplay.Update(windSpeed)) {
+		values.apparentWindSpeed = apparentWindSpeedDisplay.GetValue();
+		Invalidate(renderer.GetCentreRect(renderer.GetRadius() / 2.0f - 2, renderer.GetLabelHeight() + 4));
+	}
 }
 void WindWizard::SetTrueWindSpeed(double windSpeed) {
-	trueWindSpeed = windSpeed;
+	if (trueWindSpeedDisplay.Update(windSpeed)) {
+		values.trueWindSpeed = trueWindSpeedDisplay.GetValue();
+		Invalidate(renderer.GetCornerRect(true, true));
+	}
 }
 void WindWizard::SetWaterDepth(double depth) {
-	waterDepth = depth;
+	values.waterDepth = depth;
 }
 void WindWizard::SetBoatSpeed(double speed) {
-	boatSpeed = speed;
+	if (boatSpeedDisplay.Update(speed)) {
+		values.boatSpeed = boatSpeedDisplay.GetValue();
+		Invalidate(renderer.GetCornerRect(false, false));
+	}
 }
 void WindWizard::SetCOG(double cog) {
-	courseOverGround = NormalizeHeading(cog);
+	values.courseOverGround = NormalizeHeading(cog);
 }
 void WindWizard::SetSOG(double sog) {
-	speedOverGround = sog;
+	if (speedOverGroundDisplay.Update(sog)) {
+		values.speedOverGround = speedOverGroundDisplay.GetValue();
+		Invalidate(renderer.GetCornerRect(false, true));
+	}
 }
 void WindWizard::SetVMG(double vmg) {
-	velocityMadeGood = vmg;
+	if (velocityMadeGoodDisplay.Update(vmg)) {
+		values.velocityMadeGood = velocityMadeGoodDisplay.GetValue();
+		Invalidate(renderer.GetCornerRect(true, false));
+	}
 }
 void WindWizard::SetDriftAngle(double angle) {
-	driftAngle = angle;
+	if (driftAngleDisplay.Update(angle)) {
+		values.driftAngle = driftAngleDisplay.GetValue();
+		// The arrow may point anywhere within 0.4 of the radius, its label is just below the centre
+		Invalidate(renderer.GetCentreRect(-renderer.GetRadius() * 0.5f, renderer.GetRadius()).Union(renderer.GetCentreRect(0, renderer.GetLabelHeight())));
+	}
 }
 
 void WindWizard::SetDriftSpeed(double speed) {
-	driftSpeed = speed;
+	if (driftSpeedDisplay.Update(speed)) {
+		values.driftSpeed = isnan(driftSpeedDisplay.GetValue()) ? 0.0 : driftSpeedDisplay.GetValue();
+		// The arrow may point anywhere within 0.4 of the radius, its label is just below the centre
+		Invalidate(renderer.GetCentreRect(-renderer.GetRadius() * 0.5f, renderer.GetRadius()).Union(renderer.GetCentreRect(0, renderer.GetLabelHeight())));
+	}
 }
 
 void WindWizard::ShowBearing(bool show) {
-	displayBearingToWaypoint = show;
+	if (show != values.displayBearingToWaypoint) {
+		values.displayBearingToWaypoint = show;
+		Invalidate(renderer.GetBearingRect(values.bearingToWaypoint));
+	}
+}
+
+void WindWizard::SetStartPrediction(double burn, double probability) {
+	bool wasOver = (!isnan(values.probabilityOver)) && (values.probabilityOver >= 0.5);
+	bool isOver = (!isnan(probability)) && (probability >= 0.5);
+	values.probabilityOver = probability;
+	// Only the colour depends upon the probability
+	if ((timeToBurnDisplay.Update(burn)) || (wasOver != isOver)) {
+		values.timeToBurn = timeToBurnDisplay.GetValue();
+		if (values.displayStartPrediction) {
+			Invalidate(renderer.GetCentreRect(-(renderer.GetRadius() / 4.0f) - renderer.GetLabelHeight(), renderer.GetLabelHeight()));
+		}
+	}
+}
+
+void WindWizard::ShowStartPrediction(bool show) {
+	if (show != values.displayStartPrediction) {
+		values.displayStartPrediction = show;
+		Invalidate(renderer.GetCentreRect(-(renderer.GetRadius() / 4.0f) - renderer.GetLabelHeight(), renderer.GetLabelHeight()));
+	}
 }
 
 void WindWizard::SetNightMode(bool mode) {
-	nightMode = mode;
+	if (mode != values.nightMode) {
+		values.nightMode = mode;
+		InvalidateAll();
+	}
+}
+
+void WindWizard::SetSpeedUnits(const wxString& units, double conversion) {
+	if ((units != values.speedUnits) || (conversion != values.speedConversion)) {
+		values.speedUnits = units;
+		values.speedConversion = conversion;
+		Invalidate(renderer.GetCornerRect(false, false));
+		Invalidate(renderer.GetCornerRect(true, false));
+		Invalidate(renderer.GetCornerRect(false, true));
+		Invalidate(renderer.GetCornerRect(true, true));
+		Invalidate(renderer.GetCentreRect(renderer.GetRadius() / 2.0f - 2, renderer.GetLabelHeight() + 4));
+	}
+}
+
+void WindWizard::SetDisplayScale(double scale) {
+	// The window may already be measured in logical pixels, eg. on macOS
+	int size = wxRound(MINIMUM_SIZE * scale / GetContentScaleFactor());
+	SetMinSize(wxSize(size, size));
+}
+
+void WindWizard::Invalidate(const wxRect& rect) {
+	dirtyRegion.Union(rect);
+}
+
+void WindWizard::InvalidateAll(void) {
+	isFullRefresh = true;
+}
+
+void WindWizard::UpdateDisplay(void) {
+
+	// No repaint work at all if the gauge can't be seen
+	wxTopLevelWindow* topLevel = wxDynamicCast(wxGetTopLevelParent(this), wxTopLevelWindow);
+	if ((!IsShownOnScreen()) || ((topLevel != nullptr) && (topLevel->IsIconized()))) {
+		// wxWidgets repaints everything when the gauge is shown again
+		dirtyRegion.Clear();
+		isFullRefresh = false;
+		return;
+	}
+
+	// Until the first paint, the geometry of the gauge is unknown
+	if ((isFullRefresh) || (!renderer.IsLaidOut())) {
+		Refresh();
+	}
+	else {
+		for (wxRegionIterator region(dirtyRegion); region; ++region) {
+			RefreshRect(region.GetRect());
+		}
+	}
+	dirtyRegion.Clear();
+	isFullRefresh = false;
+}
+
+void WindWizard::SetAnimationRate(int framesPerSecond) {
+	if (framesPerSecond != animationRate) {
+		animationRate = framesPerSecond > 0 ? framesPerSecond : 0;
+		frameRate = animationRate;
+		framesWithinBudget = 0;
+		if (animationTimer.IsRunning()) {
+			animationTimer.Stop();
+			StartAnimation();
+		}
+	}
+}
+
+long long WindWizard::GetMilliseconds(void) {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Animate the needles from where they are currently drawn towards their targets
+void WindWizard::StartAnimation(void) {
+
+	long long now = GetMilliseconds();
+
+	// Both wind angles are updated together, so only measure the interval between distinct updates.
+	// The needles then arrive at their target just as the next update is due
+	if ((now - lastUpdateTime) > 100) {
+		if (lastUpdateTime > 0) {
+			animationDuration = std::max(std::min(now - lastUpdateTime, 2000LL), 100LL);
+		}
+		lastUpdateTime = now;
+	}
+
+	apparentWindNeedle.start = values.apparentWindAngle;
+	trueWindNeedle.start = values.trueWindAngle;
+	animationStart = now;
+
+	if ((frameRate == 0) || (!IsShownOnScreen())) {
+		// Jump straight to the new angles
+		MoveNeedle(values.apparentWindAngle, apparentWindNeedle, 1.0);
+		MoveNeedle(values.trueWindAngle, trueWindNeedle, 1.0);
+		animationTimer.Stop();
+		return;
+	}
+
+	if (!animationTimer.IsRunning()) {
+		animationTimer.Start(1000 / frameRate);
+	}
+}
+
+void WindWizard::OnAnimationTimer(wxTimerEvent& event) {
+
+	double fraction = static_cast<double>(GetMilliseconds() - animationStart) / animationDuration;
+	if ((fraction >= 1.0) || (!IsShownOnScreen())) {
+		fraction = 1.0;
+		animationTimer.Stop();
+	}
+
+	MoveNeedle(values.apparentWindAngle, apparentWindNeedle, fraction);
+	MoveNeedle(values.trueWindAngle, trueWindNeedle, fraction);
+
+	// Only the needles' regions are repainted, the cached layers are simply blitted
+	UpdateDisplay();
+	AdjustFrameRate();
+}
+
+// Interpolate along the shortest path, eg. from 350 to 10 degrees passes through 0
+void WindWizard::MoveNeedle(double& drawnAngle, const NeedleAnimation& needle, double fraction) {
+	double difference = remainder(needle.target - needle.start, 360.0);
+	double angle = fmod(needle.start + (difference * fraction) + 360.0, 360.0);
+	if (angle != drawnAngle) {
+		Invalidate(renderer.GetNeedleRect(drawnAngle));
+		drawnAngle = angle;
+		Invalidate(renderer.GetNeedleRect(drawnAngle));
+	}
+}
+
+// If painting takes more than its share of the frame interval, halve the frame rate. 
+// Once painting has been within budget for a few seconds, step back up towards the configured rate
+void WindWizard::AdjustFrameRate(void) {
+
+	if (frameRate == 0) {
+		return;
+	}
+
+	double budget = (1000000.0 / frameRate) * FRAME_BUDGET;
+	int rate = frameRate;
+	double averagePaintTime = renderer.GetAverageRenderTime();
+	if ((averagePaintTime > budget) && (frameRate > MINIMUM_FRAME_RATE)) {
+		rate = std::max(frameRate / 2, MINIMUM_FRAME_RATE);
+		framesWithinBudget = 0;
+	}
+	else if ((averagePaintTime < (budget / 4.0)) && (frameRate < animationRate)) {
+		framesWithinBudget++;
+		if (framesWithinBudget > (frameRate * 5)) {
+			rate = std::min(frameRate * 2, animationRate);
+			framesWithinBudget = 0;
+		}
+	}
+
+	if (rate != frameRate) {
+		wxLogMessage("Racing Plugin, Wind Wizard paint time %.0f us, frame rate changed from %d to %d", averagePaintTime, frameRate, rate);
+		frameRate = rate;
+		if (animationTimer.IsRunning()) {
+			animationTimer.Start(1000 / frameRate);
+		}
+	}
+}
+
+// Bounding box of a wind needle, which lies between the compass card and the outer edge of the wind rose
+wxRect WindWizardRenderer::GetNeedleRect(double angle) const {
+	double radians = (angle - 90.0f) * M_PI / 180.0f;
+	wxRect rect(wxPoint((cos(radians) * radius) + xCentre, (sin(radians) * radius) + yCentre), wxSize(1, 1));
+	rect.Union(wxRect(wxPoint((cos(radians + 0.09f) * outerRing) + xCentre, (sin(radians + 0.09f) * outerRing) + yCentre), wxSize(1, 1)));
+	rect.Union(wxRect(wxPoint((cos(radians - 0.09f) * outerRing) + xCentre, (sin(radians - 0.09f) * outerRing) + yCentre), wxSize(1, 1)));
+	return rect.Inflate(2);
+}
+
+// Bounding box of the yellow dot indicating the bearing to the active waypoint
+wxRect WindWizardRenderer::GetBearingRect(double bearing) const {
+	double radians = (bearing - values.magneticHeading - 90.0f) * M_PI / 180.0f;
+	int size = static_cast<int>(outerRing - radius);
+	return wxRect(static_cast<int>((cos(radians) * outerRing) + xCentre) - size,
+		static_cast<int>((sin(radians) * outerRing) + yCentre) - size, 2 * size, 2 * size).Inflate(2);
+}
+
+// Labels in the corners of the gauge
+wxRect WindWizardRenderer::GetCornerRect(bool isRight, bool isBottom) const {
+	int x = isRight ? static_cast<int>(xCentre) : 0;
+	int y = isBottom ? static_cast<int>(yCentre + radius) : static_cast<int>(yCentre - radius) - labelHeight;
+	return wxRect(x, y, layerSize.GetWidth() - static_cast<int>(xCentre), labelHeight);
+}
+
+// Labels within the boat icon, centred horizontally
+wxRect WindWizardRenderer::GetCentreRect(double yOffset, double height) const {
+	return wxRect(static_cast<int>(xCentre - radius / 2.0f), static_cast<int>(yCentre + yOffset),
+		static_cast<int>(radius), static_cast<int>(height)).Inflate(2);
 }
 
 double WindWizard::NormalizeHeading(double& heading) {
@@ -128,365 +436,515 @@ double WindWizard::NormalizeHeading(double& heading) {
 }
 
 void WindWizard::OnPaint(wxPaintEvent& evt) {
+
 	// To avoid flickering....
 	wxAutoBufferedPaintDC dc(this);
 
 	if (dc.IsOk()) {
+		renderer.Render(dc, GetClientSize());
+	}
+}
 
-		dc.Clear();
+WindWizardRenderer::WindWizardRenderer() {
+	for (int i = 0; i < COMPASS_LABEL_COUNT; i++) {
+		compassLabelOffsets[i] = 0.0;
+	}
+}
 
-		wxGraphicsContext* gc = wxGraphicsContext::Create(dc);
+void WindWizardRenderer::Render(wxDC& dc, const wxSize& size) {
+	std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
 
-		if (gc) {
-			
-			if (nightMode) {
-				SetBackgroundColour(*wxBLACK);
-			}
-			else {
-				SetBackgroundColour(*wxWHITE);
-			}
+	if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0)) {
+		return;
+	}
 
-			// Note to self, investigate device independent pixels
-			// eg. dc.FromDIP(wxSize(x, y));
+	// Rebuild the static layer if the size, colour scheme or display scaling has changed
+	double scale = dc.GetContentScaleFactor();
+	if ((!staticLayer.IsOk()) || (size != layerSize) || (values.nightMode != layerNightMode) || (scale != layerScale)) {
+		layerSize = size;
+		layerNightMode = values.nightMode;
+		layerScale = scale;
+		BuildStaticLayer();
+		cardHeading = -1;
+	}
+
+	// Rebuild the compass card if the heading has changed by at least a degree
+	int heading = static_cast<int>(values.magneticHeading) % 360;
+	if (heading != cardHeading) {
+		cardHeading = heading;
+		BuildCompassCard();
+	}
+
+	// A single blit for everything but the needles and values
+	dc.DrawBitmap(cardLayer, 0, 0);
 
-			double xCentre = GetClientSize().GetWidth() / 2.0f;
-			double yCentre = GetClientSize().GetHeight() / 2.0f;
+	// Any device context, not only a window or memory device context
+	wxGraphicsContext* gc = wxGraphicsContext::CreateFromUnknownDC(dc);
+	if (gc) {
+		DrawDynamicLayer(dc, gc);
+		gc->Flush();
+		delete gc;
+	}
+
+	// Smoothed render time, used to limit the animation frame rate
+	double renderTime = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - renderStart).count());
+	averageRenderTime += (renderTime - averageRenderTime) / 8.0;
+	frameCount++;
+}
 
-			// Determine the maximum size of our dial
-			double radius = wxMin(xCentre, yCentre) * 0.8f;
+// Draw those parts of the gauge that only change when it is resized or the colour scheme changes:
+// the dial, the wind rose and its labels, the boat icon and the captions of the corner labels
+void WindWizardRenderer::BuildStaticLayer(void) {
 
-			// Co-ordinates etc.
-			double radians, offset;
-			wxCoord xPos, yPos;
+	// Layers are measured in logical pixels but have as many pixels as the display,
+	// so they are drawn at the display's density once and blitted without resampling
+	staticLayer.CreateScaled(layerSize.GetWidth(), layerSize.GetHeight(), wxBITMAP_SCREEN_DEPTH, layerScale);
+	cardLayer.CreateScaled(layerSize.GetWidth(), layerSize.GetHeight(), wxBITMAP_SCREEN_DEPTH, layerScale);
 
-			// Use the Swiss font as it is TrueType and can be rotated
-			// BUG BUG Scaling of fonts as the gauge is resized
-			wxFont textFont = wxFont(wxFontInfo(8).Family(wxFONTFAMILY_SWISS));
-			dc.SetFont(textFont);
+	wxMemoryDC dc(staticLayer);
+	dc.SetBackground(values.nightMode ? *wxBLACK_BRUSH : *wxWHITE_BRUSH);
+	dc.Clear();
+
+	wxGraphicsContext* gc = wxGraphicsContext::Create(dc);
+	if (!gc) {
+		return;
+	}
+
+	xCentre = layerSize.GetWidth() / 2.0f;
+	yCentre = layerSize.GetHeight() / 2.0f;
+
+	// Determine the maximum size of our dial
+	radius = wxMin(xCentre, yCentre) * 0.8f;
+
+	// Line widths in proportion to the dial, 2 pixels at the minimum size
+	thickPen = std::max(1, wxRound(radius / 50.0f));
+	thinPen = std::max(1, thickPen / 2);
+
+	// Co-ordinates etc.
+	double radians, offset;
+	wxCoord xPos, yPos;
+
+	// Use the Swiss font as it is TrueType and can be rotated.
+	// Sized in pixels in proportion to the dial, so the layout is the same at any size or display density
+	textFont = wxFont(wxFontInfo(wxSize(0, std::max(MINIMUM_FONT_HEIGHT, wxRound(radius * FONT_HEIGHT_RATIO)))).Family(wxFONTFAMILY_SWISS));
+	headingFont = textFont.Bold().MakeLarger();
+	labelFont = headingFont.Bold().Larger();
+	dc.SetFont(textFont);
 			    		
-			// Specify font and "dummy" label in order to calculate text widths and heights
-			wxCoord textWidth;
-			wxCoord textHeight;
-			wxCoord textDescent = 0;
-			wxCoord textLeading = 0;
-			wxString label = "000";
-			dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent,&textLeading, &textFont);
-
-			double outerRing = radius + textHeight;
-			double innerRing = radius - textHeight;
-
-			// Make an annular ring for the compass rose
-			if (nightMode) {
-				gc->SetPen(wxPen(*wxWHITE, 2));
-				gc->SetBrush(*wxGREY_BRUSH);
-			}
-			else {
-				gc->SetPen(wxPen(*wxBLACK, 2));
-				gc->SetBrush(*wxWHITE_BRUSH);
-			}
+	// Specify font and "dummy" label in order to calculate text widths and heights
+	wxCoord textWidth;
+	wxCoord textHeight;
+	wxCoord textDescent = 0;
+	wxCoord textLeading = 0;
+	wxString label = "000";
+	dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent,&textLeading, &textFont);
+
+	outerRing = radius + textHeight;
+	innerRing = radius - textHeight;
+
+	// Make an annular ring for the compass rose
+	if (values.nightMode) {
+		gc->SetPen(wxPen(*wxWHITE, thickPen));
+		gc->SetBrush(*wxGREY_BRUSH);
+	}
+	else {
+		gc->SetPen(wxPen(*wxBLACK, thickPen));
+		gc->SetBrush(*wxWHITE_BRUSH);
+	}
 
-			wxGraphicsPath compassRose = gc->CreatePath();
-			compassRose.AddCircle(xCentre, yCentre, radius);
-			compassRose.AddCircle(xCentre, yCentre, innerRing);
-			gc->StrokePath(compassRose);
-			gc->FillPath(compassRose);
-
-			// And another pair of annular rings for the wind rose
-			wxGraphicsPath starboardWindGauge = gc->CreatePath();
-			wxGraphicsPath portWindGauge = gc->CreatePath();
-			wxGraphicsGradientStops starboardGradient, portGradient;
-
-			starboardGradient.SetStartColour(wxColour(60, 255, 120));
-			starboardGradient.SetEndColour(wxColour(60, 150, 60));
-			portGradient.SetStartColour(wxColour(250, 0, 0));
-			portGradient.SetEndColour(wxColour(140, 0, 0));
-
-			gc->SetBrush(gc->CreateLinearGradientBrush(xCentre, yCentre - innerRing,
-				xCentre, yCentre + outerRing, starboardGradient));
-
-			starboardWindGauge.MoveToPoint(xCentre, yCentre - radius);
-			starboardWindGauge.AddArc(xCentre, yCentre, radius, (3.0 / 2.0f) * M_PI, M_PI / 2.0f, true);
-			starboardWindGauge.AddLineToPoint(xCentre, yCentre + outerRing);
-			starboardWindGauge.AddArc(xCentre, yCentre, outerRing, M_PI / 2.0f, (3.0 / 2.0f) * M_PI, false);
-			starboardWindGauge.AddLineToPoint(xCentre, yCentre - radius);
-			starboardWindGauge.CloseSubpath();
-
-			gc->StrokePath(starboardWindGauge);
-			gc->FillPath(starboardWindGauge);
-
-			gc->SetBrush(gc->CreateLinearGradientBrush(xCentre, yCentre - innerRing,
-				xCentre, yCentre + outerRing, portGradient));
-
-			portWindGauge.MoveToPoint(xCentre, yCentre - radius);
-			portWindGauge.AddArc(xCentre, yCentre, radius, (3.0 / 2.0f) * M_PI, M_PI / 2.0f, false);
-			portWindGauge.AddLineToPoint(xCentre, yCentre + outerRing);
-			portWindGauge.AddArc(xCentre, yCentre, outerRing, M_PI / 2.0f, (3.0 / 2.0f) * M_PI, true);
-			portWindGauge.AddLineToPoint(xCentre, yCentre - radius);
-			portWindGauge.CloseSubpath();
-
-			gc->StrokePath(portWindGauge);
-			gc->FillPath(portWindGauge);
-
-			if (nightMode) {
-				dc.SetPen(*wxWHITE_PEN);
-				dc.SetTextForeground(*wxWHITE);
-			}
-			else {
-				dc.SetPen(*wxBLACK_PEN);
-				dc.SetTextForeground(*wxBLACK);
-			}
+	wxGraphicsPath compassRose = gc->CreatePath();
+	compassRose.AddCircle(xCentre, yCentre, radius);
+	compassRose.AddCircle(xCentre, yCentre, innerRing);
+	gc->StrokePath(compassRose);
+	gc->FillPath(compassRose);
+
+	// And another pair of annular rings for the wind rose
+	wxGraphicsPath starboardWindGauge = gc->CreatePath();
+	wxGraphicsPath portWindGauge = gc->CreatePath();
+	wxGraphicsGradientStops starboardGradient, portGradient;
+
+	starboardGradient.SetStartColour(wxColour(60, 255, 120));
+	starboardGradient.SetEndColour(wxColour(60, 150, 60));
+	portGradient.SetStartColour(wxColour(250, 0, 0));
+	portGradient.SetEndColour(wxColour(140, 0, 0));
+
+	gc->SetBrush(gc->CreateLinearGradientBrush(xCentre, yCentre - innerRing,
+		xCentre, yCentre + outerRing, starboardGradient));
+
+	starboardWindGauge.MoveToPoint(xCentre, yCentre - radius);
+	starboardWindGauge.AddArc(xCentre, yCentre, radius, (3.0 / 2.0f) * M_PI, M_PI / 2.0f, true);
+	starboardWindGauge.AddLineToPoint(xCentre, yCentre + outerRing);
+	starboardWindGauge.AddArc(xCentre, yCentre, outerRing, M_PI / 2.0f, (3.0 / 2.0f) * M_PI, false);
+	starboardWindGauge.AddLineToPoint(xCentre, yCentre - radius);
+	starboardWindGauge.CloseSubpath();
+
+	gc->StrokePath(starboardWindGauge);
+	gc->FillPath(starboardWindGauge);
+
+	gc->SetBrush(gc->CreateLinearGradientBrush(xCentre, yCentre - innerRing,
+		xCentre, yCentre + outerRing, portGradient));
+
+	portWindGauge.MoveToPoint(xCentre, yCentre - radius);
+	portWindGauge.AddArc(xCentre, yCentre, radius, (3.0 / 2.0f) * M_PI, M_PI / 2.0f, false);
+	portWindGauge.AddLineToPoint(xCentre, yCentre + outerRing);
+	portWindGauge.AddArc(xCentre, yCentre, outerRing, M_PI / 2.0f, (3.0 / 2.0f) * M_PI, true);
+	portWindGauge.AddLineToPoint(xCentre, yCentre - radius);
+	portWindGauge.CloseSubpath();
+
+	gc->StrokePath(portWindGauge);
+	gc->FillPath(portWindGauge);
+
+	if (values.nightMode) {
+		dc.SetPen(*wxWHITE_PEN);
+		dc.SetTextForeground(*wxWHITE);
+	}
+	else {
+		dc.SetPen(*wxBLACK_PEN);
+		dc.SetTextForeground(*wxBLACK);
+	}
 
-			// Annotate the wind rose with tick marks and labels
-			for (int degrees = 0; degrees < 360; degrees += 10) {
-
-				radians = ((270 - degrees) * M_PI) / 180.0f;
-
-				// Text labels are drawn at 30 degree intervals, except 0 & 180, otherwise just tick marks
-				if (((degrees % 30) == 0) && (degrees != 0) && (degrees != 180) ) {
-					// labels are 0 - 160 on both the port & starboard sides
-					label = wxString::Format("%i", degrees < 180 ? degrees : 360 - degrees);
-					dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent, &textLeading, &textFont);
-
-					offset = CalculateOffset(radius, textWidth / 2.0f);
-					xPos = (cos(radians - offset) * outerRing) + xCentre;
-					yPos = (sin(radians - offset) * outerRing) + yCentre;
-					// Text rotation is from top left and in an anti clockwise direction for +ve values!!
-					dc.DrawRotatedText(label, xPos, yPos, degrees);
-				}
-				else {
-					radians = degrees * M_PI / 180.0f;
-					wxCoord x1, y1, x2, y2;
-					x1 = (cos(radians) * radius) + xCentre;
-					y1 = (sin(radians) * radius) + yCentre;
-					x2 = (cos(radians) * (outerRing)) + xCentre;
-					y2 = (sin(radians) * (outerRing)) + yCentre;
-					dc.DrawLine(x1, y1, x2, y2);
-				}
-			}
+	// Annotate the wind rose with tick marks and labels
+	for (int degrees = 0; degrees < 360; degrees += 10) {
 
-			// Similarly annotate the compass card with tick marks and labels
-			// BUG BUG could refactor this together with the wind rose
-			for (int degrees = 0; degrees < 360; degrees += 10) {
-
-				radians = ((270 + degrees - magneticHeading) * M_PI) / 180.0f;
-
-				// Text labels are drawn at 30 degree intervals, otherwise just tick marks
-				if ((degrees % 30) == 0) {
-					label = wxString::Format("%i", degrees);
-					dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent, &textLeading, &textFont);
-					offset = CalculateOffset(radius, textWidth / 2.0f);
-					xPos = (cos(radians - offset) * radius) + xCentre;
-					yPos = (sin(radians - offset) * radius) + yCentre;
-					dc.DrawRotatedText(label, xPos, yPos, magneticHeading - static_cast<double>(degrees));
-				}
-				else {
-					wxCoord x1, y1, x2, y2;
-					x1 = (cos(radians) * radius) + xCentre;
-					y1 = (sin(radians) * radius) + yCentre;
-					x2 = (cos(radians) * (innerRing)) + xCentre;
-					y2 = (sin(radians) * (innerRing)) + yCentre;
-					dc.DrawLine(x1, y1, x2, y2);
-				}
-			}
-			
-			// Draw the magnetic heading inside a rounded rectangle, located at 12 o'clock
-			if (nightMode) {
-				dc.SetTextForeground(*wxRED);
-			}
-			else {
-				dc.SetTextForeground(*wxWHITE);
-			}
-			dc.SetBrush(*wxBLACK_BRUSH);
-			dc.SetFont(textFont.Bold().MakeLarger());
-			label = wxString::Format("%d", static_cast<int>(magneticHeading));
-			dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent, &textLeading, &dc.GetFont());
-			// Note an extra 2 pixels space around the top, bottom & sides
-			dc.DrawRoundedRectangle(xCentre - (textWidth / 2.0f) -2, yCentre - radius - 2, textWidth + 4, textHeight + 4, 3.0f);
-			dc.DrawText(label, xCentre - (textWidth / 2.0f), yCentre - radius);
-			// Restore normal font.
-			if (nightMode) {
-				dc.SetTextForeground(*wxRED);
-			}
-			else {
-				dc.SetTextForeground(*wxBLACK);
-			}
-			dc.SetFont(textFont);
+		radians = ((270 - degrees) * M_PI) / 180.0f;
 
-			// Draw an arrow to indicate Apparent Wind Angle
-			double drawnAngle = apparentWindAngle;
-			if (drawnAngle > 360) {
-				drawnAngle -= 360;
-			}
+		// Text labels are drawn at 30 degree intervals, except 0 & 180, otherwise just tick marks
+		if (((degrees % 30) == 0) && (degrees != 0) && (degrees != 180) ) {
+			// labels are 0 - 160 on both the port & starboard sides
+			label = wxString::Format("%i", degrees < 180 ? degrees : 360 - degrees);
+			dc.GetTextExtent(label, &textWidth, &textHeight, &textDescent, &textLeading, &textFont);
 
-			// Remember 0 degrees is at 3 o'clock!
-			drawnAngle -= 90; 
-
-			radians = drawnAngle * M_PI / 180.0f;
-			wxPoint2DDouble arrow[3];
-			arrow[0].m_x = (cos(radians) * radius) + xCentre;
-			arrow[0].m_y = (sin(radians) * radius) + yCentre;
-			arrow[1].m_x = (cos(radians + 0.09f) * (outerRing)) + xCentre;
-			arrow[1].m_y = (sin(radians + 0.09f) * (outerRing)) + yCentre;
-			arrow[2].m_x = (cos(radians - 0.09f) * (outerRing)) + xCentre;
-			arrow[2].m_y = (sin(radians - 0.09f) * (outerRing)) + yCentre;
-			gc->SetPen(wxPen(wxColor(255, 153, 51), 1));
-			gc->SetBrush(wxColor(255,153,51)); 
-			gc->DrawLines(WXSIZEOF(arrow), arrow);
-
-			// Similarly draw an arrow to indicate True Wind Angle
-			drawnAngle = trueWindAngle;
-			if (drawnAngle > 360) {
-				drawnAngle -= 360;
-			}
+			offset = CalculateOffset(radius, textWidth / 2.0f);
+			xPos = (cos(radians - offset) * outerRing) + xCentre;
+			yPos = (sin(radians - offset) * outerRing) + yCentre;
+			// Text rotation is from top left and in an anti clockwise direction for +ve values!!
+			dc.DrawRotatedText(label, xPos, yPos, degrees);
+		}
+		else {
+			radians = degrees * M_PI / 180.0f;
+			wxCoord x1, y1, x2, y2;
+			x1 = (cos(radians) * radius) + xCentre;
+			y1 = (sin(radians) * radius) + yCentre;
+			x2 = (cos(radians) * (outerRing)) + xCentre;
+			y2 = (sin(radians) * (outerRing)) + yCentre;
+			dc.DrawLine(x1, y1, x2, y2);
+		}
+	}
 
-			drawnAngle -= 90;
+	// The compass card labels never change, so format and measure them once
+	for (int i = 0; i < COMPASS_LABEL_COUNT; i++) {
+		compassLabels[i] = wxString::Format("%i", i * 30);
+		dc.GetTextExtent(compassLabels[i], &textWidth, &textHeight, 0, 0, &textFont);
+		compassLabelOffsets[i] = CalculateOffset(radius, textWidth / 2.0f);
+	}
+
+	// Any cached value labels were measured with the previous fonts
+	labelGeneration++;
 
-			radians = drawnAngle * M_PI / 180.0f;
+	// Captions for the labels in the four corners of the gauge
+	if (values.nightMode) {
+		dc.SetTextForeground(*wxRED);
+	}
+	else {
+		dc.SetTextForeground(*wxBLACK);
+	}
+	dc.SetFont(labelFont);
+	dc.GetTextExtent("STW", &textWidth, &textHeight, 0, 0, &labelFont);
+	labelHeight = textHeight;
+	dc.DrawText("STW", 4, yCentre - radius);
+	dc.GetTextExtent("VMG", &textWidth, &textHeight, 0, 0, &labelFont);
+	dc.DrawText("VMG", layerSize.GetWidth() - textWidth - 4, yCentre - radius);
+	dc.GetTextExtent("SOG", &textWidth, &textHeight, 0, 0, &labelFont);
+	dc.DrawText("SOG", 4, yCentre + radius - labelHeight);
+	dc.GetTextExtent("TWS", &textWidth, &textHeight, 0, 0, &labelFont);
+	dc.DrawText("TWS", layerSize.GetWidth() - textWidth - 4, yCentre + radius - labelHeight);
+
+	// Draw a boat icon
+	wxGraphicsPath boatIcon = gc->CreatePath();
+	double quarter = (radius / 4.0f);
+	double threequarter = radius * 0.75f;
+	double half = (radius / 2.0f);
+	boatIcon.MoveToPoint(xCentre - quarter, yCentre + half);
+	boatIcon.AddQuadCurveToPoint(xCentre - half, yCentre - quarter, xCentre, yCentre - threequarter);
+	boatIcon.MoveToPoint(xCentre + quarter, yCentre + half);
+	boatIcon.AddQuadCurveToPoint(xCentre + half, yCentre - quarter, xCentre, yCentre - threequarter);
+	boatIcon.MoveToPoint(xCentre + quarter, yCentre + half);
+	boatIcon.AddLineToPoint(xCentre - quarter, yCentre + half);
+	if (values.nightMode) {
+		gc->SetPen(wxPen(*wxWHITE, thickPen));
+	}
+	else {
+		gc->SetPen(wxPen(*wxBLACK, thickPen));
+	}
+	gc->StrokePath(boatIcon);
+
+	gc->Flush();
+	delete gc;
+	dc.SelectObject(wxNullBitmap);
+}
+
+// Draw the compass card, rotated for the current heading, on top of the static layer
+void WindWizardRenderer::BuildCompassCard(void) {
+
+	wxMemoryDC dc(cardLayer);
+	dc.DrawBitmap(staticLayer, 0, 0);
+
+	double radians, offset;
+	wxCoord xPos, yPos;
+
+	dc.SetFont(textFont);
+	if (values.nightMode) {
+		dc.SetPen(*wxWHITE_PEN);
+		dc.SetTextForeground(*wxWHITE);
+	}
+	else {
+		dc.SetPen(*wxBLACK_PEN);
+		dc.SetTextForeground(*wxBLACK);
+	}
+
+	// Similarly annotate the compass card with tick marks and labels
+	// BUG BUG could refactor this together with the wind rose
+	for (int degrees = 0; degrees < 360; degrees += 10) {
+
+		radians = ((270 + degrees - cardHeading) * M_PI) / 180.0f;
+
+		// Text labels are drawn at 30 degree intervals, otherwise just tick marks
+		if ((degrees % 30) == 0) {
+			offset = compassLabelOffsets[degrees / 30];
+			xPos = (cos(radians - offset) * radius) + xCentre;
+			yPos = (sin(radians - offset) * radius) + yCentre;
+			dc.DrawRotatedText(compassLabels[degrees / 30], xPos, yPos, static_cast<double>(cardHeading - degrees));
+		}
+		else {
+			wxCoord x1, y1, x2, y2;
+			x1 = (cos(radians) * radius) + xCentre;
+			y1 = (sin(radians) * radius) + yCentre;
+			x2 = (cos(radians) * (innerRing)) + xCentre;
+			y2 = (sin(radians) * (innerRing)) + yCentre;
+			dc.DrawLine(x1, y1, x2, y2);
+		}
+	}
+
+	dc.SelectObject(wxNullBitmap);
+}
+
+// Draw the needles and values, which change with every update
+void WindWizardRenderer::DrawDynamicLayer(wxDC& dc, wxGraphicsContext* gc) {
+
+	double radians;
+	wxCoord xPos, yPos;
+
+	// Draw the magnetic heading inside a rounded rectangle, located at 12 o'clock
+	if (values.nightMode) {
+		dc.SetTextForeground(*wxRED);
+	}
+	else {
+		dc.SetTextForeground(*wxWHITE);
+	}
+	dc.SetPen(values.nightMode ? *wxWHITE_PEN : *wxBLACK_PEN);
+	dc.SetBrush(*wxBLACK_BRUSH);
+	dc.SetFont(headingFont);
+	int heading = static_cast<int>(values.magneticHeading);
+	CachedLabel* label = FindLabel(LABEL_HEADING, heading);
+	if (label == nullptr) {
+		label = &StoreLabel(LABEL_HEADING, heading, wxString::Format("%d", heading), dc, headingFont);
+	}
+	// Note an extra 2 pixels space around the top, bottom & sides
+	dc.DrawRoundedRectangle(xCentre - (label->width / 2.0f) -2, yCentre - radius - 2, label->width + 4, label->height + 4, 3.0f);
+	dc.DrawText(label->text, xCentre - (label->width / 2.0f), yCentre - radius);
+	// Restore normal font.
+	if (values.nightMode) {
+		dc.SetTextForeground(*wxRED);
+	}
+	else {
+		dc.SetTextForeground(*wxBLACK);
+	}
+	dc.SetFont(textFont);
+
+	// Draw an arrow to indicate Apparent Wind Angle
+	double drawnAngle = values.apparentWindAngle;
+	if (drawnAngle > 360) {
+		drawnAngle -= 360;
+	}
+
+	// Remember 0 degrees is at 3 o'clock!
+	drawnAngle -= 90; 
+
+	radians = drawnAngle * M_PI / 180.0f;
+	wxPoint2DDouble arrow[3];
+	arrow[0].m_x = (cos(radians) * radius) + xCentre;
+	arrow[0].m_y = (sin(radians) * radius) + yCentre;
+	arrow[1].m_x = (cos(radians + 0.09f) * (outerRing)) + xCentre;
+	arrow[1].m_y = (sin(radians + 0.09f) * (outerRing)) + yCentre;
+	arrow[2].m_x = (cos(radians - 0.09f) * (outerRing)) + xCentre;
+	arrow[2].m_y = (sin(radians - 0.09f) * (outerRing)) + yCentre;
+	gc->SetPen(wxPen(wxColor(255, 153, 51), thinPen));
+	gc->SetBrush(wxColor(255,153,51)); 
+	gc->DrawLines(WXSIZEOF(arrow), arrow);
+
+	// Similarly draw an arrow to indicate True Wind Angle
+	drawnAngle = values.trueWindAngle;
+	if (drawnAngle > 360) {
+		drawnAngle -= 360;
+	}
+
+	drawnAngle -= 90;
+
+	radians = drawnAngle * M_PI / 180.0f;
 			
-			arrow[0].m_x = (cos(radians) * radius) + xCentre;
-			arrow[0].m_y = (sin(radians) * radius) + yCentre;
-			arrow[1].m_x = (cos(radians + 0.09f) * (outerRing)) + xCentre;
-			arrow[1].m_y = (sin(radians + 0.09f) * (outerRing)) + yCentre;
-			arrow[2].m_x = (cos(radians - 0.09f) * (outerRing)) + xCentre;
-			arrow[2].m_y = (sin(radians - 0.09f) * (outerRing)) + yCentre;
-			gc->SetPen(wxPen(wxColor(51, 153, 255), 1));
-			gc->SetBrush(wxColor(51, 153, 255));
-			gc->DrawLines(WXSIZEOF(arrow), arrow);
-
-			// Draw a yellow dot to indicate the bearing to the waypoint
-			if (displayBearingToWaypoint) {
-				drawnAngle = (bearingToWaypoint - magneticHeading - 90.0f);
-				if (drawnAngle < 0) {
-					drawnAngle = 360.0f + drawnAngle;
-				}
-				radians =  drawnAngle * M_PI / 180.0f;
-				xPos = (cos(radians) * (outerRing)) + xCentre;
-				yPos = (sin(radians) * (outerRing)) + yCentre;
-				dc.SetBrush(*wxYELLOW_BRUSH);
-				dc.DrawCircle(xPos, yPos, textHeight / 2.0f);
-			}
+	arrow[0].m_x = (cos(radians) * radius) + xCentre;
+	arrow[0].m_y = (sin(radians) * radius) + yCentre;
+	arrow[1].m_x = (cos(radians + 0.09f) * (outerRing)) + xCentre;
+	arrow[1].m_y = (sin(radians + 0.09f) * (outerRing)) + yCentre;
+	arrow[2].m_x = (cos(radians - 0.09f) * (outerRing)) + xCentre;
+	arrow[2].m_y = (sin(radians - 0.09f) * (outerRing)) + yCentre;
+	gc->SetPen(wxPen(wxColor(51, 153, 255), thinPen));
+	gc->SetBrush(wxColor(51, 153, 255));
+	gc->DrawLines(WXSIZEOF(arrow), arrow);
+
+	// Draw a yellow dot to indicate the bearing to the waypoint
+	if (values.displayBearingToWaypoint) {
+		drawnAngle = (values.bearingToWaypoint - values.magneticHeading - 90.0f);
+		if (drawnAngle < 0) {
+			drawnAngle = 360.0f + drawnAngle;
+		}
+		radians =  drawnAngle * M_PI / 180.0f;
+		xPos = (cos(radians) * (outerRing)) + xCentre;
+		yPos = (sin(radians) * (outerRing)) + yCentre;
+		dc.SetBrush(*wxYELLOW_BRUSH);
+		dc.DrawCircle(xPos, yPos, (outerRing - radius) / 2.0f);
+	}
 
-			// Labels in the four corners of the gauge
-			// BUG BUG Could allow the user to select what fields to use
-			wxFont labelFont = dc.GetFont().Bold().Larger();
-			dc.SetFont(labelFont);
-
-			// Boat Speed
-			label = CreateLabel(toUsrSpeed_Plugin(boatSpeed), getUsrSpeedUnit_Plugin());
-			dc.GetTextExtent(label, &textWidth, &textHeight,0,0, &labelFont);
-			dc.DrawText(label, 4, yCentre - radius - textHeight);
-
-			label = "STW";
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, 4, yCentre - radius);
-
-			// Velocity Made Good
-			label = CreateLabel(toUsrSpeed_Plugin(velocityMadeGood), getUsrSpeedUnit_Plugin());
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, this->GetClientSize().GetWidth() - textWidth - 4, yCentre - radius - textHeight);
-
-			label = "VMG";
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, this->GetClientSize().GetWidth() - textWidth - 4, yCentre - radius);
-
-			// Speed Over Ground
-			label = CreateLabel(toUsrSpeed_Plugin(speedOverGround), getUsrSpeedUnit_Plugin());
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, 4, yCentre + radius);
-
-			label = "SOG";
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, 4, yCentre + radius - textHeight);
-
-			// True Wind Speed
-			label = CreateLabel(toUsrSpeed_Plugin(trueWindSpeed), getUsrSpeedUnit_Plugin());
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, this->GetClientSize().GetWidth() - textWidth - 4, yCentre + radius);
-
-			label = "TWS";
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, this->GetClientSize().GetWidth() - textWidth - 4, yCentre + radius - textHeight);
-
-			// Draw the Apparent Wind speed under the boat icon
-			label = CreateLabel(toUsrSpeed_Plugin(apparentWindSpeed), wxEmptyString);
-			dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-			dc.DrawText(label, xCentre - (textWidth / 2.0f) , yCentre + (radius / 2.0f));
-			dc.SetPen(*wxGREY_PEN);
-			dc.SetBrush(*wxTRANSPARENT_BRUSH);
-			dc.DrawRoundedRectangle(xCentre - (textWidth / 2.0f) - 2, yCentre + (radius / 2.0f) - 2, textWidth + 4, textHeight + 4, 3.0f);
-
-			// Draw a boat icon
-			wxGraphicsPath boatIcon = gc->CreatePath();
-			double quarter = (radius / 4.0f);
-			double threequarter = radius * 0.75f;
-			double half = (radius / 2.0f);
-			boatIcon.MoveToPoint(xCentre - quarter, yCentre + half);
-			boatIcon.AddQuadCurveToPoint(xCentre - half, yCentre - quarter, xCentre, yCentre - threequarter);
-			boatIcon.MoveToPoint(xCentre + quarter, yCentre + half);
-			boatIcon.AddQuadCurveToPoint(xCentre + half, yCentre - quarter, xCentre, yCentre - threequarter);
-			boatIcon.MoveToPoint(xCentre + quarter, yCentre + half);
-			boatIcon.AddLineToPoint(xCentre - quarter, yCentre + half);
-			if (nightMode) {
-				gc->SetPen(wxPen(*wxWHITE, 2));
+	// Labels in the four corners of the gauge, the captions are drawn on the static layer
+	// BUG BUG Could allow the user to select what fields to use
+	dc.SetFont(labelFont);
+	int width = layerSize.GetWidth();
+	const wxString& speedUnits = values.speedUnits;
+
+	// Boat Speed
+	label = &GetValueLabel(LABEL_STW, values.boatSpeed * values.speedConversion, speedUnits, dc);
+	dc.DrawText(label->text, 4, yCentre - radius - label->height);
+
+	// Velocity Made Good
+	label = &GetValueLabel(LABEL_VMG, values.velocityMadeGood * values.speedConversion, speedUnits, dc);
+	dc.DrawText(label->text, width - label->width - 4, yCentre - radius - label->height);
+
+	// Speed Over Ground
+	label = &GetValueLabel(LABEL_SOG, values.speedOverGround * values.speedConversion, speedUnits, dc);
+	dc.DrawText(label->text, 4, yCentre + radius);
+
+	// True Wind Speed
+	label = &GetValueLabel(LABEL_TWS, values.trueWindSpeed * values.speedConversion, speedUnits, dc);
+	dc.DrawText(label->text, width - label->width - 4, yCentre + radius);
+
+	// Draw the Apparent Wind speed under the boat icon
+	label = &GetValueLabel(LABEL_AWS, values.apparentWindSpeed * values.speedConversion, wxEmptyString, dc);
+	dc.DrawText(label->text, xCentre - (label->width / 2.0f) , yCentre + (radius / 2.0f));
+	dc.SetPen(*wxGREY_PEN);
+	dc.SetBrush(*wxTRANSPARENT_BRUSH);
+	dc.DrawRoundedRectangle(xCentre - (label->width / 2.0f) - 2, yCentre + (radius / 2.0f) - 2, label->width + 4, label->height + 4, 3.0f);
+
+	// During the pre-start, draw the time to burn in the bow, red if we are likely to be over early
+	if (values.displayStartPrediction) {
+		long long burn = isnan(values.timeToBurn) ? LLONG_MIN : llround(values.timeToBurn);
+		label = FindLabel(LABEL_BURN, burn);
+		if (label == nullptr) {
+			if (isnan(values.timeToBurn)) {
+				label = &StoreLabel(LABEL_BURN, burn, "--:--", dc, labelFont);
 			}
 			else {
-				gc->SetPen(wxPen(*wxBLACK, 2));
-			}
-			gc->StrokePath(boatIcon);
-
-			// Draw an arrow and label to indicate drift
-			if (driftSpeed != 0) {
-				wxPoint2DDouble currentArrow[7];
-				double driftDirection = (driftAngle * M_PI / 180);
-
-				currentArrow[0].m_x = xCentre + (radius * 0.4f * cos(driftDirection)); //.4
-				currentArrow[0].m_y = yCentre + (radius * 0.4f * sin(driftDirection));
-				currentArrow[1].m_x = xCentre + (radius * 0.2f * cos(driftDirection + 1.5)); //.18
-				currentArrow[1].m_y = yCentre + (radius * 0.2f * sin(driftDirection + 1.5));
-				currentArrow[2].m_x = xCentre + (radius * 0.1f * cos(driftDirection + 1.5));
-				currentArrow[2].m_y = yCentre + (radius * 0.1f * sin(driftDirection + 1.5));
-
-				currentArrow[3].m_x = xCentre + (radius * 0.3f * cos(driftDirection + 2.8)); //.3
-				currentArrow[3].m_y = yCentre + (radius * 0.3f * sin(driftDirection + 2.8));
-				currentArrow[4].m_x = xCentre + (radius * 0.3f * cos(driftDirection - 2.8));
-				currentArrow[4].m_y = yCentre + (radius * 0.3f * sin(driftDirection - 2.8));
-
-				currentArrow[5].m_x = xCentre + (radius * 0.1f * cos(driftDirection - 1.5));
-				currentArrow[5].m_y = yCentre + (radius * 0.1f * sin(driftDirection - 1.5));
-				currentArrow[6].m_x = xCentre + (radius * 0.2f * cos(driftDirection - 1.5)); //.18
-				currentArrow[6].m_y = yCentre + (radius * 0.2f * sin(driftDirection - 1.5));
-
-				wxGraphicsGradientStops driftGradient;
-				driftGradient.SetStartColour(wxColour(0, 102, 255));
-				driftGradient.SetEndColour(wxColour(179, 209, 255));
-				gc->SetBrush(gc->CreateLinearGradientBrush(currentArrow[3].m_x, currentArrow[3].m_y,
-					currentArrow[0].m_x, currentArrow[0].m_y, driftGradient));
-				gc->SetPen(*wxTRANSPARENT_PEN);
-				gc->DrawLines(WXSIZEOF(currentArrow), currentArrow);
-
-				label = CreateLabel(driftSpeed, getUsrSpeedUnit_Plugin());
-				dc.GetTextExtent(label, &textWidth, &textHeight, 0, 0, &labelFont);
-				dc.DrawText(label, xCentre - (textWidth / 2.0f), yCentre);
+				int seconds = static_cast<int>(llabs(burn));
+				label = &StoreLabel(LABEL_BURN, burn, wxString::Format("%c%d:%02d", burn < 0 ? '-' : '+', seconds / 60, seconds % 60), dc, labelFont);
 			}
-			
-			gc->Flush();
-			delete gc;
 		}
+		if ((!isnan(values.probabilityOver)) && (values.probabilityOver >= 0.5)) {
+			dc.SetTextForeground(*wxRED);
+		}
+		dc.DrawText(label->text, xCentre - (label->width / 2.0f), yCentre - (radius / 4.0f) - label->height);
+		if (values.nightMode) {
+			dc.SetTextForeground(*wxRED);
+		}
+		else {
+			dc.SetTextForeground(*wxBLACK);
+		}
+	}
+
+	// Draw an arrow and label to indicate drift
+	if (values.driftSpeed != 0) {
+		wxPoint2DDouble currentArrow[7];
+		double driftDirection = (values.driftAngle * M_PI / 180);
+
+		currentArrow[0].m_x = xCentre + (radius * 0.4f * cos(driftDirection)); //.4
+		currentArrow[0].m_y = yCentre + (radius * 0.4f * sin(driftDirection));
+		currentArrow[1].m_x = xCentre + (radius * 0.2f * cos(driftDirection + 1.5)); //.18
+		currentArrow[1].m_y = yCentre + (radius * 0.2f * sin(driftDirection + 1.5));
+		currentArrow[2].m_x = xCentre + (radius * 0.1f * cos(driftDirection + 1.5));
+		currentArrow[2].m_y = yCentre + (radius * 0.1f * sin(driftDirection + 1.5));
+
+		currentArrow[3].m_x = xCentre + (radius * 0.3f * cos(driftDirection + 2.8)); //.3
+		currentArrow[3].m_y = yCentre + (radius * 0.3f * sin(driftDirection + 2.8));
+		currentArrow[4].m_x = xCentre + (radius * 0.3f * cos(driftDirection - 2.8));
+		currentArrow[4].m_y = yCentre + (radius * 0.3f * sin(driftDirection - 2.8));
+
+		currentArrow[5].m_x = xCentre + (radius * 0.1f * cos(driftDirection - 1.5));
+		currentArrow[5].m_y = yCentre + (radius * 0.1f * sin(driftDirection - 1.5));
+		currentArrow[6].m_x = xCentre + (radius * 0.2f * cos(driftDirection - 1.5)); //.18
+		currentArrow[6].m_y = yCentre + (radius * 0.2f * sin(driftDirection - 1.5));
+
+		wxGraphicsGradientStops driftGradient;
+		driftGradient.SetStartColour(wxColour(0, 102, 255));
+		driftGradient.SetEndColour(wxColour(179, 209, 255));
+		gc->SetBrush(gc->CreateLinearGradientBrush(currentArrow[3].m_x, currentArrow[3].m_y,
+			currentArrow[0].m_x, currentArrow[0].m_y, driftGradient));
+		gc->SetPen(*wxTRANSPARENT_PEN);
+		gc->DrawLines(WXSIZEOF(currentArrow), currentArrow);
+
+		label = &GetValueLabel(LABEL_DRIFT, values.driftSpeed, speedUnits, dc);
+		dc.DrawText(label->text, xCentre - (label->width / 2.0f), yCentre);
+	}
+}
+
+// Returns the cached label for the slot, or nullptr if the displayed value, units or fonts have changed
+WindWizardRenderer::CachedLabel* WindWizardRenderer::FindLabel(LabelSlot slot, long long key, const wxString& units) {
+	CachedLabel& label = labelCache[slot];
+	if ((label.generation == labelGeneration) && (label.key == key) && (label.units == units)) {
+		return &label;
+	}
+	return nullptr;
+}
+
+// Save a newly formatted label and measure its extent
+WindWizardRenderer::CachedLabel& WindWizardRenderer::StoreLabel(LabelSlot slot, long long key, const wxString& text, wxDC& dc, const wxFont& font, const wxString& units) {
+	CachedLabel& label = labelCache[slot];
+	label.key = key;
+	label.units = units;
+	label.generation = labelGeneration;
+	label.text = text;
+	dc.GetTextExtent(label.text, &label.width, &label.height, 0, 0, &font);
+	return label;
+}
 
+// Values are displayed to one decimal place, so only reformat if the value changes by 0.1
+WindWizardRenderer::CachedLabel& WindWizardRenderer::GetValueLabel(LabelSlot slot, double value, const wxString& units, wxDC& dc) {
+	long long key = isnan(value) ? LLONG_MIN : llround(value * 10.0);
+	CachedLabel* label = FindLabel(slot, key, units);
+	if (label != nullptr) {
+		return *label;
 	}
-	
+	return StoreLabel(slot, key, CreateLabel(value, units), dc, labelFont, units);
 }
 
 // Basic trig, given the radius & text extent width, calculate the internal angle
 // So we can position the label correctly rotated and centred around the compass rose
-double WindWizard::CalculateOffset(double radius, double halfWidth) {
+double WindWizardRenderer::CalculateOffset(double radius, double halfWidth) {
 	double hypotenuse;
 	hypotenuse = sqrt((radius * radius) + (halfWidth * halfWidth));
 	return acos(radius / hypotenuse); 
 }
 
 // Generate a label, dashes if the value is unavailable/invalid
-wxString WindWizard::CreateLabel(double value, wxString units) {
+wxString WindWizardRenderer::CreateLabel(double value, wxString units) {
 	wxString result;
 	if (isnan(value)) {
 		result = wxString::Format("-- %s", units);
@@ -0,0 +1,513 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Wind history strip chart
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_history.h"
+
+#include <algorithm>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Selectable windows (minutes), clicking the chart cycles through them
+const int WINDOWS[] = { 5, 20, 60 };
+const int WINDOW_COUNT = 3;
+
+// Minimum half range of the direction scale (degrees), and the steps in which it grows
+const double MINIMUM_DIRECTION_RANGE = 20.0;
+const double DIRECTION_STEP = 10.0;
+
+// Minimum of the speed scale (knots), and the steps in which it grows
+const double MINIMUM_SPEED = 10.0;
+const double SPEED_STEP = 5.0;
+
+// Margin within each panel (pixels), so the traces don't touch the edges
+const int PANEL_MARGIN = 2;
+
+WindHistory::WindHistory(wxWindow* parent)
+	: wxControl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE) {
+
+#if defined (__WXMSW__)
+	this->SetBackgroundStyle(wxBG_STYLE_PAINT); // is/was needed for Microsoft Windows
+#endif
+
+	historyCount = 0;
+	historyNext = 0;
+	sampleNumber = 0;
+	previousDirection = NAN;
+	unwrappedDirection = 0.0;
+
+	windowSeconds = WINDOWS[1] * 60;
+	ResetStatistics();
+
+	isPlotValid = false;
+	plotNightMode = false;
+	labelHeight = 0;
+	directionHeight = 0;
+	columnCount = 0;
+	columnWidth = 1;
+	secondsPerColumn = 1;
+	nextColumn = 0;
+	ResetColumn();
+	hasPreviousColumn = false;
+	previousColumnDirection = 0.0;
+	previousColumnSpeed = 0.0;
+
+	directionCentre = 0.0;
+	directionRange = MINIMUM_DIRECTION_RANGE;
+	speedMaximum = MINIMUM_SPEED;
+
+	nightMode = false;
+	speedUnits = "kn";
+	speedConversion = 1.0;
+
+	Connect(wxEVT_PAINT, wxPaintEventHandler(WindHistory::OnPaint), NULL, this);
+	Connect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(WindHistory::OnEraseBackground), NULL, this);
+	Connect(wxEVT_SIZE, wxSizeEventHandler(WindHistory::OnSize), NULL, this);
+	Connect(wxEVT_LEFT_DOWN, wxMouseEventHandler(WindHistory::OnLeftClick), NULL, this);
+
+	SetMinSize(wxSize(250, 150));
+}
+
+WindHistory::~WindHistory() {
+	Disconnect(wxEVT_LEFT_DOWN, wxMouseEventHandler(WindHistory::OnLeftClick));
+	Disconnect(wxEVT_SIZE, wxSizeEventHandler(WindHistory::OnSize));
+	Disconnect(wxEVT_PAINT, wxPaintEventHandler(WindHistory::OnPaint));
+	Disconnect(wxEVT_ERASE_BACKGROUND, wxEraseEventHandler(WindHistory::OnEraseBackground));
+}
+
+void WindHistory::OnEraseBackground(wxEraseEvent& WXUNUSED(evt)) {
+	// intentionally a null op to avoid flickering
+}
+
+void WindHistory::OnSize(wxSizeEvent& event) {
+	// The plot is rebuilt at the new size when next painted
+	isPlotValid = false;
+	event.Skip();
+}
+
+void WindHistory::OnLeftClick(wxMouseEvent& event) {
+	int index = 0;
+	for (int i = 0; i < WINDOW_COUNT; i++) {
+		if (WINDOWS[i] == GetWindow()) {
+			index = (i + 1) % WINDOW_COUNT;
+		}
+	}
+	SetWindow(WINDOWS[index]);
+	event.Skip();
+}
+
+void WindHistory::SetWindow(int minutes) {
+	int seconds = WINDOWS[1] * 60;
+	for (int i = 0; i < WINDOW_COUNT; i++) {
+		if (WINDOWS[i] == minutes) {
+			seconds = minutes * 60;
+		}
+	}
+	if (seconds != windowSeconds) {
+		windowSeconds = seconds;
+		ResetStatistics();
+		isPlotValid = false;
+		UpdateDisplay();
+	}
+}
+
+void WindHistory::SetNightMode(bool mode) {
+	if (mode != nightMode) {
+		nightMode = mode;
+		isPlotValid = false;
+		UpdateDisplay();
+	}
+}
+
+// Only the labels change, the traces remain scaled in knots
+void WindHistory::SetSpeedUnits(const wxString& units, double conversion) {
+	if ((units != speedUnits) || (conversion != speedConversion)) {
+		speedUnits = units;
+		speedConversion = conversion;
+		UpdateDisplay();
+	}
+}
+
+void WindHistory::AddSample(double trueWindDirection, double trueWindSpeed) {
+	if ((std::isnan(trueWindDirection)) || (std::isnan(trueWindSpeed))) {
+		return;
+	}
+
+	// Unwrap the direction, so that a shift through north is continuous
+	if (std::isnan(previousDirection)) {
+		unwrappedDirection = trueWindDirection;
+	}
+	else {
+		unwrappedDirection += remainder(trueWindDirection - previousDirection, 360.0);
+	}
+	previousDirection = trueWindDirection;
+
+	WindSample sample;
+	sample.direction = unwrappedDirection;
+	sample.speed = trueWindSpeed;
+
+	// Statistics first, as the sample leaving the window may be the one about to be overwritten
+	AddToStatistics(sample);
+
+	history[historyNext] = sample;
+	historyNext = (historyNext + 1) % HISTORY_SIZE;
+	if (historyCount < HISTORY_SIZE) {
+		historyCount++;
+	}
+	sampleNumber++;
+
+	AccumulateColumn(sample);
+
+	if ((isPlotValid) && (!IsWithinScale(sample))) {
+		isPlotValid = false;
+	}
+
+	// Draw the column once complete, the only drawing into the plot for each sample
+	if ((sampleNumber % secondsPerColumn) == 0) {
+		if ((isPlotValid) && (plot.IsOk())) {
+			wxMemoryDC dc(plot);
+			DrawColumn(dc, nextColumn);
+			dc.SelectObject(wxNullBitmap);
+			nextColumn = (nextColumn + 1) % columnCount;
+		}
+		ResetColumn();
+	}
+
+	UpdateDisplay();
+}
+
+void WindHistory::ResetStatistics(void) {
+	windowCount = 0;
+	sumDirection = 0.0;
+	sumSpeed = 0.0;
+	minimumDirections.clear();
+	maximumDirections.clear();
+	maximumSpeeds.clear();
+
+	// Replay the samples within the window, oldest first, as if they were being added
+	int count = std::min(historyCount, windowSeconds);
+	long long number = sampleNumber - count;
+	for (int age = count - 1; age >= 0; age--) {
+		const WindSample& sample = GetSample(age);
+		windowCount++;
+		sumDirection += sample.direction;
+		sumSpeed += sample.speed;
+		while ((!minimumDirections.empty()) && (minimumDirections.back().second >= sample.direction)) {
+			minimumDirections.pop_back();
+		}
+		minimumDirections.push_back(std::make_pair(number, sample.direction));
+		while ((!maximumDirections.empty()) && (maximumDirections.back().second <= sample.direction)) {
+			maximumDirections.pop_back();
+		}
+		maximumDirections.push_back(std::make_pair(number, sample.direction));
+		while ((!maximumSpeeds.empty()) && (maximumSpeeds.back().second <= sample.speed)) {
+			maximumSpeeds.pop_back();
+		}
+		maximumSpeeds.push_back(std::make_pair(number, sample.speed));
+		number++;
+	}
+}
+
+void WindHistory::AddToStatistics(const WindSample& sample) {
+	// Called before the sample is added to the history
+	if (windowCount == windowSeconds) {
+		const WindSample& leaving = GetSample(windowSeconds - 1);
+		sumDirection -= leaving.direction;
+		sumSpeed -= leaving.speed;
+	}
+	else {
+		windowCount++;
+	}
+	sumDirection += sample.direction;
+	sumSpeed += sample.speed;
+
+	// Each queue is kept in order of value, so the extreme is at the front
+	while ((!minimumDirections.empty()) && (minimumDirections.back().second >= sample.direction)) {
+		minimumDirections.pop_back();
+	}
+	minimumDirections.push_back(std::make_pair(sampleNumber, sample.direction));
+	while ((!maximumDirections.empty()) && (maximumDirections.back().second <= sample.direction)) {
+		maximumDirections.pop_back();
+	}
+	maximumDirections.push_back(std::make_pair(sampleNumber, sample.direction));
+	while ((!maximumSpeeds.empty()) && (maximumSpeeds.back().second <= sample.speed)) {
+		maximumSpeeds.pop_back();
+	}
+	maximumSpeeds.push_back(std::make_pair(sampleNumber, sample.speed));
+
+	long long oldest = sampleNumber - windowSeconds;
+	while (minimumDirections.front().first <= oldest) {
+		minimumDirections.pop_front();
+	}
+	while (maximumDirections.front().first <= oldest) {
+		maximumDirections.pop_front();
+	}
+	while (maximumSpeeds.front().first <= oldest) {
+		maximumSpeeds.pop_front();
+	}
+}
+
+const WindHistory::WindSample& WindHistory::GetSample(int age) const {
+	return history[(historyNext - 1 - age + (2 * HISTORY_SIZE)) % HISTORY_SIZE];
+}
+
+void WindHistory::ResetColumn(void) {
+	column.samples = 0;
+	column.minimumDirection = 0.0;
+	column.maximumDirection = 0.0;
+	column.minimumSpeed = 0.0;
+	column.maximumSpeed = 0.0;
+	column.lastDirection = 0.0;
+	column.lastSpeed = 0.0;
+}
+
+void WindHistory::AccumulateColumn(const WindSample& sample) {
+	if (column.samples == 0) {
+		column.minimumDirection = sample.direction;
+		column.maximumDirection = sample.direction;
+		column.minimumSpeed = sample.speed;
+		column.maximumSpeed = sample.speed;
+	}
+	else {
+		column.minimumDirection = std::min(column.minimumDirection, sample.direction);
+		column.maximumDirection = std::max(column.maximumDirection, sample.direction);
+		column.minimumSpeed = std::min(column.minimumSpeed, sample.speed);
+		column.maximumSpeed = std::max(column.maximumSpeed, sample.speed);
+	}
+	column.lastDirection = sample.direction;
+	column.lastSpeed = sample.speed;
+	column.samples++;
+}
+
+// Draw the accumulated column into the plot, clearing whatever it replaces.
+// The vertical line covers the extremes within the column, the sloping line joins it to the previous column
+void WindHistory::DrawColumn(wxDC& dc, int index) {
+	int x = index * columnWidth;
+	int middle = x + (columnWidth / 2);
+
+	dc.SetPen(*wxTRANSPARENT_PEN);
+	dc.SetBrush(wxBrush(GetBackgroundColour()));
+	dc.DrawRectangle(x, 0, columnWidth, plotSize.GetHeight());
+
+	// Grid lines are drawn a column at a time along with the traces
+	dc.SetPen(wxPen(nightMode ? wxColour(60, 0, 0) : wxColour(210, 210, 210)));
+	dc.DrawLine(x, directionHeight / 2, x + columnWidth, directionHeight / 2);
+	dc.DrawLine(x, directionHeight, x + columnWidth, directionHeight);
+	for (double speed = SPEED_STEP; speed < speedMaximum; speed += SPEED_STEP) {
+		int y = SpeedToY(speed);
+		dc.DrawLine(x, y, x + columnWidth, y);
+	}
+
+	if (column.samples == 0) {
+		hasPreviousColumn = false;
+		return;
+	}
+
+	dc.SetPen(wxPen(GetDirectionColour()));
+	if (hasPreviousColumn) {
+		dc.DrawLine(x, DirectionToY(previousColumnDirection), middle, DirectionToY(column.lastDirection));
+	}
+	dc.DrawLine(middle, DirectionToY(column.minimumDirection), middle, DirectionToY(column.maximumDirection) - 1);
+
+	dc.SetPen(wxPen(GetSpeedColour()));
+	if (hasPreviousColumn) {
+		dc.DrawLine(x, SpeedToY(previousColumnSpeed), middle, SpeedToY(column.lastSpeed));
+	}
+	dc.DrawLine(middle, SpeedToY(column.minimumSpeed), middle, SpeedToY(column.maximumSpeed) - 1);
+
+	hasPreviousColumn = true;
+	previousColumnDirection = column.lastDirection;
+	previousColumnSpeed = column.lastSpeed;
+}
+
+// Choose the scales and columns for the current size and window, and draw the plot from the history
+void WindHistory::RebuildPlot(void) {
+	wxSize clientSize = GetClientSize();
+	labelHeight = (2 * GetCharHeight()) + PANEL_MARGIN;
+	plotSize = wxSize(std::max(clientSize.GetWidth(), 1), std::max(clientSize.GetHeight() - labelHeight, 1));
+	directionHeight = (plotSize.GetHeight() * 3) / 5;
+	plotNightMode = nightMode;
+
+	// At least a pixel per column, several seconds to a column for long windows or narrow panes
+	secondsPerColumn = std::max(1, (windowSeconds + plotSize.GetWidth() - 1) / plotSize.GetWidth());
+	columnCount = (windowSeconds + secondsPerColumn - 1) / secondsPerColumn;
+	columnWidth = std::max(1, plotSize.GetWidth() / columnCount);
+
+	// Direction centred on the mean, wide enough for the extremes with a little to spare
+	directionCentre = 0.0;
+	directionRange = MINIMUM_DIRECTION_RANGE;
+	speedMaximum = MINIMUM_SPEED;
+	if (windowCount > 0) {
+		directionCentre = round(sumDirection / windowCount);
+		double deviation = std::max(directionCentre - minimumDirections.front().second,
+			maximumDirections.front().second - directionCentre);
+		directionRange = std::max(MINIMUM_DIRECTION_RANGE, ceil((deviation + (DIRECTION_STEP / 2.0)) / DIRECTION_STEP) * DIRECTION_STEP);
+		speedMaximum = std::max(MINIMUM_SPEED, ceil((maximumSpeeds.front().second + 1.0) / SPEED_STEP) * SPEED_STEP);
+	}
+
+	if (nightMode) {
+		SetBackgroundColour(*wxBLACK);
+	}
+	else {
+		SetBackgroundColour(*wxWHITE);
+	}
+
+	plot.Create(plotSize.GetWidth(), plotSize.GetHeight());
+	wxMemoryDC dc(plot);
+	dc.SetBackground(wxBrush(GetBackgroundColour()));
+	dc.Clear();
+
+	// Draw every completed column within the window and the history, then leave the current column accumulating
+	long long completedColumns = sampleNumber / secondsPerColumn;
+	long long oldestColumn = ((sampleNumber - historyCount) + secondsPerColumn - 1) / secondsPerColumn;
+	long long firstColumn = std::max(completedColumns - columnCount, oldestColumn);
+
+	nextColumn = 0;
+	hasPreviousColumn = false;
+	ResetColumn();
+	for (long long c = firstColumn; c < completedColumns; c++) {
+		for (long long n = c * secondsPerColumn; n < (c + 1) * secondsPerColumn; n++) {
+			AccumulateColumn(GetSample(static_cast<int>(sampleNumber - 1 - n)));
+		}
+		DrawColumn(dc, nextColumn);
+		nextColumn = (nextColumn + 1) % columnCount;
+		ResetColumn();
+	}
+	for (long long n = completedColumns * secondsPerColumn; n < sampleNumber; n++) {
+		AccumulateColumn(GetSample(static_cast<int>(sampleNumber - 1 - n)));
+	}
+
+	dc.SelectObject(wxNullBitmap);
+	isPlotValid = true;
+}
+
+int WindHistory::DirectionToY(double direction) const {
+	// Veers (clockwise shifts) upwards
+	double fraction = (directionCentre + directionRange - direction) / (2.0 * directionRange);
+	return PANEL_MARGIN + static_cast<int>(round(fraction * (directionHeight - (2 * PANEL_MARGIN))));
+}
+
+int WindHistory::SpeedToY(double speed) const {
+	int top = directionHeight + PANEL_MARGIN;
+	int height = plotSize.GetHeight() - top - PANEL_MARGIN;
+	return top + static_cast<int>(round((1.0 - (speed / speedMaximum)) * height));
+}
+
+bool WindHistory::IsWithinScale(const WindSample& sample) const {
+	return (fabs(sample.direction - directionCentre) <= directionRange) && (sample.speed <= speedMaximum);
+}
+
+wxColour WindHistory::GetDirectionColour(void) const {
+	return nightMode ? wxColour(200, 0, 0) : wxColour(0, 102, 255);
+}
+
+wxColour WindHistory::GetSpeedColour(void) const {
+	return nightMode ? wxColour(130, 0, 0) : wxColour(0, 150, 60);
+}
+
+wxColour WindHistory::GetTextColour(void) const {
+	return nightMode ? wxColour(200, 0, 0) : *wxBLACK;
+}
+
+void WindHistory::UpdateDisplay(void) {
+	// No repaint work at all if the chart can't be seen
+	wxTopLevelWindow* topLevel = wxDynamicCast(wxGetTopLevelParent(this), wxTopLevelWindow);
+	if ((!IsShownOnScreen()) || ((topLevel != nullptr) && (topLevel->IsIconized()))) {
+		return;
+	}
+	Refresh();
+}
+
+void WindHistory::OnPaint(wxPaintEvent& evt) {
+	// To avoid flickering....
+	wxAutoBufferedPaintDC dc(this);
+
+	if (!dc.IsOk()) {
+		return;
+	}
+
+	wxSize clientSize = GetClientSize();
+	if ((clientSize.GetWidth() <= 0) || (clientSize.GetHeight() <= 0)) {
+		return;
+	}
+
+	if ((!isPlotValid) || (!plot.IsOk()) || (nightMode != plotNightMode) ||
+		(clientSize.GetWidth() != plotSize.GetWidth()) || (clientSize.GetHeight() != plotSize.GetHeight() + labelHeight)) {
+		RebuildPlot();
+	}
+
+	dc.SetBackground(wxBrush(GetBackgroundColour()));
+	dc.Clear();
+
+	// Scrolling is just where the circular plot is split, the oldest column is the next to be drawn.
+	// Right aligned, so that the most recent sample is always against the right edge
+	int left = plotSize.GetWidth() - (columnCount * columnWidth);
+	int split = nextColumn * columnWidth;
+	int older = (columnCount * columnWidth) - split;
+	wxMemoryDC plotDC(plot);
+	dc.Blit(left, labelHeight, older, plotSize.GetHeight(), &plotDC, split, 0);
+	dc.Blit(left + older, labelHeight, split, plotSize.GetHeight(), &plotDC, 0, 0);
+	plotDC.SelectObject(wxNullBitmap);
+
+	dc.SetTextForeground(GetTextColour());
+	dc.SetFont(GetFont());
+
+	// Mean direction and the shift extremes over the window
+	if (windowCount > 0) {
+		double mean = sumDirection / windowCount;
+		double minimum = minimumDirections.front().second;
+		double maximum = maximumDirections.front().second;
+
+		dc.SetPen(wxPen(GetTextColour(), 1, wxPENSTYLE_SHORT_DASH));
+		int y = labelHeight + DirectionToY(mean);
+		dc.DrawLine(left, y, plotSize.GetWidth(), y);
+		dc.SetPen(wxPen(GetDirectionColour(), 1, wxPENSTYLE_DOT));
+		y = labelHeight + DirectionToY(minimum);
+		dc.DrawLine(left, y, plotSize.GetWidth(), y);
+		y = labelHeight + DirectionToY(maximum);
+		dc.DrawLine(left, y, plotSize.GetWidth(), y);
+
+		int current = static_cast<int>(round(fmod(fmod(unwrappedDirection, 360.0) + 360.0, 360.0))) % 360;
+		int average = static_cast<int>(round(fmod(fmod(mean, 360.0) + 360.0, 360.0))) % 360;
+		dc.DrawText(wxString::Format("TWD %03d  Mean %03d  Left %d  Right %d",
+			current, average, static_cast<int>(round(mean - minimum)), static_cast<int>(round(maximum - mean))),
+			PANEL_MARGIN, 0);
+		dc.DrawText(wxString::Format("TWS %.1f %s  Mean %.1f %s  Max %.1f %s  (%d min)",
+			GetSample(0).speed * speedConversion, speedUnits, (sumSpeed / windowCount) * speedConversion, speedUnits,
+			maximumSpeeds.front().second * speedConversion, speedUnits, GetWindow()),
+			PANEL_MARGIN, GetCharHeight());
+	}
+	else {
+		dc.DrawText(wxString::Format("No wind data  (%d min)", GetWindow()), PANEL_MARGIN, 0);
+	}
+
+	// Scale limits, the direction scale in degrees true
+	int top = static_cast<int>(round(fmod(fmod(directionCentre + directionRange, 360.0) + 360.0, 360.0))) % 360;
+	int bottom = static_cast<int>(round(fmod(fmod(directionCentre - directionRange, 360.0) + 360.0, 360.0))) % 360;
+	dc.DrawText(wxString::Format("%03d", top), PANEL_MARGIN, labelHeight);
+	dc.DrawText(wxString::Format("%03d", bottom), PANEL_MARGIN, labelHeight + directionHeight - GetCharHeight());
+	dc.DrawText(wxString::Format("%.0f %s", speedMaximum * speedConversion, speedUnits), PANEL_MARGIN, labelHeight + directionHeight);
+}
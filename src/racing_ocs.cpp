@@ -0,0 +1,283 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Predictive over early (OCS) engine
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_ocs.h"
+
+#include <algorithm>
+#include <limits>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Metres per degree of latitude, 1' = 1NM
+const double METRES_PER_DEGREE = 1852.0 * 60.0;
+
+// Default one sigma GPS position error (metres)
+const double DEFAULT_POSITION_UNCERTAINTY = 2.5;
+
+// Default one sigma closing speed noise (metres/second) when there is too little history
+const double DEFAULT_SPEED_NOISE = 0.25;
+
+OcsPredictor::OcsPredictor() {
+	hasStartLine = false;
+	originLatitude = 0.0;
+	originLongitude = 0.0;
+	metresPerDegreeLongitude = METRES_PER_DEGREE;
+	lineEast = 0.0;
+	lineNorth = 0.0;
+	lineLength = 0.0;
+	positionUncertainty = DEFAULT_POSITION_UNCERTAINTY;
+	timeOrigin = 0;
+	Reset();
+}
+
+void OcsPredictor::Reset(void) {
+	historyCount = 0;
+	historyNext = 0;
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	prediction.isValid = false;
+	prediction.distanceToLine = nan;
+	prediction.closingSpeed = nan;
+	prediction.acceleration = nan;
+	prediction.timeToLine = nan;
+	prediction.isWithinLine = false;
+	prediction.timeToGun = nan;
+	prediction.timeToBurn = nan;
+	prediction.probabilityOver = nan;
+}
+
+// Over the length of a start line, a flat earth centred on the starboard end is accurate enough
+void OcsPredictor::SetStartLine(double starboardLatitude, double starboardLongitude, double portLatitude, double portLongitude) {
+	originLatitude = starboardLatitude;
+	originLongitude = starboardLongitude;
+	metresPerDegreeLongitude = METRES_PER_DEGREE * cos(originLatitude * M_PI / 180.0);
+	lineNorth = (portLatitude - starboardLatitude) * METRES_PER_DEGREE;
+	lineEast = (portLongitude - starboardLongitude) * metresPerDegreeLongitude;
+	lineLength = hypot(lineEast, lineNorth);
+	// Coincident marks do not define a line
+	hasStartLine = lineLength > 1.0;
+	Reset();
+}
+
+void OcsPredictor::ClearStartLine(void) {
+	hasStartLine = false;
+	Reset();
+}
+
+bool OcsPredictor::HasStartLine(void) const {
+	return hasStartLine;
+}
+
+void OcsPredictor::SetPositionUncertainty(double metres) {
+	positionUncertainty = std::max(metres, 0.1);
+}
+
+const OcsPrediction& OcsPredictor::Update(long long timeMilliseconds, double latitude, double longitude,
+	double courseOverGround, double speedOverGround, double secondsToGun) {
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+
+	prediction.isValid = hasStartLine;
+	if ((!hasStartLine) || std::isnan(latitude) || std::isnan(longitude)) {
+		return prediction;
+	}
+
+	// Position relative to the starboard end
+	double north = (latitude - originLatitude) * METRES_PER_DEGREE;
+	double east = (longitude - originLongitude) * metresPerDegreeLongitude;
+
+	// Looking at the line from the pre-start side the starboard end is on the right,
+	// so the cross product of the line and our position is positive on the pre-start side
+	prediction.distanceToLine = ((lineEast * north) - (lineNorth * east)) / lineLength;
+
+	double velocityNorth = 0.0;
+	double velocityEast = 0.0;
+	if ((!std::isnan(courseOverGround)) && (!std::isnan(speedOverGround))) {
+		velocityNorth = speedOverGround * cos(courseOverGround * M_PI / 180.0);
+		velocityEast = speedOverGround * sin(courseOverGround * M_PI / 180.0);
+	}
+	prediction.closingSpeed = -((lineEast * velocityNorth) - (lineNorth * velocityEast)) / lineLength;
+
+	// Record the closing speed, time relative to the first sample to preserve precision
+	if (historyCount == 0) {
+		timeOrigin = timeMilliseconds;
+	}
+	history[historyNext].time = (timeMilliseconds - timeOrigin) / 1000.0;
+	history[historyNext].speed = prediction.closingSpeed;
+	historyNext = (historyNext + 1) % HISTORY_SIZE;
+	if (historyCount < HISTORY_SIZE) {
+		historyCount++;
+	}
+
+	double acceleration, speedNoise, accelerationNoise;
+	if (!EstimateAcceleration(acceleration, speedNoise, accelerationNoise)) {
+		acceleration = 0.0;
+		speedNoise = DEFAULT_SPEED_NOISE;
+		accelerationNoise = 0.0;
+	}
+	prediction.acceleration = acceleration;
+
+	// Already over, there is no time to the line
+	if (prediction.distanceToLine > 0.0) {
+		prediction.timeToLine = TimeToTravel(prediction.closingSpeed, acceleration, prediction.distanceToLine);
+	}
+	else {
+		prediction.timeToLine = nan;
+	}
+
+	// Where along the line we will cross, 0 is the starboard end, 1 the port end
+	double elapsed = std::isnan(prediction.timeToLine) ? 0.0 : prediction.timeToLine;
+	double alongLine = (((east + (velocityEast * elapsed)) * lineEast) + ((north + (velocityNorth * elapsed)) * lineNorth)) / (lineLength * lineLength);
+	prediction.isWithinLine = (alongLine >= 0.0) && (alongLine <= 1.0);
+
+	prediction.timeToGun = secondsToGun;
+	if (std::isnan(secondsToGun)) {
+		prediction.timeToBurn = nan;
+		prediction.probabilityOver = nan;
+		return prediction;
+	}
+
+	// Positive if we will arrive at the line before the gun and have time to burn
+	prediction.timeToBurn = secondsToGun - prediction.timeToLine;
+
+	// Predicted distance from the line at the gun, and its uncertainty which grows with time
+	double seconds = std::max(secondsToGun, 0.0);
+	double horizon = std::min(seconds, static_cast<double>(ACCELERATION_HORIZON));
+	double distanceAtGun = prediction.distanceToLine - DistanceTravelled(prediction.closingSpeed, acceleration, seconds);
+	double variance = (positionUncertainty * positionUncertainty)
+		+ pow(speedNoise * seconds, 2)
+		+ pow(0.5 * accelerationNoise * horizon * horizon, 2);
+
+	// Probability that the distance at the gun is negative, ie. on the course side
+	prediction.probabilityOver = 0.5 * erfc(distanceAtGun / sqrt(2.0 * variance));
+
+	return prediction;
+}
+
+// Least squares fit of closing speed against time over the acceleration horizon
+bool OcsPredictor::EstimateAcceleration(double& acceleration, double& speedNoise, double& accelerationNoise) const {
+
+	if (historyCount < 3) {
+		return false;
+	}
+
+	double latest = history[(historyNext + HISTORY_SIZE - 1) % HISTORY_SIZE].time;
+	double sumTime = 0.0, sumSpeed = 0.0;
+	int count = 0;
+	for (int i = 0; i < historyCount; i++) {
+		const SpeedSample& sample = history[i];
+		if ((latest - sample.time) <= ACCELERATION_HORIZON) {
+			sumTime += sample.time;
+			sumSpeed += sample.speed;
+			count++;
+		}
+	}
+	if (count < 3) {
+		return false;
+	}
+
+	double meanTime = sumTime / count;
+	double meanSpeed = sumSpeed / count;
+	double sumTimeSquared = 0.0, sumProduct = 0.0;
+	for (int i = 0; i < historyCount; i++) {
+		const SpeedSample& sample = history[i];
+		if ((latest - sample.time) <= ACCELERATION_HORIZON) {
+			sumTimeSquared += (sample.time - meanTime) * (sample.time - meanTime);
+			sumProduct += (sample.time - meanTime) * (sample.speed - meanSpeed);
+		}
+	}
+	// Need at least a second of history
+	if (sumTimeSquared < (count / 4.0)) {
+		return false;
+	}
+
+	acceleration = sumProduct / sumTimeSquared;
+
+	// Residuals give the noise in the speed, and hence the standard error of the acceleration
+	double sumResiduals = 0.0;
+	for (int i = 0; i < historyCount; i++) {
+		const SpeedSample& sample = history[i];
+		if ((latest - sample.time) <= ACCELERATION_HORIZON) {
+			double residual = sample.speed - (meanSpeed + (acceleration * (sample.time - meanTime)));
+			sumResiduals += residual * residual;
+		}
+	}
+	speedNoise = std::max(sqrt(sumResiduals / (count - 2)), 0.05);
+	accelerationNoise = speedNoise / sqrt(sumTimeSquared);
+
+	// A yacht does not accelerate at more than a fraction of g
+	acceleration = std::min(std::max(acceleration, -2.0), 2.0);
+	return true;
+}
+
+// Acceleration applies over the horizon, thereafter the speed remains constant
+double OcsPredictor::DistanceTravelled(double speed, double acceleration, double seconds) {
+	double horizon = std::min(seconds, static_cast<double>(ACCELERATION_HORIZON));
+	double distance = (speed * horizon) + (0.5 * acceleration * horizon * horizon);
+	if (seconds > horizon) {
+		distance += (speed + (acceleration * horizon)) * (seconds - horizon);
+	}
+	return distance;
+}
+
+double OcsPredictor::TimeToTravel(double speed, double acceleration, double distance) {
+
+	const double horizon = static_cast<double>(ACCELERATION_HORIZON);
+
+	// Solve 1/2at^2 + vt - d = 0 for the first positive root within the horizon
+	if (fabs(acceleration) < 1e-3) {
+		if (speed > 0.0) {
+			return distance / speed;
+		}
+	}
+	else {
+		double discriminant = (speed * speed) + (2.0 * acceleration * distance);
+		if (discriminant >= 0.0) {
+			double root1 = (-speed + sqrt(discriminant)) / acceleration;
+			double root2 = (-speed - sqrt(discriminant)) / acceleration;
+			double first = std::numeric_limits<double>::infinity();
+			if (root1 > 0.0) {
+				first = root1;
+			}
+			if ((root2 > 0.0) && (root2 < first)) {
+				first = root2;
+			}
+			if (first <= horizon) {
+				return first;
+			}
+		}
+		// Beyond the horizon continue at the speed reached
+		double finalSpeed = speed + (acceleration * horizon);
+		if (finalSpeed > 0.0) {
+			double remaining = distance - DistanceTravelled(speed, acceleration, horizon);
+			if (remaining >= 0.0) {
+				return horizon + (remaining / finalSpeed);
+			}
+		}
+	}
+	return std::numeric_limits<double>::quiet_NaN();
+}
@@ -0,0 +1,671 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Persistent per canvas chart overlay
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_overlay.h"
+
+#include <algorithm>
+#include <chrono>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#if defined(ocpnUSE_GL)
+#include <wx/glcanvas.h>
+#endif
+
+// Circles are approximated by this many segments
+const int CIRCLE_SEGMENTS = 72;
+
+// Sizes below are in logical pixels, and are multiplied by the display scale when the geometry is generated
+
+// Width of the performance track
+const double TRACK_WIDTH = 3.0;
+
+// Width of the start line and of the circle around the favoured end
+const double START_LINE_WIDTH = 2.0;
+
+// Radius of the circle around the favoured end, and the offset of the bias label from it
+const double FAVOURED_RADIUS = 12.0;
+const double LABEL_OFFSET = 14.0;
+
+// Dashes of the line square to the wind
+const double DASH_LENGTH = 6.0;
+const double GAP_LENGTH = 4.0;
+
+// Wind arrows start this far from their centre, the true wind arrow is this long
+const double ARROW_INNER_RADIUS = 10.0;
+const double ARROW_OUTER_RADIUS = 70.0;
+
+// Generous extent of the bias label, so it is not culled while partially visible
+const double LABEL_WIDTH = 150.0;
+const double LABEL_HEIGHT = 30.0;
+
+// Both NaN, or equal
+static bool IsSameValue(double value1, double value2) {
+	return (value1 == value2) || (isnan(value1) && isnan(value2));
+}
+
+OverlayVertexBuffer::OverlayVertexBuffer() {
+	// Sufficient for the current overlay without reallocating
+	triangles.reserve(1024);
+	lines.reserve(1024);
+}
+
+void OverlayVertexBuffer::Clear(void) {
+	triangles.clear();
+	lines.clear();
+}
+
+OverlayVertex OverlayVertexBuffer::MakeVertex(double x, double y, const wxColour& colour) {
+	OverlayVertex vertex;
+	vertex.x = static_cast<float>(x);
+	vertex.y = static_cast<float>(y);
+	vertex.red = colour.Red();
+	vertex.green = colour.Green();
+	vertex.blue = colour.Blue();
+	vertex.alpha = colour.Alpha();
+	return vertex;
+}
+
+void OverlayVertexBuffer::AddLine(double x1, double y1, double x2, double y2, const wxColour& colour, double width) {
+	AddGradientLine(x1, y1, colour, x2, y2, colour, width);
+}
+
+void OverlayVertexBuffer::AddGradientLine(double x1, double y1, const wxColour& colour1, double x2, double y2, const wxColour& colour2, double width) {
+	if (width <= 1.0) {
+		lines.push_back(MakeVertex(x1, y1, colour1));
+		lines.push_back(MakeVertex(x2, y2, colour2));
+		return;
+	}
+
+	// A wide line is a quad, offset either side of the line by half the width
+	double length = hypot(x2 - x1, y2 - y1);
+	if (length == 0.0) {
+		return;
+	}
+	double dx = (y1 - y2) / length * width / 2.0;
+	double dy = (x2 - x1) / length * width / 2.0;
+	triangles.push_back(MakeVertex(x1 + dx, y1 + dy, colour1));
+	triangles.push_back(MakeVertex(x2 + dx, y2 + dy, colour2));
+	triangles.push_back(MakeVertex(x2 - dx, y2 - dy, colour2));
+	triangles.push_back(MakeVertex(x1 + dx, y1 + dy, colour1));
+	triangles.push_back(MakeVertex(x2 - dx, y2 - dy, colour2));
+	triangles.push_back(MakeVertex(x1 - dx, y1 - dy, colour1));
+}
+
+void OverlayVertexBuffer::AddDashedLine(double x1, double y1, double x2, double y2, const wxColour& colour, double dashLength, double gapLength, double width) {
+	double length = hypot(x2 - x1, y2 - y1);
+	if ((length == 0.0) || (dashLength <= 0.0)) {
+		return;
+	}
+	double unitX = (x2 - x1) / length;
+	double unitY = (y2 - y1) / length;
+	for (double distance = 0.0; distance < length; distance += dashLength + gapLength) {
+		double dashEnd = distance + dashLength < length ? distance + dashLength : length;
+		AddLine(x1 + (unitX * distance), y1 + (unitY * distance), x1 + (unitX * dashEnd), y1 + (unitY * dashEnd), colour, width);
+	}
+}
+
+void OverlayVertexBuffer::AddTriangle(double x1, double y1, double x2, double y2, double x3, double y3, const wxColour& colour) {
+	triangles.push_back(MakeVertex(x1, y1, colour));
+	triangles.push_back(MakeVertex(x2, y2, colour));
+	triangles.push_back(MakeVertex(x3, y3, colour));
+}
+
+void OverlayVertexBuffer::AddPolygon(int count, const wxPoint* points, const wxColour& colour) {
+	// A convex polygon is a fan of triangles from the first point
+	for (int i = 1; i < count - 1; i++) {
+		AddTriangle(points[0].x, points[0].y, points[i].x, points[i].y, points[i + 1].x, points[i + 1].y, colour);
+	}
+}
+
+void OverlayVertexBuffer::AddLines(int count, const wxPoint* points, const wxColour& colour, double width) {
+	for (int i = 0; i < count - 1; i++) {
+		AddLine(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y, colour, width);
+	}
+}
+
+void OverlayVertexBuffer::AddCircle(double x, double y, double radius, const wxColour& colour, double width) {
+	double previousX = x + radius;
+	double previousY = y;
+	for (int i = 1; i <= CIRCLE_SEGMENTS; i++) {
+		double angle = 2.0 * M_PI * i / CIRCLE_SEGMENTS;
+		double nextX = x + (radius * cos(angle));
+		double nextY = y + (radius * sin(angle));
+		AddLine(previousX, previousY, nextX, nextY, colour, width);
+		previousX = nextX;
+		previousY = nextY;
+	}
+}
+
+void OverlayVertexBuffer::Draw(piDC* dc) const {
+
+#if defined(ocpnUSE_GL) && !defined(USE_ANDROID_GLES2)
+
+	// Fixed function client side arrays, available from OpenGL 1.1 & OpenGL ES 1.0, including software Mesa.
+	// The vertices are only rebuilt when the geometry changes, the driver copies them when they are drawn.
+	// OpenCPN's state is restored afterwards, for whatever it draws next
+	GLboolean wasBlend = glIsEnabled(GL_BLEND);
+	GLboolean wasLineSmooth = glIsEnabled(GL_LINE_SMOOTH);
+	GLboolean wasVertexArray = glIsEnabled(GL_VERTEX_ARRAY);
+	GLboolean wasColorArray = glIsEnabled(GL_COLOR_ARRAY);
+	GLint blendSource;
+	GLint blendDestination;
+	GLfloat lineWidth;
+	glGetIntegerv(GL_BLEND_SRC, &blendSource);
+	glGetIntegerv(GL_BLEND_DST, &blendDestination);
+	glGetFloatv(GL_LINE_WIDTH, &lineWidth);
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+
+	if (!triangles.empty()) {
+		glVertexPointer(2, GL_FLOAT, sizeof(OverlayVertex), &triangles[0].x);
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(OverlayVertex), &triangles[0].red);
+		glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(triangles.size()));
+	}
+
+	if (!lines.empty()) {
+		// Only hairlines are in this batch, anything scaled wider than a pixel is drawn as triangles
+		glEnable(GL_LINE_SMOOTH);
+		glLineWidth(1.0f);
+		glVertexPointer(2, GL_FLOAT, sizeof(OverlayVertex), &lines[0].x);
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(OverlayVertex), &lines[0].red);
+		glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(lines.size()));
+	}
+
+	if (!wasColorArray) {
+		glDisableClientState(GL_COLOR_ARRAY);
+	}
+	if (!wasVertexArray) {
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+	glLineWidth(lineWidth);
+	glBlendFunc(static_cast<GLenum>(blendSource), static_cast<GLenum>(blendDestination));
+	if (!wasLineSmooth) {
+		glDisable(GL_LINE_SMOOTH);
+	}
+	if (!wasBlend) {
+		glDisable(GL_BLEND);
+	}
+
+#else
+
+	// OpenGL ES 2 has no fixed function pipeline, so leave it to piDC's shaders
+	for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+		wxColour colour(triangles[i].red, triangles[i].green, triangles[i].blue, triangles[i].alpha);
+		wxPoint triangle[3];
+		for (int j = 0; j < 3; j++) {
+			triangle[j] = wxPoint(wxRound(triangles[i + j].x), wxRound(triangles[i + j].y));
+		}
+		dc->SetPen(wxPen(colour, 1, wxPENSTYLE_SOLID));
+		dc->SetBrush(wxBrush(colour));
+		dc->DrawPolygon(3, triangle);
+	}
+	for (size_t i = 0; i + 1 < lines.size(); i += 2) {
+		dc->SetPen(wxPen(wxColour(lines[i].red, lines[i].green, lines[i].blue, lines[i].alpha), 1, wxPENSTYLE_SOLID));
+		dc->DrawLine(wxRound(lines[i].x), wxRound(lines[i].y), wxRound(lines[i + 1].x), wxRound(lines[i + 1].y), true);
+	}
+
+#endif
+}
+
+CanvasOverlay::CanvasOverlay() {
+	graphics = nullptr;
+	isGeometryValid = false;
+	geometryRevision = 0;
+	vertexBufferRevision = 0;
+	renderer = nullptr;
+	pathRevision = 0;
+	frameCount = 0;
+	totalFrameTime = 0.0;
+	labelFontScale = 0.0;
+
+	geometry.hasStartLine = false;
+	geometry.hasFavouredEnd = false;
+	geometry.hasLabel = false;
+	geometry.hasTrueWindArrow = false;
+	geometry.hasRing = false;
+	geometry.ringRadius = 0;
+	geometry.hasApparentWindArrow = false;
+	geometry.hasTrack = false;
+	geometry.width = 0;
+	geometry.height = 0;
+	geometry.scale = 1.0;
+}
+
+CanvasOverlay::~CanvasOverlay() {
+	if (graphics != nullptr) {
+		delete graphics;
+	}
+}
+
+double CanvasOverlay::GetAverageFrameTime(void) const {
+	return frameCount > 0 ? totalFrameTime / frameCount : 0.0;
+}
+
+// Frame time counter, so the cost of the overlay can be checked. Reported when the plugin is unloaded
+void CanvasOverlay::CountFrame(long long microseconds) {
+	totalFrameTime += static_cast<double>(microseconds);
+	frameCount++;
+}
+
+void CanvasOverlay::RenderGL(wxGLContext* context, PlugIn_ViewPort* vp, const OverlayInputs& inputs) {
+
+	std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+	// Reuse the drawing context, unless OpenCPN has recreated its GL context
+	if ((graphics == nullptr) || (!graphics->CheckContext(context))) {
+		if (graphics != nullptr) {
+			delete graphics;
+		}
+		graphics = new RacingGraphics(context);
+	}
+
+	// The display scale can change if the window moves to another monitor
+	graphics->SetContentScaleFactor(RacingGraphics::GetDisplayScaleFactor());
+	UpdateGeometry(vp, inputs, graphics->GetContentScaleFactor());
+
+	if (IsVisible(geometry.boundingBox, vp)) {
+
+		if (vertexBufferRevision != geometryRevision) {
+			BuildVertexBuffer();
+		}
+
+		// Everything except the text in a single batch
+		vertexBuffer.Draw(graphics);
+
+		if (geometry.hasLabel) {
+			UpdateLabelFont(geometry.scale);
+			graphics->SetFont(labelFont);
+			graphics->SetTextForeground(*wxBLACK);
+			graphics->DrawText(inputs.biasLabel, geometry.labelPoint.x, geometry.labelPoint.y);
+		}
+	}
+
+	CountFrame(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart).count());
+}
+
+void CanvasOverlay::RenderDC(wxDC& dc, PlugIn_ViewPort* vp, const OverlayInputs& inputs) {
+
+	std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+	// A device context may already be scaled from logical to physical pixels, eg. on macOS
+	UpdateGeometry(vp, inputs, RacingGraphics::GetDisplayScaleFactor() / dc.GetContentScaleFactor());
+	int trackWidth = std::max(1, wxRound(TRACK_WIDTH * geometry.scale));
+	int lineWidth = std::max(1, wxRound(START_LINE_WIDTH * geometry.scale));
+	int hairlineWidth = std::max(1, wxRound(geometry.scale));
+
+	if (IsVisible(geometry.boundingBox, vp)) {
+
+		// The track is beneath everything else, drawn in runs of the same colour to minimise pen changes
+		if (geometry.hasTrack) {
+			const std::vector<float>& efficiencies = inputs.track->GetEfficiencies();
+			const std::vector<unsigned int>& indices = geometry.trackIndices;
+			wxColour runColour;
+			trackRun.clear();
+			for (size_t i = 1; i < indices.size(); i++) {
+				unsigned int previous = indices[i - 1];
+				unsigned int current = indices[i];
+				wxColour colour = GetEfficiencyColour(efficiencies[current]);
+				bool isCulled = IsSegmentCulled(geometry.trackX[previous], geometry.trackY[previous],
+					geometry.trackX[current], geometry.trackY[current], geometry.width, geometry.height);
+				if ((!trackRun.empty()) && ((isCulled) || (colour != runColour))) {
+					dc.SetPen(wxPen(runColour, trackWidth, wxPENSTYLE_SOLID));
+					dc.DrawLines(static_cast<int>(trackRun.size()), trackRun.data());
+					trackRun.clear();
+				}
+				if (!isCulled) {
+					if (trackRun.empty()) {
+						trackRun.push_back(wxPoint(wxRound(geometry.trackX[previous]), wxRound(geometry.trackY[previous])));
+					}
+					trackRun.push_back(wxPoint(wxRound(geometry.trackX[current]), wxRound(geometry.trackY[current])));
+					runColour = colour;
+				}
+			}
+			if (!trackRun.empty()) {
+				dc.SetPen(wxPen(runColour, trackWidth, wxPENSTYLE_SOLID));
+				dc.DrawLines(static_cast<int>(trackRun.size()), trackRun.data());
+			}
+		}
+
+		if (geometry.hasStartLine) {
+			dc.SetPen(wxPen(inputs.startLineColour, lineWidth, wxPENSTYLE_SOLID));
+			dc.DrawLine(geometry.starboardPoint, geometry.portPoint);
+
+			// Indicate the favoured end
+			if (geometry.hasFavouredEnd) {
+				dc.SetPen(wxPen(*wxGREEN, hairlineWidth, wxPENSTYLE_SHORT_DASH));
+				dc.DrawLine(geometry.unfavouredPoint, geometry.squarePoint);
+				dc.SetPen(wxPen(*wxGREEN, lineWidth, wxPENSTYLE_SOLID));
+				dc.SetBrush(*wxTRANSPARENT_BRUSH);
+				dc.DrawCircle(geometry.favouredPoint, wxRound(FAVOURED_RADIUS * geometry.scale));
+			}
+			if (geometry.hasLabel) {
+				UpdateLabelFont(geometry.scale);
+				dc.SetFont(labelFont);
+				dc.SetTextForeground(*wxBLACK);
+				dc.DrawText(inputs.biasLabel, geometry.labelPoint);
+			}
+		}
+
+		if (geometry.hasRing) {
+			// Use a graphics context for the alpha channel and gradient. OpenCPN does not always
+			// draw on a wxMemoryDC, and the context must be deleted once the frame is drawn.
+			wxGraphicsContext* context = wxGraphicsContext::CreateFromUnknownDC(dc);
+			if (context != nullptr) {
+				if ((context->GetRenderer() != renderer) || (pathRevision != geometryRevision)) {
+					BuildPaths(context);
+				}
+
+				// Draw a transparent circle around the boat, the radius equal to the heading predictor length
+				context->SetBrush(ringBrush);
+				context->FillPath(ringPath);
+
+				// Draw apparent wind angle centred around the boat
+				if (geometry.hasApparentWindArrow) {
+					context->SetBrush(apparentWindBrush);
+					context->SetPen(wxPen(wxColour(255, 153, 51), hairlineWidth, wxPENSTYLE_SOLID));
+					context->DrawPath(apparentWindPath);
+				}
+
+				delete context;
+			}
+		}
+	}
+
+	CountFrame(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frameStart).count());
+}
+
+void CanvasOverlay::UpdateGeometry(PlugIn_ViewPort* vp, const OverlayInputs& inputs, double scale) {
+
+	bool isViewportChanged = projection.Update(vp);
+	if ((isGeometryValid) && (!isViewportChanged) && (scale == geometry.scale) && (IsSameInputs(inputs, geometryInputs))) {
+		return;
+	}
+
+	geometry.hasStartLine = (inputs.showStartLine) && (inputs.hasStartLine);
+	geometry.hasFavouredEnd = false;
+	geometry.hasLabel = false;
+	geometry.hasTrueWindArrow = false;
+	geometry.hasRing = inputs.showWindAngles;
+	geometry.hasApparentWindArrow = false;
+	geometry.hasTrack = (inputs.showTrack) && (inputs.track != nullptr) && (inputs.track->GetPoints().Size() > 1);
+	geometry.boundingBox = wxRect();
+	geometry.width = vp->pix_width;
+	geometry.height = vp->pix_height;
+	geometry.scale = scale;
+	int favouredRadius = wxRound(FAVOURED_RADIUS * scale);
+	int labelOffset = wxRound(LABEL_OFFSET * scale);
+	int arrowLength = wxRound(ARROW_OUTER_RADIUS * scale);
+
+	if (geometry.hasStartLine) {
+		geometry.starboardPoint = projection.GetPixel(inputs.starboardLatitude, inputs.starboardLongitude);
+		geometry.portPoint = projection.GetPixel(inputs.portLatitude, inputs.portLongitude);
+		geometry.boundingBox = wxRect(geometry.starboardPoint, geometry.portPoint);
+
+		// Indicate the favoured end
+		if (!inputs.biasLabel.IsEmpty()) {
+			if (inputs.favouredEnd != FAVOURED_NONE) {
+				geometry.hasFavouredEnd = true;
+				geometry.squarePoint = projection.GetPixel(inputs.squareLineLatitude, inputs.squareLineLongitude);
+				geometry.favouredPoint = inputs.favouredEnd == FAVOURED_STARBOARD ? geometry.starboardPoint : geometry.portPoint;
+				geometry.unfavouredPoint = inputs.favouredEnd == FAVOURED_STARBOARD ? geometry.portPoint : geometry.starboardPoint;
+				geometry.labelPoint = geometry.favouredPoint;
+				geometry.boundingBox.Union(wxRect(geometry.squarePoint, wxSize(1, 1)));
+				geometry.boundingBox.Union(wxRect(geometry.favouredPoint - wxPoint(favouredRadius, favouredRadius),
+					wxSize((2 * favouredRadius) + 1, (2 * favouredRadius) + 1)));
+			}
+			else {
+				// Square line, label the middle of the line
+				geometry.labelPoint.x = (geometry.starboardPoint.x + geometry.portPoint.x) / 2;
+				geometry.labelPoint.y = (geometry.starboardPoint.y + geometry.portPoint.y) / 2;
+			}
+			geometry.labelPoint.x += labelOffset;
+			geometry.labelPoint.y += labelOffset;
+			geometry.hasLabel = true;
+			// Allow for the extent of the text
+			geometry.boundingBox.Union(wxRect(geometry.labelPoint, wxSize(wxRound(LABEL_WIDTH * scale), wxRound(LABEL_HEIGHT * scale))));
+		}
+
+		// Draw a true wind direction arrow centred on the start boat
+		if (!isnan(inputs.trueWindDirection)) {
+			geometry.hasTrueWindArrow = true;
+			CalculateArrow(geometry.trueWindArrow, geometry.starboardPoint, inputs.trueWindDirection, ARROW_INNER_RADIUS * scale, arrowLength);
+			geometry.boundingBox.Union(wxRect(geometry.starboardPoint - wxPoint(arrowLength, arrowLength),
+				wxSize((2 * arrowLength) + 1, (2 * arrowLength) + 1)));
+		}
+	}
+
+	if (geometry.hasRing) {
+		// Draw an annular ring centred around the boat with apparent wind direction indication
+		// Seems like there is no way to calculate a fixed length so given 1' of latitude = 1NM
+		geometry.boatPoint = projection.GetPixel(inputs.boatLatitude, inputs.boatLongitude);
+		wxPoint ringPoint = projection.GetPixel(inputs.boatLatitude + (inputs.ringRadius / 60.0), inputs.boatLongitude);
+		geometry.ringRadius = abs(geometry.boatPoint.y - ringPoint.y);
+		// The arrow lies within the ring
+		geometry.boundingBox.Union(wxRect(geometry.boatPoint - wxPoint(geometry.ringRadius, geometry.ringRadius),
+			wxSize((2 * geometry.ringRadius) + 1, (2 * geometry.ringRadius) + 1)));
+
+		if (!isnan(inputs.apparentWindDirection)) {
+			geometry.hasApparentWindArrow = true;
+			CalculateArrow(geometry.apparentWindArrow, geometry.boatPoint, inputs.apparentWindDirection, ARROW_INNER_RADIUS * scale, geometry.ringRadius);
+			geometry.apparentWindColour = GetWindSpeedColour(inputs.apparentWindSpeed);
+		}
+	}
+
+	if (geometry.hasTrack) {
+		UpdateTrackGeometry(vp, inputs.track);
+	}
+
+	geometryInputs = inputs;
+	isGeometryValid = true;
+	geometryRevision++;
+}
+
+void CanvasOverlay::UpdateTrackGeometry(PlugIn_ViewPort* vp, const TrackHistory* track) {
+	// Every sample is projected, it is cheap and selecting first would need a projection per level
+	projection.ProjectPoints(track->GetPoints(), geometry.trackX, geometry.trackY);
+	track->GetVisibleIndices(vp->view_scale_ppm, geometry.trackIndices);
+
+	if (geometry.trackIndices.empty()) {
+		return;
+	}
+	float minimumX = geometry.trackX[geometry.trackIndices[0]];
+	float maximumX = minimumX;
+	float minimumY = geometry.trackY[geometry.trackIndices[0]];
+	float maximumY = minimumY;
+	for (unsigned int index : geometry.trackIndices) {
+		minimumX = std::min(minimumX, geometry.trackX[index]);
+		maximumX = std::max(maximumX, geometry.trackX[index]);
+		minimumY = std::min(minimumY, geometry.trackY[index]);
+		maximumY = std::max(maximumY, geometry.trackY[index]);
+	}
+	geometry.boundingBox.Union(wxRect(wxPoint(wxRound(minimumX), wxRound(minimumY)),
+		wxPoint(wxRound(maximumX), wxRound(maximumY))));
+}
+
+void CanvasOverlay::BuildVertexBuffer(void) {
+	vertexBuffer.Clear();
+
+	// Only the segments that are on screen, each blending between the colours of its ends
+	if (geometry.hasTrack) {
+		const std::vector<float>& efficiencies = geometryInputs.track->GetEfficiencies();
+		const std::vector<unsigned int>& indices = geometry.trackIndices;
+		for (size_t i = 1; i < indices.size(); i++) {
+			unsigned int previous = indices[i - 1];
+			unsigned int current = indices[i];
+			if (!IsSegmentCulled(geometry.trackX[previous], geometry.trackY[previous],
+				geometry.trackX[current], geometry.trackY[current], geometry.width, geometry.height)) {
+				vertexBuffer.AddGradientLine(geometry.trackX[previous], geometry.trackY[previous], GetEfficiencyColour(efficiencies[previous]),
+					geometry.trackX[current], geometry.trackY[current], GetEfficiencyColour(efficiencies[current]), TRACK_WIDTH * geometry.scale);
+			}
+		}
+	}
+
+	if (geometry.hasStartLine) {
+		vertexBuffer.AddLine(geometry.starboardPoint.x, geometry.starboardPoint.y,
+			geometry.portPoint.x, geometry.portPoint.y, geometryInputs.startLineColour, START_LINE_WIDTH * geometry.scale);
+
+		if (geometry.hasFavouredEnd) {
+			vertexBuffer.AddDashedLine(geometry.unfavouredPoint.x, geometry.unfavouredPoint.y,
+				geometry.squarePoint.x, geometry.squarePoint.y, *wxGREEN, DASH_LENGTH * geometry.scale, GAP_LENGTH * geometry.scale, geometry.scale);
+			vertexBuffer.AddCircle(geometry.favouredPoint.x, geometry.favouredPoint.y, FAVOURED_RADIUS * geometry.scale,
+				*wxGREEN, START_LINE_WIDTH * geometry.scale);
+		}
+
+		if (geometry.hasTrueWindArrow) {
+			vertexBuffer.AddLines(WXSIZEOF(geometry.trueWindArrow), geometry.trueWindArrow, *wxBLUE, geometry.scale);
+		}
+	}
+
+	if (geometry.hasRing) {
+		vertexBuffer.AddCircle(geometry.boatPoint.x, geometry.boatPoint.y, geometry.ringRadius, *wxBLACK, geometry.scale);
+
+		// The last point closes the outline, a filled triangle only needs the first three
+		if (geometry.hasApparentWindArrow) {
+			vertexBuffer.AddPolygon(3, geometry.apparentWindArrow, geometry.apparentWindColour);
+		}
+	}
+
+	vertexBufferRevision = geometryRevision;
+}
+
+void CanvasOverlay::BuildPaths(wxGraphicsContext* context) {
+	renderer = context->GetRenderer();
+
+	// A light grey brush with an alpha channel (opacity/transparency)
+	ringBrush = context->CreateBrush(wxBrush(wxColour(100, 100, 100, 50)));
+	ringPath = context->CreatePath();
+	ringPath.AddCircle(geometry.boatPoint.x, geometry.boatPoint.y, geometry.ringRadius);
+
+	if (geometry.hasApparentWindArrow) {
+		const wxPoint* arrow = geometry.apparentWindArrow;
+		apparentWindPath = context->CreatePath();
+		apparentWindPath.MoveToPoint(arrow[0].x, arrow[0].y);
+		apparentWindPath.AddLineToPoint(arrow[1].x, arrow[1].y);
+		apparentWindPath.AddLineToPoint(arrow[2].x, arrow[2].y);
+		apparentWindPath.CloseSubpath();
+
+		// Orange to light orange gradient
+		wxGraphicsGradientStops stops;
+		stops.SetStartColour(wxColour(255, 153, 51));
+		stops.SetEndColour(wxColour(255, 229, 204));
+		apparentWindBrush = context->CreateLinearGradientBrush(arrow[0].x, arrow[0].y, arrow[2].x, arrow[2].y, stops);
+	}
+
+	pathRevision = geometryRevision;
+}
+
+void CanvasOverlay::UpdateLabelFont(double scale) {
+	if (scale != labelFontScale) {
+		labelFont = *wxNORMAL_FONT;
+		labelFont.SetPointSize(std::max(1, wxRound(labelFont.GetPointSize() * scale)));
+		labelFontScale = scale;
+	}
+}
+
+bool CanvasOverlay::IsSegmentCulled(float x1, float y1, float x2, float y2, int width, int height) {
+	return ((x1 < 0.0f) && (x2 < 0.0f)) || ((y1 < 0.0f) && (y2 < 0.0f)) ||
+		((x1 > width) && (x2 > width)) || ((y1 > height) && (y2 > height));
+}
+
+bool CanvasOverlay::IsVisible(const wxRect& boundingBox, PlugIn_ViewPort* vp) {
+	return !boundingBox.IsEmpty() && boundingBox.Intersects(wxRect(0, 0, vp->pix_width, vp->pix_height));
+}
+
+bool CanvasOverlay::IsSameInputs(const OverlayInputs& inputs1, const OverlayInputs& inputs2) {
+	return (inputs1.showStartLine == inputs2.showStartLine) &&
+		(inputs1.hasStartLine == inputs2.hasStartLine) &&
+		(inputs1.startLineColour == inputs2.startLineColour) &&
+		(inputs1.biasLabel == inputs2.biasLabel) &&
+		IsSameValue(inputs1.starboardLatitude, inputs2.starboardLatitude) &&
+		IsSameValue(inputs1.starboardLongitude, inputs2.starboardLongitude) &&
+		IsSameValue(inputs1.portLatitude, inputs2.portLatitude) &&
+		IsSameValue(inputs1.portLongitude, inputs2.portLongitude) &&
+		IsSameValue(inputs1.trueWindDirection, inputs2.trueWindDirection) &&
+		(inputs1.favouredEnd == inputs2.favouredEnd) &&
+		IsSameValue(inputs1.squareLineLatitude, inputs2.squareLineLatitude) &&
+		IsSameValue(inputs1.squareLineLongitude, inputs2.squareLineLongitude) &&
+		(inputs1.showWindAngles == inputs2.showWindAngles) &&
+		IsSameValue(inputs1.boatLatitude, inputs2.boatLatitude) &&
+		IsSameValue(inputs1.boatLongitude, inputs2.boatLongitude) &&
+		IsSameValue(inputs1.ringRadius, inputs2.ringRadius) &&
+		IsSameValue(inputs1.apparentWindDirection, inputs2.apparentWindDirection) &&
+		IsSameValue(inputs1.apparentWindSpeed, inputs2.apparentWindSpeed) &&
+		(inputs1.showTrack == inputs2.showTrack) &&
+		(inputs1.track == inputs2.track) &&
+		(inputs1.trackRevision == inputs2.trackRevision);
+}
+
+void CanvasOverlay::CalculateArrow(wxPoint* arrow, wxPoint centre, double direction, double innerRadius, double outerRadius) {
+	// Remember, 0 degress is at 3'oclock on the screen !
+	double radians = (fmod(direction + 360.0, 360.0) - 90.0) * M_PI / 180.0;
+	arrow[0].x = (cos(radians) * innerRadius) + centre.x;
+	arrow[0].y = (sin(radians) * innerRadius) + centre.y;
+	arrow[1].x = (cos(radians + 0.088) * outerRadius) + centre.x;
+	arrow[1].y = (sin(radians + 0.088) * outerRadius) + centre.y;
+	arrow[2].x = (cos(radians - 0.088) * outerRadius) + centre.x;
+	arrow[2].y = (sin(radians - 0.088) * outerRadius) + centre.y;
+	arrow[3] = arrow[0];
+}
+
+// Use different colours for different wind speed ranges
+wxColour CanvasOverlay::GetWindSpeedColour(double windSpeed) {
+	if (windSpeed < 10) {
+		return wxColour(255, 255, 155);
+	}
+	if (windSpeed < 15) {
+		return wxColour(0, 255, 0);
+	}
+	if (windSpeed < 20) {
+		return wxColour(0, 255, 255);
+	}
+	if (windSpeed < 25) {
+		return wxColour(0, 0, 255);
+	}
+	return wxColour(255, 155, 128);
+}
+
+wxColour CanvasOverlay::GetEfficiencyColour(float efficiency) {
+	if (isnan(efficiency)) {
+		// No target for this wind yet
+		return wxColour(150, 150, 150);
+	}
+
+	// 0 at 70% of target or below, 1 at 100% or above, in 5% bands
+	double band = floor(efficiency / 0.05) * 0.05;
+	double fraction = (band - 0.7) / 0.3;
+	fraction = fraction < 0.0 ? 0.0 : (fraction > 1.0 ? 1.0 : fraction);
+
+	// Red, through yellow, to green
+	if (fraction < 0.5) {
+		return wxColour(255, static_cast<unsigned char>(510.0 * fraction), 0);
+	}
+	return wxColour(static_cast<unsigned char>(510.0 * (1.0 - fraction)), 200 + static_cast<unsigned char>(110.0 * (1.0 - fraction)), 0);
+}
@@ -0,0 +1,162 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Multi sample averaged pings of the start line marks
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_ping.h"
+
+#include <algorithm>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Metres per degree of latitude, 1' = 1NM
+const double METRES_PER_DEGREE = 1852.0 * 60.0;
+
+// Samples further than this multiple of the median distance from the median position are rejected
+const double OUTLIER_THRESHOLD = 3.0;
+
+// But never reject samples within this distance (metres), GPS positions are often quantized
+const double MINIMUM_THRESHOLD = 1.0;
+
+MarkSampler::MarkSampler() {
+	isSampling = false;
+	endTime = 0;
+	estimatedLatitude = 0.0;
+	estimatedLongitude = 0.0;
+	confidenceRadius = 0.0;
+	rejectedCount = 0;
+}
+
+void MarkSampler::Start(long long durationMilliseconds, long long timeMilliseconds) {
+	latitudes.clear();
+	longitudes.clear();
+	// Five seconds at 10Hz, avoids reallocation for typical receivers
+	latitudes.reserve(64);
+	longitudes.reserve(64);
+	endTime = timeMilliseconds + durationMilliseconds;
+	rejectedCount = 0;
+	confidenceRadius = 0.0;
+	isSampling = true;
+}
+
+void MarkSampler::Cancel(void) {
+	isSampling = false;
+}
+
+bool MarkSampler::IsSampling(void) const {
+	return isSampling;
+}
+
+bool MarkSampler::IsElapsed(long long timeMilliseconds) const {
+	return isSampling && (timeMilliseconds >= endTime);
+}
+
+bool MarkSampler::AddSample(double latitude, double longitude, long long timeMilliseconds) {
+	if (!isSampling) {
+		return false;
+	}
+	if ((!std::isnan(latitude)) && (!std::isnan(longitude))) {
+		latitudes.push_back(latitude);
+		longitudes.push_back(longitude);
+	}
+	return timeMilliseconds >= endTime;
+}
+
+bool MarkSampler::Finish(void) {
+
+	isSampling = false;
+
+	size_t count = latitudes.size();
+	if (count == 0) {
+		return false;
+	}
+
+	// Work in metres north & east of the first sample, over a few metres a flat earth is fine
+	double originLatitude = latitudes[0];
+	double originLongitude = longitudes[0];
+	double metresPerDegreeLongitude = METRES_PER_DEGREE * cos(originLatitude * M_PI / 180.0);
+
+	std::vector<double> north(count), east(count);
+	for (size_t i = 0; i < count; i++) {
+		north[i] = (latitudes[i] - originLatitude) * METRES_PER_DEGREE;
+		east[i] = (longitudes[i] - originLongitude) * metresPerDegreeLongitude;
+	}
+
+	// Median position is robust to the occasional wild fix
+	std::vector<double> scratch(north);
+	double medianNorth = Median(scratch);
+	scratch = east;
+	double medianEast = Median(scratch);
+
+	std::vector<double> distances(count);
+	for (size_t i = 0; i < count; i++) {
+		distances[i] = hypot(north[i] - medianNorth, east[i] - medianEast);
+	}
+	scratch = distances;
+	double threshold = std::max(OUTLIER_THRESHOLD * Median(scratch), MINIMUM_THRESHOLD);
+
+	// Average the samples that are not outliers
+	double sumNorth = 0.0;
+	double sumEast = 0.0;
+	size_t accepted = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (distances[i] <= threshold) {
+			sumNorth += north[i];
+			sumEast += east[i];
+			accepted++;
+		}
+	}
+	rejectedCount = static_cast<int>(count - accepted);
+
+	double meanNorth = sumNorth / accepted;
+	double meanEast = sumEast / accepted;
+
+	// Radius containing 95% of the accepted samples
+	scratch.clear();
+	for (size_t i = 0; i < count; i++) {
+		if (distances[i] <= threshold) {
+			scratch.push_back(hypot(north[i] - meanNorth, east[i] - meanEast));
+		}
+	}
+	size_t percentile = static_cast<size_t>(ceil(0.95 * scratch.size())) - 1;
+	std::nth_element(scratch.begin(), scratch.begin() + percentile, scratch.end());
+	confidenceRadius = scratch[percentile];
+
+	estimatedLatitude = originLatitude + (meanNorth / METRES_PER_DEGREE);
+	estimatedLongitude = originLongitude + (meanEast / metresPerDegreeLongitude);
+
+	return true;
+}
+
+double MarkSampler::Median(std::vector<double>& values) {
+	size_t middle = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + middle, values.end());
+	double median = values[middle];
+	if ((values.size() % 2) == 0) {
+		// The lower middle value is the largest of the lower half
+		median = (median + *std::max_element(values.begin(), values.begin() + middle)) / 2.0;
+	}
+	return median;
+}
@@ -52,10 +52,68 @@ RacingPlugin::RacingPlugin(void *ppimgr) : opencpn_plugin_118(ppimgr), wxEvtHand
 	
 	// Dialogs displayed by the plugin
 	windWizard = nullptr;
+	windHistory = nullptr;
 	racingWindow = nullptr;
 	racingToolbox = nullptr;
 	racingSettings = nullptr;
 
+	starboardMarkRadius = 0.0;
+	portMarkRadius = 0.0;
+
+	biasRevision = 0;
+	squareLineLatitude = 0.0;
+	squareLineLongitude = 0.0;
+
+	trackEfficiency = std::numeric_limits<double>::quiet_NaN();
+
+	// Chart overlays are created on first use
+	canvasOverlays[0] = nullptr;
+	canvasOverlays[1] = nullptr;
+
+	// Messages we generate, in the order of their OUTPUT_ identifiers.
+	// The intervals and priorities may be changed in the configuration file
+	outputScheduler.Add("MWV", 1000, 1, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("PGN130306", 1000, 1, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("PGN130306TrueNorth", 1000, 1, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("PGN130577", 1000, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("VPW", 1000, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("VDR", 1000, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("XDRPerformance", 1000, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("XDRStart", 1000, 1, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("LiveData", 500, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("SignalK", 1000, 0, MAXIMUM_INPUT_AGE);
+	outputScheduler.Add("SharedMemory", 100, 0, MAXIMUM_INPUT_AGE);
+
+	// SignalK paths, in the order of their SIGNALK_ identifiers, with the decimals of their SI units
+	signalKDelta.Add("environment.wind.speedTrue", 2);
+	signalKDelta.Add("environment.wind.angleTrueWater", 4);
+	signalKDelta.Add("environment.wind.directionTrue", 4);
+	signalKDelta.Add("performance.velocityMadeGood", 2);
+	signalKDelta.Add("performance.targetSpeed", 2);
+	signalKDelta.Add("performance.polarSpeedRatio", 3);
+	signalKDelta.Add("navigation.racing.distanceStartline", 1);
+	signalKDelta.Add("navigation.racing.timeToStart", 0);
+	signalKDelta.Add("navigation.racing.timeToLine", 0);
+	signalKDelta.Add("navigation.racing.timeToBurn", 0);
+	signalKDelta.Add("navigation.racing.startLineBias", 4);
+	signalKDelta.Add("environment.current.setTrue", 4);
+	signalKDelta.Add("environment.current.setMagnetic", 4);
+	signalKDelta.Add("environment.current.drift", 2);
+	outputTimer = nullptr;
+	n2kSequenceId = 0;
+
+	// Nothing is derived until the first second has elapsed
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	derivedData.velocityMadeGood = nan;
+	derivedData.targetSpeed = nan;
+	derivedData.polarPercentage = nan;
+	derivedData.setTrue = nan;
+	derivedData.setMagnetic = nan;
+	derivedData.drift = nan;
+	derivedData.lineDistance = nan;
+	derivedData.timeToLine = nan;
+	derivedData.timeToBurn = nan;
+
 	// Initialize the plugin bitmap
 	wxString pluginFolder = GetPluginDataDir(PLUGIN_PACKAGE_NAME) + wxFileName::GetPathSeparator() + "data" + wxFileName::GetPathSeparator();
 	pluginBitmap = GetBitmapFromSVGFile(pluginFolder + "racing_icon_toggled.svg", 32, 32);
@@ -109,6 +167,10 @@ int RacingPlugin::Init(void) {
 	wxMenuItem* wizardMenu = new wxMenuItem(NULL, wxID_HIGHEST + 1, "Wind Wizard", "a funky gauge", wxITEM_NORMAL, NULL);
 	racingContextMenuId = AddCanvasContextMenuItem(wizardMenu, this);
 
+	// This menu item is used to display the wind history strip chart
+	wxMenuItem* historyMenu = new wxMenuItem(NULL, wxID_HIGHEST + 2, "Wind History", "true wind direction & speed history", wxITEM_NORMAL, NULL);
+	historyContextMenuId = AddCanvasContextMenuItem(historyMenu, this);
+
 	// Set up the listeners. NMEA 0183, NMEA 2000 and SignalK are used to obtain data 
 	// for boat speed, apparent wind angle & speed and NavData for position and heading
 	// BUG BUG Should ensure that the connections exist before adding the listeners
@@ -137,6 +199,22 @@ int RacingPlugin::Init(void) {
 		HandleDPT(ev);
 		});
 
+	// NMEA 0183 ZDA Time & Date Sentence
+	wxDEFINE_EVENT(EVT_183_ZDA, ObservedEvt);
+	NMEA0183Id id_zda = NMEA0183Id("ZDA");
+	listener_zda = std::move(GetListener(id_zda, EVT_183_ZDA, this));
+	Bind(EVT_183_ZDA, [&](ObservedEvt ev) {
+		HandleZDA(ev);
+		});
+
+	// NMEA 0183 RMC Sentence, only used for GPS time
+	wxDEFINE_EVENT(EVT_183_RMC, ObservedEvt);
+	NMEA0183Id id_rmc = NMEA0183Id("RMC");
+	listener_rmc = std::move(GetListener(id_rmc, EVT_183_RMC, this));
+	Bind(EVT_183_RMC, [&](ObservedEvt ev) {
+		HandleRMC(ev);
+		});
+
 	// PGN 130306 Wind
 	wxDEFINE_EVENT(EVT_N2K_130306, ObservedEvt);
 	NMEA2000Id id_130306 = NMEA2000Id(130306);
@@ -161,6 +239,14 @@ int RacingPlugin::Init(void) {
 		HandleN2K_128259(ev);
 		});
 
+	// PGN 126992 System Time
+	wxDEFINE_EVENT(EVT_N2K_126992, ObservedEvt);
+	NMEA2000Id id_126992 = NMEA2000Id(126992);
+	listener_126992 = std::move(GetListener(id_126992, EVT_N2K_126992, this));
+	Bind(EVT_N2K_126992, [&](ObservedEvt ev) {
+		HandleN2K_126992(ev);
+		});
+
 	// SignalK, Observer Listener now supported in API 1.19
 #if (OCPN_API_VERSION_MINOR == 19)
 	wxDEFINE_EVENT(EVT_SIGNALK, ObservedEvt);
@@ -189,7 +275,8 @@ int RacingPlugin::Init(void) {
 #endif
 	
 	// Retrieve a NMEA 2000 network interface which is used to transmit
-	// PGN 130306 with the calculated True Wind Angles and Speed.
+	// PGN 130306 with the calculated True Wind Angles, Direction and Speed,
+	// and PGN 130577 with the Set & Drift of the current.
 	// This is an example of writing to the NMEA 2000 Network
 	n2kNetworkHandle = GetNetworkInterface("nmea2000");
 
@@ -200,18 +287,45 @@ int RacingPlugin::Init(void) {
 	n183NetworkHandle = GetNetworkInterface("nmea0183");
 
 
-	// Plugins need to register what NMEA 2000 PGN's they transmit. This is required for
-	// Actisense NGT-1 Adapters, presumably results in a null operation (NOP) for other interfaces
-	if (!n2kNetworkHandle.empty()) {
-		std::vector<int> transmittedPGN = { 130306 };
-		RegisterTXPGNs(n2kNetworkHandle, transmittedPGN);
+	// Serve the generated sentences to crew tablets etc.
+	if (isServerEnabled) {
+		if (nmeaServer.Start(serverTcpPort, serverUdpAddress.ToStdString(), serverUdpPort)) {
+			wxLogMessage("Racing Plugin, NMEA 0183 Server, TCP Port: %d, UDP: %s:%d", serverTcpPort, serverUdpAddress, serverUdpPort);
+		}
+		else {
+			wxLogMessage("Racing Plugin, NMEA 0183 Server failed to start, TCP Port: %d, UDP: %s:%d", serverTcpPort, serverUdpAddress, serverUdpPort);
+		}
+	}
+
+	// Serve the live data page to phones etc.
+	if (isLiveDataEnabled) {
+		if (liveDataServer.Start(liveDataPort)) {
+			wxLogMessage("Racing Plugin, Live Data Server, Port: %d", liveDataPort);
+		}
+		else {
+			wxLogMessage("Racing Plugin, Live Data Server failed to start, Port: %d", liveDataPort);
+		}
 	}
 
+	// Export the fused state for analysis tools
+	if (isSharedMemoryEnabled) {
+		if (sharedMemory.Open(sharedMemoryName.ToStdString())) {
+			wxLogMessage("Racing Plugin, Shared Memory: %s", sharedMemoryName);
+		}
+		else {
+			wxLogMessage("Racing Plugin, Shared Memory failed to open: %s", sharedMemoryName);
+		}
+	}
+
+	RegisterTransmittedPGNs();
+
 	// Wire up the event handler to receive events from the Countdown Timer dialog
 	Connect(wxEVT_RACE_DIALOG_EVENT, wxCommandEventHandler(RacingPlugin::OnDialogEvent));
 
 	// Instantiate the "Wind Wizard" gauge
 	windWizard = new WindWizard(parentWindow);
+	windWizard->SetAnimationRate(gaugeFrameRate);
+	windWizard->SetDisplayScale(RacingGraphics::GetDisplayScaleFactor());
 	
 	// Add the "Wind Wizard" gauge to the AUI Manager
 	wxAuiPaneInfo paneInfo;
@@ -223,6 +337,20 @@ int RacingPlugin::Init(void) {
 	paneInfo.MinSize(windWizard->GetMinSize());
 	paneInfo.Show(isWindWizardVisible);
 	auiManager->AddPane(windWizard, paneInfo);
+
+	// Instantiate the wind history strip chart and add it to the AUI Manager
+	windHistory = new WindHistory(parentWindow);
+	windHistory->SetWindow(historyWindow);
+
+	wxAuiPaneInfo historyPaneInfo;
+	historyPaneInfo.Name("WindHistory");
+	historyPaneInfo.Caption("Wind History");
+	historyPaneInfo.CloseButton(true);
+	historyPaneInfo.GripperTop(true);
+	historyPaneInfo.Float();
+	historyPaneInfo.MinSize(windHistory->GetMinSize());
+	historyPaneInfo.Show(isWindHistoryVisible);
+	auiManager->AddPane(windHistory, historyPaneInfo);
 	auiManager->Update();
 	auiManager->Connect(wxEVT_AUI_PANE_CLOSE, wxAuiManagerEventHandler(RacingPlugin::OnPaneClose), NULL, this);
 
@@ -250,6 +378,11 @@ void RacingPlugin::LateInit(void) {
 	oneSecondTimer = new wxTimer();
 	oneSecondTimer->Connect(wxEVT_TIMER, wxTimerEventHandler(RacingPlugin::OnTimerElapsed), NULL, this);
 	oneSecondTimer->Start(1000, wxTIMER_CONTINUOUS);
+
+	// Generated messages are sent from a faster timer, so that each may have its own rate
+	outputTimer = new wxTimer();
+	outputTimer->Connect(wxEVT_TIMER, wxTimerEventHandler(RacingPlugin::OnOutputTimer), NULL, this);
+	outputTimer->Start(OUTPUT_TICK, wxTIMER_CONTINUOUS);
 }
 
 // OpenCPN is either closing down, or we have been disabled from the Preferences Dialog
@@ -264,10 +397,38 @@ bool RacingPlugin::DeInit(void) {
 	}
 	oneSecondTimer->Disconnect(wxEVT_TIMER, wxTimerEventHandler(RacingPlugin::OnTimerElapsed), NULL, this);
 
+	// Cleanup the Output Timer, and report what was sent
+	if (outputTimer != nullptr) {
+		outputTimer->Stop();
+		outputTimer->Disconnect(wxEVT_TIMER, wxTimerEventHandler(RacingPlugin::OnOutputTimer), NULL, this);
+		delete outputTimer;
+		outputTimer = nullptr;
+	}
+	nmeaServer.Stop();
+	liveDataServer.Stop();
+	sharedMemory.Close();
+	for (int i = 0; i < outputScheduler.GetCount(); i++) {
+		const OutputStatistics& statistics = outputScheduler.GetStatistics(i);
+		wxLogMessage("Racing Plugin, Output %s, Sent: %llu, Stale: %llu, Dropped: %llu", outputScheduler.GetName(i),
+			statistics.sent, statistics.stale, statistics.dropped);
+	}
+
 	// Disconnect the Advanced User Interface manager
 	auiManager->DetachPane(windWizard);
+	auiManager->DetachPane(windHistory);
 	auiManager->Disconnect(wxEVT_AUI_PANE_CLOSE, wxAuiManagerEventHandler(RacingPlugin::OnPaneClose), NULL, this);
 	delete windWizard;
+	delete windHistory;
+
+	// Cleanup the chart overlays, and report what they cost
+	for (size_t i = 0; i < WXSIZEOF(canvasOverlays); i++) {
+		if (canvasOverlays[i] != nullptr) {
+			wxLogMessage("Racing Plugin, Overlay %d, Frames: %lld, Average: %.0f us per frame", static_cast<int>(i),
+				canvasOverlays[i]->GetFrameCount(), canvasOverlays[i]->GetAverageFrameTime());
+			delete canvasOverlays[i];
+			canvasOverlays[i] = nullptr;
+		}
+	}
 
 	// Cleanup the toolbox page here because OnSetupToolbox is only called once at Startup.
 	// If we were to perform the cleanup in the OnCloseToolboxPane method, we can never initialize it again.
@@ -294,6 +455,11 @@ void RacingPlugin::UpdateAuiStatus(void) {
 		auiManager->GetPane(PLUGIN_COMMON_NAME).Show(isWindWizardVisible);
 		SetCanvasContextMenuItemGrey(racingContextMenuId, isWindWizardVisible);
 	}
+
+	if (auiManager->GetPane("WindHistory").IsOk()) {
+		auiManager->GetPane("WindHistory").Show(isWindHistoryVisible);
+		SetCanvasContextMenuItemGrey(historyContextMenuId, isWindHistoryVisible);
+	}
 }
 
 // Keep the context menu synchronized when the AUI pane is closed
@@ -304,6 +470,10 @@ void RacingPlugin::OnPaneClose(wxAuiManagerEvent& event) {
 		// Toggle the context menu item
 		SetCanvasContextMenuItemGrey(racingContextMenuId, isWindWizardVisible);
 	}
+	else if (event.GetPane()->name == "WindHistory") {
+		isWindHistoryVisible = false;
+		SetCanvasContextMenuItemGrey(historyContextMenuId, isWindHistoryVisible);
+	}
 	else {
 		event.Skip();
 	}
@@ -403,6 +573,13 @@ void RacingPlugin::OnContextMenuItemCallback(int id) {
 		auiManager->GetPane(PLUGIN_COMMON_NAME).Show(isWindWizardVisible);
 		auiManager->Update();
 	}
+
+	if (id == historyContextMenuId) {
+		isWindHistoryVisible = !isWindHistoryVisible;
+		SetCanvasContextMenuItemGrey(historyContextMenuId, isWindHistoryVisible);
+		auiManager->GetPane("WindHistory").Show(isWindHistoryVisible);
+		auiManager->Update();
+	}
 }
 
 // Set default values when the plugin is installed
@@ -442,6 +619,8 @@ void RacingPlugin::OnCloseToolboxPanel(int page_sel, int ok_apply_cancel) {
 	if ((ok_apply_cancel == 0) || (ok_apply_cancel == 4)) {
 		// Save the setttings
 		SaveSettings();
+		windWizard->SetAnimationRate(gaugeFrameRate);
+		RegisterTransmittedPGNs();
 	}
 }
 
@@ -452,6 +631,7 @@ void RacingPlugin::ShowPreferencesDialog(wxWindow* parent) {
 	racingSettings = new RacingSettings(parent);
 	if (racingSettings->ShowModal() == wxID_OK) {
 		SaveSettings();
+		RegisterTransmittedPGNs();
 	}
 }
 
@@ -460,9 +640,11 @@ void RacingPlugin::SetColorScheme(PI_ColorScheme cs) {
 
 	if ((cs == PI_GLOBAL_COLOR_SCHEME_DUSK) || (cs == PI_GLOBAL_COLOR_SCHEME_NIGHT)) {
 		windWizard->SetNightMode(true);
+		windHistory->SetNightMode(true);
 	}
 	else {
 		windWizard->SetNightMode(false);
+		windHistory->SetNightMode(false);
 	}
 }
 
@@ -477,75 +659,14 @@ bool RacingPlugin::RenderOverlayMultiCanvas(wxDC& dc, PlugIn_ViewPort* vp,
 
 			if ((canvasIndex == 0) || ((canvasIndex == 1) && (showMultiCanvas))) {
 
-				if (showStartline) {
-
-					// Draw a line on the chart to indicate the start line
-					if ((!starboardMarkGuid.IsEmpty()) && (!portMarkGuid.IsEmpty())) {
-						// Obtain the screen cordinates for the starboard and port ends of the start line
-						wxPoint starboardScreenPoint, portScreenPoint;
-						GetCanvasPixLL(vp, &starboardScreenPoint, starboardMarkLatitude, starboardMarkLongitude);
-						GetCanvasPixLL(vp, &portScreenPoint, portMarkLatitude, portMarkLongitude);
-
-						dc.SetPen(*wxBLACK_PEN);
-						dc.DrawLine(starboardScreenPoint, portScreenPoint);
-					}
+				// The overlay keeps its paths and brushes between frames
+				if (canvasOverlays[canvasIndex] == nullptr) {
+					canvasOverlays[canvasIndex] = new CanvasOverlay();
 				}
 
-				if (showWindAngles) {
-
-					// Example of using a graphics context, so we can use alpha channels, rotate text etc.
-					wxMemoryDC* memoryDC;
-					memoryDC = wxDynamicCast(&dc, wxMemoryDC);
-					wxGraphicsContext* graphicsContext = wxGraphicsContext::Create(*memoryDC);
-
-					// Draw an annular ring centred around the boat
-					graphicsContext->SetPen(*wxBLACK_PEN);
-					// The following specifies a light grey brush with an alpha channel (opacity/transparency)
-					graphicsContext->SetBrush(wxColour(100, 100, 100, 50));
-					wxGraphicsPath graphicsPath = graphicsContext->CreatePath();
-					// Convert our current position to screen co-ordinates
-					wxPoint boatLocation, ringLocation;
-					GetCanvasPixLL(vp, &boatLocation, currentLatitude, currentLongitude);
-					// Draw a transparent circle around the boat, the radius equal to the heading predictor length
-					// Seems like there is no way to calculate a fixed length so given 1' of latitude = 1NM
-					double oneMinuteAway = currentLatitude + (headingPredictorLength * 0.0166f);
-					GetCanvasPixLL(vp, &ringLocation, oneMinuteAway, currentLongitude);
-					graphicsPath.AddCircle(boatLocation.x, boatLocation.y, abs(boatLocation.y - ringLocation.y));
-					graphicsContext->FillPath(graphicsPath);
-
-					// Draw apparent wind angle centred around the boat
-					if ((!isnan(apparentWindAngle)) && (!isnan(headingMagnetic))) {
-						double drawnAngle = apparentWindAngle + headingMagnetic;
-						if (drawnAngle < 0) {
-							drawnAngle += 360.0;
-						}
-						drawnAngle = fmod(drawnAngle, 360.0);
-
-						// Remember, 0 degress is at 3'oclock on the screen !
-						drawnAngle -= 90;
-
-						double radians;
-						radians = drawnAngle * M_PI / 180;
-
-						wxPoint2DDouble windArrow[3];
-						windArrow[0].m_x = (cos(radians) * 10) + boatLocation.x;
-						windArrow[0].m_y = (sin(radians) * 10) + boatLocation.y;
-						windArrow[1].m_x = (cos(radians + 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.x;
-						windArrow[1].m_y = (sin(radians + 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.y;
-						windArrow[2].m_x = (cos(radians - 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.x;
-						windArrow[2].m_y = (sin(radians - 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.y;
-
-						// An example of drawing using a gradient.
-						wxGraphicsGradientStops stops;
-						stops.SetStartColour(wxColor(255, 153, 51)); // Orangle
-						stops.SetEndColour(wxColour(255, 229, 204)); // Light Orange
-						graphicsContext->SetBrush(graphicsContext->CreateLinearGradientBrush(windArrow[0].m_x, windArrow[0].m_y,
-							windArrow[2].m_x, windArrow[2].m_y, stops));
-						graphicsContext->SetPen(wxPen(wxColor(255, 153, 51), 1, wxPENSTYLE_SOLID));
-						graphicsContext->DrawLines(WXSIZEOF(windArrow), windArrow);
-						graphicsContext->Flush();
-					}
-				}
+				OverlayInputs inputs;
+				GetOverlayInputs(inputs);
+				canvasOverlays[canvasIndex]->RenderDC(dc, vp, inputs);
 
 				if (showLayLines) {
 					// BUG BUG ToDo
@@ -569,114 +690,17 @@ bool RacingPlugin::RenderGLOverlayMultiCanvas(wxGLContext* pcontext, PlugIn_View
 
 		if (pcontext->IsOK()) {
 
-			RacingGraphics* rc = new RacingGraphics();
-
 			if ((canvasIndex == 0) || ((canvasIndex == 1) && (showMultiCanvas))) {
 
-				if (showStartline) {
-
-					// Draw a line on the chart to indicate the start line
-					if ((!starboardMarkGuid.IsEmpty()) && (!portMarkGuid.IsEmpty())) {
-						// Obtain the screen cordinates for the starboard and port ends of the start line
-						wxPoint starboardScreenPoint, portScreenPoint;
-						GetCanvasPixLL(vp, &starboardScreenPoint, starboardMarkLatitude, starboardMarkLongitude);
-						GetCanvasPixLL(vp, &portScreenPoint, portMarkLatitude, portMarkLongitude);
-						rc->SetPen(*wxBLACK_PEN);
-						rc->DrawLine(starboardScreenPoint.x, starboardScreenPoint.y,
-							portScreenPoint.x, portScreenPoint.y, true);
-
-						// Draw a true wind direction arrow centred on the start boat
-						if (!isnan(trueWindDirection)) {
-							double drawnAngle = trueWindDirection;
-							if (drawnAngle < 0) {
-								drawnAngle += 360.0;
-							}
-							drawnAngle = fmod(drawnAngle, 360.0);
-
-							drawnAngle -= 90;
-
-							double radians;
-							radians = drawnAngle * M_PI / 180;
-
-							wxPoint windArrow[4];
-							windArrow[0].x = (cos(radians) * 10) + starboardScreenPoint.x;
-							windArrow[0].y = (sin(radians) * 10) + starboardScreenPoint.y;
-							windArrow[1].x = (cos(radians + 0.088) * 70) + starboardScreenPoint.x;
-							windArrow[1].y = (sin(radians + 0.088) * 70) + starboardScreenPoint.y;
-							windArrow[2].x = (cos(radians - 0.088) * 70) + starboardScreenPoint.x;
-							windArrow[2].y = (sin(radians - 0.088) * 70) + starboardScreenPoint.y;
-							windArrow[3].x = (cos(radians) * 10) + starboardScreenPoint.x;
-							windArrow[3].y = (sin(radians) * 10) + starboardScreenPoint.y;
-
-							rc->SetPen(wxPen(*wxBLUE, 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(*wxBLUE_BRUSH);
-							rc->DrawLines(WXSIZEOF(windArrow), windArrow);
-						}
-					}
+				// The overlay keeps its drawing context and projected geometry between frames
+				if (canvasOverlays[canvasIndex] == nullptr) {
+					canvasOverlays[canvasIndex] = new CanvasOverlay();
 				}
 
-				if (showWindAngles) {
-
-					// Draw an annular ring centred around the boat with apparent wind direction indication
-					rc->SetPen(*wxBLACK_PEN);
-					rc->SetBrush(wxColour(100, 100, 100, 50));
-					// Convert our current position to screen co-ordinates
-					wxPoint boatLocation, ringLocation;
-					GetCanvasPixLL(vp, &boatLocation, currentLatitude, currentLongitude);
-					// Draw a transparent circle around the boat
-					double oneMinuteAway = currentLatitude + (headingPredictorLength * 0.0166f);
-					GetCanvasPixLL(vp, &ringLocation, oneMinuteAway, currentLongitude);
-					rc->StrokeCircle(boatLocation.x, boatLocation.y, abs(boatLocation.y - ringLocation.y));
-
-					// Draw apparent wind angle centred around the boat
-					if ((!isnan(apparentWindAngle)) && (!isnan(headingMagnetic))) {
-						double drawnAngle = apparentWindAngle + headingMagnetic;
-						if (drawnAngle < 0) {
-							drawnAngle += 360.0f;
-						}
-						drawnAngle = fmod(drawnAngle, 360.0f);
-
-						drawnAngle -= 90;
-
-						double radians;
-						radians = drawnAngle * M_PI / 180;
-
-						wxPoint windArrow[4];
-						windArrow[0].x = (cos(radians) * 10) + boatLocation.x;
-						windArrow[0].y = (sin(radians) * 10) + boatLocation.y;
-						windArrow[1].x = (cos(radians + 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.x;
-						windArrow[1].y = (sin(radians + 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.y;
-						windArrow[2].x = (cos(radians - 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.x;
-						windArrow[2].y = (sin(radians - 0.088) * abs(boatLocation.y - ringLocation.y)) + boatLocation.y;
-						windArrow[3].x = (cos(radians) * 10) + boatLocation.x;
-						windArrow[3].y = (sin(radians) * 10) + boatLocation.y;
-						// Use different colours for different wind speed ranges
-						// orange was 253, 153, 51
-						if (apparentWindSpeed < 10) {
-							rc->SetPen(wxPen(wxColor(255, 255, 155), 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(wxColor(255, 255, 155));
-						}
-						else if ((apparentWindSpeed >= 10) && (apparentWindSpeed < 15)) {
-							rc->SetPen(wxPen(wxColor(0, 255, 0), 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(wxColor(0, 255, 0));
-						}
-						else if ((apparentWindSpeed >= 15) && (apparentWindSpeed < 20)) {
-							rc->SetPen(wxPen(wxColor(0, 255, 255), 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(wxColor(0, 255, 255));
-						}
-						else if ((apparentWindSpeed >= 20) && (apparentWindSpeed < 25)) {
-							rc->SetPen(wxPen(wxColor(0, 0, 255), 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(wxColor(0, 0, 255));
-						}
-						else {
-							rc->SetPen(wxPen(wxColor(255, 155, 128), 1, wxPENSTYLE_SOLID));
-							rc->SetBrush(wxColor(255, 155, 128));
-						}
-						
-						// Trying this just to see what it does...
-						rc->DrawPolygonTessellated(WXSIZEOF(windArrow), windArrow);
-					}
-				}
+				OverlayInputs inputs;
+				GetOverlayInputs(inputs);
+				canvasOverlays[canvasIndex]->RenderGL(pcontext, vp, inputs);
+
 				if (showLayLines) {
 					// BUG BUG ToDo
 				}
@@ -714,6 +738,7 @@ void RacingPlugin::SetPositionFixEx(PlugIn_Position_Fix_Ex& pfix) {
 	speedOverGround = pfix.Sog;
 	headingTrue = pfix.Hdt;
 	headingMagnetic = pfix.Hdm;
+	navigationTime = GpsClock::GetLocalMilliseconds();
 }
 
 // The "old way" of receiving NMEA 0183 sentences
@@ -727,6 +752,7 @@ void RacingPlugin::SetNMEASentence(wxString& sentence) {
 		if (parserNMEA0183.LastSentenceIDReceived == "VWR") {
 			if (parserNMEA0183.Parse()) {
 				apparentWindSpeed = fromUsrSpeed_Plugin(parserNMEA0183.Vwr.WindSpeedKnots, 0);
+				apparentWindTime = GpsClock::GetLocalMilliseconds();
 				apparentWindAngle = parserNMEA0183.Vwr.WindDirectionMagnitude;
 				if (parserNMEA0183.Vwr.DirectionOfWind == LEFTRIGHT::Left) {
 					apparentWindAngle = 360.0f - apparentWindAngle;
@@ -766,8 +792,30 @@ void RacingPlugin::HandleNavData(ObservedEvt ev) {
 	//wxMutexLocker lock(lockPositionFix);
 	currentLatitude = navdata.lat;
 	currentLongitude = navdata.lon;
+	courseOverGround = navdata.cog;
+	speedOverGround = navdata.sog;
 	headingTrue = navdata.hdt;
 	headingMagnetic = navdata.hdt - navdata.var;
+	navigationTime = GpsClock::GetLocalMilliseconds();
+	CalculateBowPosition();
+	UpdateStartLinePrediction();
+
+	// Collect every fix at full sensor rate whilst pinging the ends of the start line.
+	// The bow, not the antenna, is put on the mark
+	long long now = GpsClock::GetLocalMilliseconds();
+	if (starboardSampler.AddSample(bowLatitude, bowLongitude, now)) {
+		CompletePing(RACE_DIALOG_STBD);
+	}
+	if (portSampler.AddSample(bowLatitude, bowLongitude, now)) {
+		CompletePing(RACE_DIALOG_PORT);
+	}
+
+	// Our track, at full sensor rate, coloured by how close to the target we were sailing
+	if ((currentLatitude != 0.0) || (currentLongitude != 0.0)) {
+		bool isEfficiencyCurrent = (IsInputCurrent(apparentWindTime, now)) && (IsInputCurrent(boatSpeedTime, now));
+		trackHistory.Add(now, currentLatitude, currentLongitude,
+			isEfficiencyCurrent ? trackEfficiency : std::numeric_limits<double>::quiet_NaN());
+	}
 }
 
 // The "new" way of receiving NMEA 0183 sentences
@@ -779,7 +827,8 @@ void RacingPlugin::HandleMWV(ObservedEvt ev) {
 	wxString sentence = GetN0183Payload(id_183_mwv, ev);
 	parserNMEA0183 << sentence;
 
-	if (parserNMEA0183.Parse()) {
+	// Only apparent (relative) wind, we also send true wind MWV sentences which are looped back to us
+	if ((parserNMEA0183.Parse()) && (parserNMEA0183.Mwv.Reference == "R")) {
 		if (parserNMEA0183.Mwv.WindSpeedUnits == 'N') { //Knots
 			apparentWindSpeed = fromUsrSpeed_Plugin(parserNMEA0183.Mwv.WindSpeed, 0);
 		}
@@ -790,6 +839,7 @@ void RacingPlugin::HandleMWV(ObservedEvt ev) {
 			apparentWindSpeed = fromUsrSpeed_Plugin(parserNMEA0183.Mwv.WindSpeed, 3);
 		}
 		apparentWindAngle = parserNMEA0183.Mwv.WindAngle;
+		apparentWindTime = GpsClock::GetLocalMilliseconds();
 	}
 }
 
@@ -818,6 +868,90 @@ void RacingPlugin::HandleVHW(ObservedEvt ev) {
 	if (parserNMEA0183.Parse()) {
 		// Convert from knots
 		boatSpeed = fromUsrSpeed_Plugin(parserNMEA0183.Vhw.Knots, 0);
+		boatSpeedTime = GpsClock::GetLocalMilliseconds();
+	}
+}
+
+// Parse NMEA 0183 Time & Date sentence
+// $GPZDA,201530.00,04,07,2002,00,00*60
+void RacingPlugin::HandleZDA(ObservedEvt ev) {
+
+	// Time stamp on arrival, before any parsing delay
+	long long localTime = GpsClock::GetLocalMilliseconds();
+
+	NMEA0183Id id_183_zda("ZDA");
+	NMEA0183 parserNMEA0183;
+	wxString sentence = GetN0183Payload(id_183_zda, ev);
+	parserNMEA0183 << sentence;
+
+	if (parserNMEA0183.Parse()) {
+		long long gpsTime = ParseNMEA0183Time(parserNMEA0183.Zda.UTCTime, parserNMEA0183.Zda.Year,
+			parserNMEA0183.Zda.Month, parserNMEA0183.Zda.Day);
+		if (gpsTime > 0) {
+			gpsClock.AddSample(gpsTime, localTime);
+		}
+	}
+}
+
+// Parse NMEA 0183 RMC sentence for the time and date of the fix
+// $GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A
+void RacingPlugin::HandleRMC(ObservedEvt ev) {
+
+	long long localTime = GpsClock::GetLocalMilliseconds();
+
+	NMEA0183Id id_183_rmc("RMC");
+	NMEA0183 parserNMEA0183;
+	wxString sentence = GetN0183Payload(id_183_rmc, ev);
+	parserNMEA0183 << sentence;
+
+	if (parserNMEA0183.Parse()) {
+		// Only use the time from a valid fix, the date is ddmmyy
+		if ((parserNMEA0183.Rmc.IsDataValid == NTrue) && (parserNMEA0183.Rmc.Date.Length() == 6)) {
+			long day, month, year;
+			if ((parserNMEA0183.Rmc.Date.Mid(0, 2).ToLong(&day)) && (parserNMEA0183.Rmc.Date.Mid(2, 2).ToLong(&month))
+				&& (parserNMEA0183.Rmc.Date.Mid(4, 2).ToLong(&year))) {
+				long long gpsTime = ParseNMEA0183Time(parserNMEA0183.Rmc.UTCTime, 2000 + year, month, day);
+				if (gpsTime > 0) {
+					gpsClock.AddSample(gpsTime, localTime);
+				}
+			}
+		}
+	}
+}
+
+// NMEA 0183 time is hhmmss.ss, optionally with fractional seconds
+long long RacingPlugin::ParseNMEA0183Time(wxString utcTime, int year, int month, int day) {
+
+	double timeValue;
+	if ((utcTime.Length() < 6) || (!utcTime.ToCDouble(&timeValue))) {
+		return 0;
+	}
+	if ((year < 2000) || (month < 1) || (month > 12) || (day < 1) || (day > 31)) {
+		return 0;
+	}
+	int hours = static_cast<int>(timeValue / 10000);
+	int minutes = static_cast<int>(timeValue / 100) % 100;
+	double seconds = timeValue - (hours * 10000) - (minutes * 100);
+	return GpsClock::ToEpochMilliseconds(year, month, day, (hours * 3600) + (minutes * 60) + seconds);
+}
+
+// Parse NMEA 2000 System Time message
+void RacingPlugin::HandleN2K_126992(ObservedEvt ev) {
+
+	long long localTime = GpsClock::GetLocalMilliseconds();
+
+	NMEA2000Id id_126992(126992);
+	std::vector<uint8_t> payload = GetN2000Payload(id_126992, ev);
+	unsigned char sid;
+	uint16_t systemDate; // Days since 1/1/1970
+	double systemTime; // Seconds since midnight
+	tN2kTimeSource timeSource;
+
+	if (ParseN2kPGN126992(payload, sid, systemDate, systemTime, timeSource)) {
+		// Only GPS derived time is accurate enough for the start gun
+		if ((timeSource == tN2kTimeSource::N2ktimes_GPS) && (systemDate != 0xFFFF) && (!N2kIsNA(systemTime))) {
+			gpsClock.AddSample((systemDate * 86400000LL) + static_cast<long long>(systemTime * 1000.0), localTime);
+		}
 	}
 }
 
@@ -834,6 +968,7 @@ void RacingPlugin::HandleN2K_128259(ObservedEvt ev) {
 	if (ParseN2kPGN128259(payload, sid, boatSpeedWaterReferenced, boatSpeedGroundReferenced, waterReferenceType)) {
 		// Convert from m/s to OpenCPN's core units
 		boatSpeed = fromUsrSpeed_Plugin(boatSpeedWaterReferenced, 3);
+		boatSpeedTime = GpsClock::GetLocalMilliseconds();
 	}
 }
 
@@ -869,6 +1004,7 @@ void RacingPlugin::HandleN2K_130306(ObservedEvt ev) {
 		// Convert from m/s and radians to OpenCPN's core units
 		apparentWindSpeed = fromUsrSpeed_Plugin(windSpeed, 3);
 		apparentWindAngle = windAngle * 180 / M_PI;
+		apparentWindTime = GpsClock::GetLocalMilliseconds();
 	}
 }
 
@@ -1048,6 +1184,7 @@ void RacingPlugin::HandleSKItem(wxJSONValue& item) {
 			}
 			if (update_path == "environment.wind.speedApparent") {
 				apparentWindSpeed = fromUsrSpeed_Plugin(value.AsDouble(), 3);
+				apparentWindTime = GpsClock::GetLocalMilliseconds();
 			}
 			if (update_path == "environment.depth.belowTransducer") {
 				// Following depends on PR #4098
@@ -1058,41 +1195,232 @@ void RacingPlugin::HandleSKItem(wxJSONValue& item) {
 		else if (update_path.StartsWith("navigation")) {
 			if (update_path == "navigation.speedThroughWater") {
 				boatSpeed = fromUsrSpeed_Plugin(value.AsDouble(), 3);
+				boatSpeedTime = GpsClock::GetLocalMilliseconds();
 			}
 		}
 	}
 }
 
 // Generate NMEA 0183 MWV sentence with True Wind
-void RacingPlugin::GenerateTrueWindSentence(void) {
+bool RacingPlugin::GenerateTrueWindSentence(void) {
 
-	wxString sentence;
 	// Generate the MWV sentence
-	sentence = wxString::Format("$IIMWV,%.2f,T,%.2f,N,A", trueWindAngle, trueWindSpeed);
-	// Append the checksum
-	wxString checksum = ComputeChecksum(sentence);
-	sentence.Append("*");
-	sentence.Append(checksum);
-	sentence.Append("\r\n");
-	// Transmit the NMEA 0183 sentence, the "old" method
-	PushNMEABuffer(sentence);
+	sentenceBuilder.Begin("II", "MWV");
+	sentenceBuilder.AddField(trueWindAngle, 2);
+	sentenceBuilder.AddField('T');
+	sentenceBuilder.AddField(trueWindSpeed, 2);
+	sentenceBuilder.AddField('N');
+	sentenceBuilder.AddField((isnan(trueWindAngle)) || (isnan(trueWindSpeed)) ? 'V' : 'A');
+	if (sentenceBuilder.End()) {
+		return SendNMEA0183(sentenceBuilder);
+	}
+	return false;
+}
+
+// Generate NMEA 0183 VPW sentence with the Velocity Made Good to windward
+bool RacingPlugin::GenerateVelocityMadeGoodSentence(void) {
+
+	sentenceBuilder.Begin("II", "VPW");
+	sentenceBuilder.AddField(derivedData.velocityMadeGood, 2);
+	sentenceBuilder.AddField('N');
+	sentenceBuilder.AddField(toUsrSpeed_Plugin(derivedData.velocityMadeGood, 3), 2);
+	sentenceBuilder.AddField('M');
+	return (sentenceBuilder.End()) && (SendNMEA0183(sentenceBuilder));
+}
+
+// Generate NMEA 0183 VDR sentence with the Set & Drift of the current
+bool RacingPlugin::GenerateDriftSentence(void) {
+
+	sentenceBuilder.Begin("II", "VDR");
+	sentenceBuilder.AddField(derivedData.setTrue, 1);
+	sentenceBuilder.AddField('T');
+	sentenceBuilder.AddField(derivedData.setMagnetic, 1);
+	sentenceBuilder.AddField('M');
+	sentenceBuilder.AddField(derivedData.drift, 2);
+	sentenceBuilder.AddField('N');
+	return (sentenceBuilder.End()) && (SendNMEA0183(sentenceBuilder));
+}
+
+// Generate NMEA 0183 XDR sentence with the target boat speed (knots) and percentage of the target achieved.
+// There are no transducer types for speed or percentages, so generic transducers are used
+bool RacingPlugin::GeneratePerformanceSentence(void) {
+
+	sentenceBuilder.Begin("II", "XDR");
+	sentenceBuilder.AddField('G');
+	sentenceBuilder.AddField(derivedData.targetSpeed, 2);
+	sentenceBuilder.AddEmptyField();
+	sentenceBuilder.AddField("TGTSPD");
+	sentenceBuilder.AddField('G');
+	sentenceBuilder.AddField(derivedData.polarPercentage, 1);
+	sentenceBuilder.AddEmptyField();
+	sentenceBuilder.AddField("POLAR");
+	return (sentenceBuilder.End()) && (SendNMEA0183(sentenceBuilder));
+}
+
+// Generate NMEA 0183 XDR sentence with the distance (metres) and time (seconds) to the start line,
+// and the time to burn (seconds)
+bool RacingPlugin::GenerateStartSentence(void) {
+
+	sentenceBuilder.Begin("II", "XDR");
+	sentenceBuilder.AddField('D');
+	sentenceBuilder.AddField(derivedData.lineDistance, 1);
+	sentenceBuilder.AddField('M');
+	sentenceBuilder.AddField("LINEDIST");
+	sentenceBuilder.AddField('G');
+	sentenceBuilder.AddField(derivedData.timeToLine, 0);
+	sentenceBuilder.AddEmptyField();
+	sentenceBuilder.AddField("LINETIME");
+	sentenceBuilder.AddField('G');
+	sentenceBuilder.AddField(derivedData.timeToBurn, 0);
+	sentenceBuilder.AddEmptyField();
+	sentenceBuilder.AddField("BURN");
+	return (sentenceBuilder.End()) && (SendNMEA0183(sentenceBuilder));
+}
+
+// Transmit a sentence to OpenCPN and onto the NMEA 0183 connection
+bool RacingPlugin::SendNMEA0183(const SentenceBuilder& sentence) {
+	// The "old" method, which only accepts a wxString
+	PushNMEABuffer(wxString::FromAscii(sentence.GetData(), sentence.GetLength()));
+
+	// Our own server, sent when the output timer's tick is complete
+	nmeaServer.Append(sentence.GetData(), sentence.GetLength());
+
 	// The "new" method
 	if (!n183NetworkHandle.empty()) {
-		SendNMEA0183(sentence);
+		CommDriverResult result = WriteCommDriver(n183NetworkHandle, n183Payloads.Get(sentence.GetData(), sentence.GetLength()));
+		// Only failures are logged, as formatting every sentence for the log would cost more than building it
+		if (result != RESULT_COMM_NO_ERROR) {
+			wxLogMessage(_T("Racing Plugin, Send NMEA 0183 %s, %s, %d"), n183NetworkHandle.c_str(),
+				wxString::FromAscii(sentence.GetData(), sentence.GetLength()), result);
+			return false;
+		}
 	}
+	return true;
 }
 
-// Transmit onto NMEA 0183 connection
-void RacingPlugin::SendNMEA0183(wxString sentence) {
-	CommDriverResult result;
-	std::vector<uint8_t> payload;
-	for (size_t i = 0; i < sentence.length(); i++) {
-		payload.push_back(sentence.at(i));
+// Publish the values shown by the Countdown Timer and the "Wind Wizard" gauge to the live data page.
+// Speeds in knots, angles in degrees, distances in metres and times in seconds
+bool RacingPlugin::PublishLiveData(void) {
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	long long now = GpsClock::GetLocalMilliseconds();
+	bool isWindCurrent = IsInputCurrent(apparentWindTime, now);
+	bool isBoatSpeedCurrent = IsInputCurrent(boatSpeedTime, now);
+	bool isNavigationCurrent = IsInputCurrent(navigationTime, now);
+	bool isTrueWindCurrent = (isWindCurrent) && (isBoatSpeedCurrent);
+	// The window may be shown without a countdown having been started
+	double secondsToGun = isCountdownTimerVisible ? racingWindow->GetSecondsToGun() : nan;
+
+	liveDataWriter.Begin();
+	liveDataWriter.AddField("secondsToGun", secondsToGun, 1);
+	liveDataWriter.AddField("lineDistance", derivedData.lineDistance, 1);
+	liveDataWriter.AddField("timeToLine", derivedData.timeToLine, 0);
+	liveDataWriter.AddField("timeToBurn", derivedData.timeToBurn, 0);
+	liveDataWriter.AddField("percentOver", ocsPrediction.isValid ? ocsPrediction.probabilityOver * 100.0 : nan, 0);
+	liveDataWriter.AddField("trueWindSpeed", isTrueWindCurrent ? trueWindSpeed : nan, 1);
+	liveDataWriter.AddField("trueWindAngle", isTrueWindCurrent ? trueWindAngle : nan, 0);
+	liveDataWriter.AddField("trueWindDirection", (isTrueWindCurrent) && (isNavigationCurrent) ? trueWindDirection : nan, 0);
+	liveDataWriter.AddField("apparentWindSpeed", isWindCurrent ? apparentWindSpeed : nan, 1);
+	liveDataWriter.AddField("apparentWindAngle", isWindCurrent ? apparentWindAngle : nan, 0);
+	liveDataWriter.AddField("boatSpeed", isBoatSpeedCurrent ? boatSpeed : nan, 1);
+	liveDataWriter.AddField("targetSpeed", derivedData.targetSpeed, 1);
+	liveDataWriter.AddField("polarPercentage", derivedData.polarPercentage, 0);
+	liveDataWriter.AddField("velocityMadeGood", isTrueWindCurrent ? derivedData.velocityMadeGood : nan, 1);
+	liveDataWriter.AddField("speedOverGround", isNavigationCurrent ? speedOverGround : nan, 1);
+	liveDataWriter.AddField("courseOverGround", isNavigationCurrent ? courseOverGround : nan, 0);
+	liveDataWriter.AddField("heading", isNavigationCurrent ? headingTrue : nan, 0);
+	liveDataWriter.AddField("set", derivedData.setTrue, 0);
+	liveDataWriter.AddField("drift", derivedData.drift, 1);
+	liveDataWriter.AddField("isCountdownRunning", !isnan(secondsToGun));
+	liveDataWriter.End();
+
+	liveDataServer.Publish(liveDataWriter.GetText());
+	return true;
+}
+
+// Publish the values we calculate as a SignalK delta. SignalK uses SI units, speeds in metres/second,
+// angles in radians and distances in metres
+bool RacingPlugin::PublishSignalKDelta(void) {
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	const double knotsToMetresPerSecond = 1852.0 / 3600.0;
+	const double degreesToRadians = M_PI / 180.0;
+	long long now = GpsClock::GetLocalMilliseconds();
+	bool isTrueWindCurrent = (IsInputCurrent(apparentWindTime, now)) && (IsInputCurrent(boatSpeedTime, now));
+	bool isNavigationCurrent = IsInputCurrent(navigationTime, now);
+
+	// SignalK uses +/- Pi for the wind angle
+	double windAngle = trueWindAngle > 180.0 ? trueWindAngle - 360.0 : trueWindAngle;
+	signalKDelta.Set(SIGNALK_WIND_SPEED_TRUE, isTrueWindCurrent ? trueWindSpeed * knotsToMetresPerSecond : nan);
+	signalKDelta.Set(SIGNALK_WIND_ANGLE_TRUE, isTrueWindCurrent ? windAngle * degreesToRadians : nan);
+	signalKDelta.Set(SIGNALK_WIND_DIRECTION_TRUE, (isTrueWindCurrent) && (isNavigationCurrent) ? trueWindDirection * degreesToRadians : nan);
+	signalKDelta.Set(SIGNALK_VMG, isTrueWindCurrent ? derivedData.velocityMadeGood * knotsToMetresPerSecond : nan);
+	signalKDelta.Set(SIGNALK_TARGET_SPEED, derivedData.targetSpeed * knotsToMetresPerSecond);
+	signalKDelta.Set(SIGNALK_POLAR_RATIO, derivedData.polarPercentage / 100.0);
+	signalKDelta.Set(SIGNALK_LINE_DISTANCE, derivedData.lineDistance);
+	signalKDelta.Set(SIGNALK_TIME_TO_START, isCountdownTimerVisible ? racingWindow->GetSecondsToGun() : nan);
+	signalKDelta.Set(SIGNALK_TIME_TO_LINE, derivedData.timeToLine);
+	signalKDelta.Set(SIGNALK_TIME_TO_BURN, derivedData.timeToBurn);
+	const LineBias& bias = startLineBias.GetBias();
+	signalKDelta.Set(SIGNALK_LINE_BIAS, bias.isValid ? bias.biasAngle * degreesToRadians : nan);
+	signalKDelta.Set(SIGNALK_SET_TRUE, derivedData.setTrue * degreesToRadians);
+	signalKDelta.Set(SIGNALK_SET_MAGNETIC, derivedData.setMagnetic * degreesToRadians);
+	signalKDelta.Set(SIGNALK_DRIFT, derivedData.drift * knotsToMetresPerSecond);
+
+	// Time stamped with GPS time once it is known
+	long long utcMilliseconds = gpsClock.IsSynchronised() ? gpsClock.GetUTCMilliseconds() : wxGetUTCTimeMillis().GetValue();
+	if (!signalKDelta.Write(utcMilliseconds)) {
+		// Nothing has changed
+		return true;
 	}
 
-	auto sharedPointer = std::make_shared<std::vector<uint8_t> >(std::move(payload));
-	result = WriteCommDriver(n183NetworkHandle, sharedPointer);
-	wxLogMessage(_T("Racing Plugin, Debug, Send NMEA 0183 %s, %s, %d"), n183NetworkHandle.c_str(), sentence, result);
+	const std::string& delta = signalKDelta.GetDelta();
+	SendPluginMessage("RACING_SIGNALK_DELTA", wxString::FromUTF8(delta.data(), delta.size()));
+	liveDataServer.PublishDelta(delta);
+	return true;
+}
+
+// Write the fused state to shared memory, in OpenCPN's core units
+bool RacingPlugin::PublishSharedMemory(void) {
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	long long now = GpsClock::GetLocalMilliseconds();
+	bool isWindCurrent = IsInputCurrent(apparentWindTime, now);
+	bool isBoatSpeedCurrent = IsInputCurrent(boatSpeedTime, now);
+	bool isNavigationCurrent = IsInputCurrent(navigationTime, now);
+	bool isTrueWindCurrent = (isWindCurrent) && (isBoatSpeedCurrent);
+
+	SharedSample sample;
+	sample.utcMilliseconds = gpsClock.IsSynchronised() ? gpsClock.GetUTCMilliseconds() : wxGetUTCTimeMillis().GetValue();
+	sample.latitude = isNavigationCurrent ? currentLatitude : nan;
+	sample.longitude = isNavigationCurrent ? currentLongitude : nan;
+	sample.courseOverGround = isNavigationCurrent ? courseOverGround : nan;
+	sample.speedOverGround = isNavigationCurrent ? speedOverGround : nan;
+	sample.headingTrue = isNavigationCurrent ? headingTrue : nan;
+	sample.headingMagnetic = isNavigationCurrent ? headingMagnetic : nan;
+	sample.boatSpeed = isBoatSpeedCurrent ? boatSpeed : nan;
+	sample.waterDepth = waterDepth;
+	sample.apparentWindAngle = isWindCurrent ? apparentWindAngle : nan;
+	sample.apparentWindSpeed = isWindCurrent ? apparentWindSpeed : nan;
+	sample.trueWindAngle = isTrueWindCurrent ? trueWindAngle : nan;
+	sample.trueWindSpeed = isTrueWindCurrent ? trueWindSpeed : nan;
+	sample.trueWindDirection = (isTrueWindCurrent) && (isNavigationCurrent) ? trueWindDirection : nan;
+	sample.velocityMadeGood = isTrueWindCurrent ? derivedData.velocityMadeGood : nan;
+	sample.targetSpeed = derivedData.targetSpeed;
+	sample.polarPercentage = derivedData.polarPercentage;
+	sample.setTrue = derivedData.setTrue;
+	sample.drift = derivedData.drift;
+	sample.secondsToGun = isCountdownTimerVisible ? racingWindow->GetSecondsToGun() : nan;
+	sample.lineDistance = derivedData.lineDistance;
+	sample.timeToLine = derivedData.timeToLine;
+	sample.timeToBurn = derivedData.timeToBurn;
+	sample.probabilityOver = ocsPrediction.isValid ? ocsPrediction.probabilityOver : nan;
+	const LineBias& bias = startLineBias.GetBias();
+	sample.lineBias = bias.isValid ? bias.biasAngle : nan;
+
+	sharedMemory.Write(sample);
+	return true;
+}
+
+bool RacingPlugin::IsInputCurrent(long long inputTime, long long now) {
+	return (inputTime > 0) && (now - inputTime <= MAXIMUM_INPUT_AGE);
 }
 
 // FYI Note that the payload for PluginMessaging consists of id<space>message
@@ -1112,36 +1440,208 @@ void RacingPlugin::SendOCPNMessage(PluginMsgId msg_id, wxString message) {
 }
 
 // Generate NMEA 2000 PGN 130306 message with True Wind
-void RacingPlugin::GenerateTrueWindMessage(void) {
+bool RacingPlugin::GenerateTrueWindMessage(void) {
+
+	tN2kMsg N2kMsg;
+	// Convert from OpenCPN's core units to m/s and radians
+	SetN2kWindSpeed(N2kMsg, n2kSequenceId, toUsrSpeed_Plugin(trueWindSpeed, 3), trueWindAngle * M_PI / 180.0f,
+		tN2kWindReference::N2kWind_True_boat);
+	return SendNMEA2000(N2kMsg);
+}
+
+// Generate NMEA 2000 PGN 130306 message with True Wind Direction
+bool RacingPlugin::GenerateTrueWindDirectionMessage(void) {
+
+	if (isnan(trueWindDirection)) {
+		return false;
+	}
 
 	tN2kMsg N2kMsg;
-	// Only Transmit if we have a valid NMEA 2000 connection
-	if (!n2kNetworkHandle.empty()) {
-		SetN2kWindSpeed(N2kMsg, 1, trueWindSpeed, trueWindAngle, tN2kWindReference::N2kWind_True_boat);
-		std::vector<uint8_t> payload(N2kMsg.Data, N2kMsg.Data + N2kMsg.GetAvailableDataLength());
-		auto sharedPointer = std::make_shared<std::vector<uint8_t>>(payload);
-		WriteCommDriverN2K(n2kNetworkHandle, 130306, 255, 5, sharedPointer);
+	double direction = trueWindDirection < 0.0f ? trueWindDirection + 360.0f : trueWindDirection;
+	SetN2kWindSpeed(N2kMsg, n2kSequenceId, toUsrSpeed_Plugin(trueWindSpeed, 3), direction * M_PI / 180.0f,
+		tN2kWindReference::N2kWind_True_North);
+	return SendNMEA2000(N2kMsg);
+}
+
+// Generate NMEA 2000 PGN 130577 Direction Data with the Set & Drift of the current
+bool RacingPlugin::GenerateDriftMessage(void) {
+
+	CalculateDrift();
+	if ((isnan(driftAngle)) || (isnan(driftSpeed))) {
+		return false;
 	}
+
+	tN2kMsg N2kMsg;
+	// Set & Drift are calculated, rather than measured, hence estimated
+	SetN2kDirectionData(N2kMsg, N2kDD_Estimated, N2khr_true, n2kSequenceId,
+		courseOverGround * M_PI / 180.0f, toUsrSpeed_Plugin(speedOverGround, 3),
+		headingTrue * M_PI / 180.0f, toUsrSpeed_Plugin(boatSpeed, 3),
+		driftAngle * M_PI / 180.0f, toUsrSpeed_Plugin(driftSpeed, 3));
+	return SendNMEA2000(N2kMsg);
 }
 
-// Generate the NMEA 0183 XOR checksum to be appended to an NMEA 0183 sentence
-wxString RacingPlugin::ComputeChecksum(wxString sentence) {
+// Plugins need to register what NMEA 2000 PGN's they transmit. This is required for
+// Actisense NGT-1 Adapters, presumably results in a null operation (NOP) for other interfaces
+void RacingPlugin::RegisterTransmittedPGNs(void) {
+	if (n2kNetworkHandle.empty()) {
+		return;
+	}
+	std::vector<int> transmittedPGN;
+	if (generatePGN130306) {
+		transmittedPGN.push_back(130306);
+	}
+	if (generatePGN130577) {
+		transmittedPGN.push_back(130577);
+	}
+	if (!transmittedPGN.empty()) {
+		RegisterTXPGNs(n2kNetworkHandle, transmittedPGN);
+	}
+}
 
-	unsigned char calculatedChecksum = 0;
-	for (wxString::const_iterator it = sentence.begin() + 1; it != sentence.end(); ++it) {
-		calculatedChecksum ^= static_cast<unsigned char> (*it);
+// Transmit onto the NMEA 2000 connection, broadcast with the message's default priority
+bool RacingPlugin::SendNMEA2000(const tN2kMsg& N2kMsg) {
+	CommDriverResult result = WriteCommDriverN2K(n2kNetworkHandle, N2kMsg.PGN, 255, N2kMsg.Priority,
+		n2kPayloads.Get(N2kMsg.Data, N2kMsg.DataLen));
+	if (result != RESULT_COMM_NO_ERROR) {
+		wxLogMessage(_T("Racing Plugin, Send NMEA 2000 %s, PGN: %lu, %d"), n2kNetworkHandle.c_str(), N2kMsg.PGN, result);
+		return false;
 	}
-	return(wxString::Format("%02X", calculatedChecksum));
+	return true;
 }
 
-// Update the "Wind Wizard" every second and generate True Wind messages/sentences
+// Send any generated messages that are due
+void RacingPlugin::OnOutputTimer(wxTimerEvent& event) {
+	outputScheduler.SetEnabled(OUTPUT_MWV, generateMWVSentence);
+	outputScheduler.SetEnabled(OUTPUT_PGN130306, (generatePGN130306) && (!n2kNetworkHandle.empty()));
+	outputScheduler.SetEnabled(OUTPUT_PGN130306_TRUE_NORTH, (generatePGN130306) && (!n2kNetworkHandle.empty()));
+	outputScheduler.SetEnabled(OUTPUT_PGN130577, (generatePGN130577) && (!n2kNetworkHandle.empty()));
+	outputScheduler.SetEnabled(OUTPUT_VPW, generateVPWSentence);
+	outputScheduler.SetEnabled(OUTPUT_VDR, generateVDRSentence);
+	outputScheduler.SetEnabled(OUTPUT_XDR_PERFORMANCE, generateXDRSentences);
+	// Only once both ends of the start line have been pinged
+	outputScheduler.SetEnabled(OUTPUT_XDR_START, (generateXDRSentences) && (ocsPrediction.isValid));
+	outputScheduler.SetEnabled(OUTPUT_LIVE_DATA, liveDataServer.IsRunning());
+	outputScheduler.SetEnabled(OUTPUT_SIGNALK, generateSignalKDeltas);
+	outputScheduler.SetEnabled(OUTPUT_SHARED_MEMORY, sharedMemory.IsOpen());
+
+	long long now = GpsClock::GetLocalMilliseconds();
+	const std::vector<int>& due = outputScheduler.GetDue(now);
+	if (due.empty()) {
+		return;
+	}
+
+	// Use the latest inputs, which may have arrived since the one second timer
+	CalculateTrueWind();
+	n2kSequenceId = (n2kSequenceId + 1) % 253;
+
+	for (int output : due) {
+		if (!outputScheduler.IsFresh(output, GetOutputInputTime(output), now)) {
+			continue;
+		}
+		if (SendOutput(output)) {
+			outputScheduler.CountSent(output);
+		}
+		else {
+			outputScheduler.CountDropped(output);
+		}
+	}
+
+	// The sentences sent on this tick are served to every client as a single block
+	nmeaServer.Flush();
+}
+
+long long RacingPlugin::GetOutputInputTime(int output) {
+	switch (output) {
+	case OUTPUT_MWV:
+	case OUTPUT_PGN130306:
+		// True wind is derived from both the apparent wind and the boat speed
+		return std::min(apparentWindTime, boatSpeedTime);
+	case OUTPUT_PGN130306_TRUE_NORTH:
+		// and its direction from the heading
+		return std::min(std::min(apparentWindTime, boatSpeedTime), navigationTime);
+	case OUTPUT_PGN130577:
+	case OUTPUT_VDR:
+		// Set & drift are the difference between the course & speed over ground and through the water
+		return std::min(boatSpeedTime, navigationTime);
+	case OUTPUT_VPW:
+	case OUTPUT_XDR_PERFORMANCE:
+		return std::min(apparentWindTime, boatSpeedTime);
+	case OUTPUT_XDR_START:
+		return navigationTime;
+	case OUTPUT_LIVE_DATA:
+	case OUTPUT_SIGNALK:
+	case OUTPUT_SHARED_MEMORY:
+		// Always published, as it includes the countdown. Values from stale inputs are sent as null
+		return GpsClock::GetLocalMilliseconds();
+	default:
+		return 0;
+	}
+}
+
+bool RacingPlugin::SendOutput(int output) {
+	switch (output) {
+	case OUTPUT_MWV:
+		return GenerateTrueWindSentence();
+	case OUTPUT_PGN130306:
+		return GenerateTrueWindMessage();
+	case OUTPUT_PGN130306_TRUE_NORTH:
+		return GenerateTrueWindDirectionMessage();
+	case OUTPUT_PGN130577:
+		return GenerateDriftMessage();
+	case OUTPUT_VPW:
+		return GenerateVelocityMadeGoodSentence();
+	case OUTPUT_VDR:
+		return GenerateDriftSentence();
+	case OUTPUT_XDR_PERFORMANCE:
+		return GeneratePerformanceSentence();
+	case OUTPUT_XDR_START:
+		return GenerateStartSentence();
+	case OUTPUT_LIVE_DATA:
+		return PublishLiveData();
+	case OUTPUT_SIGNALK:
+		return PublishSignalKDelta();
+	case OUTPUT_SHARED_MEMORY:
+		return PublishSharedMemory();
+	default:
+		return false;
+	}
+}
+
+// Update the "Wind Wizard" every second. True Wind messages/sentences are sent by the output scheduler
 // BUG BUG This is where a pub/sub model would be interesting....
 void RacingPlugin::OnTimerElapsed(wxTimerEvent& ev) {
 
 	if (oneSecondTimer->IsRunning()) {
+		// Complete any pings for which position fixes have stopped arriving
+		long long now = GpsClock::GetLocalMilliseconds();
+		if (starboardSampler.IsElapsed(now)) {
+			CompletePing(RACE_DIALOG_STBD);
+		}
+		if (portSampler.IsElapsed(now)) {
+			CompletePing(RACE_DIALOG_PORT);
+		}
+
 		CalculateTrueWind();
 		CalculateDrift();
+		UpdateDerivedData();
+
+		// Update the rolling mean wind direction, the bias is only recalculated if the wind has shifted
+		if ((!isnan(trueWindDirection)) && (!isnan(headingTrue)) && (trueWindSpeed > 0.0)) {
+			if (startLineBias.AddWindSample(now, trueWindDirection)) {
+				UpdateStartLineBias();
+			}
+		}
+
+		// Learn the target boat speed for the current wind, but not from a frozen log or lost wind.
+		// How close to it we are sailing colours the track, added as each fix arrives
+		if ((IsInputCurrent(apparentWindTime, now)) && (IsInputCurrent(boatSpeedTime, now))) {
+			trackEfficiency = performanceTargets.Update(trueWindSpeed, trueWindAngle, boatSpeed);
+		}
+		else {
+			trackEfficiency = std::numeric_limits<double>::quiet_NaN();
+		}
 		if (windWizard != nullptr) {
+			windWizard->SetSpeedUnits(getUsrSpeedUnit_Plugin(), toUsrSpeed_Plugin(1.0));
 			windWizard->SetTrueWindAngle(trueWindAngle);
 			windWizard->SetTrueWindSpeed(trueWindSpeed);
 			windWizard->SetApparentWindAngle(apparentWindAngle);
@@ -1153,25 +1653,25 @@ void RacingPlugin::OnTimerElapsed(wxTimerEvent& ev) {
 			windWizard->SetCOG(courseOverGround);
 			windWizard->SetSOG(speedOverGround);
 			// BUG BUG Ideological question; VMG or CMG
-			windWizard->SetVMG(boatSpeed * cos(trueWindAngle));
+			windWizard->SetVMG(derivedData.velocityMadeGood);
 			// course made good = boatSpeed * cos(headingTrue - headingMagnetic); 
 			windWizard->SetDriftAngle(driftAngle);
 			windWizard->SetDriftSpeed(driftSpeed);
+			windWizard->ShowStartPrediction(ocsPrediction.isValid && !isnan(ocsPrediction.timeToGun));
+			windWizard->SetStartPrediction(ocsPrediction.timeToBurn, ocsPrediction.probabilityOver);
 			windWizard->ShowBearing(isWaypointActive);
 			if (isWaypointActive) {
 				windWizard->SetBearing(waypointBearing);
 			}
 
-			// Update the Gauge
-			windWizard->Refresh();
+			// Repaint only what has changed
+			windWizard->UpdateDisplay();
 		}
 
-		// Generate NMEA 0183 and NMEA 2000 True Wind Messages
-		if (generateMWVSentence) {
-			GenerateTrueWindSentence();
-		}
-		if (generatePGN130306) {
-			GenerateTrueWindMessage();
+		// The strip chart draws a single new column for each sample
+		if ((windHistory != nullptr) && (!isnan(headingTrue))) {
+			windHistory->SetSpeedUnits(getUsrSpeedUnit_Plugin(), toUsrSpeed_Plugin(1.0));
+			windHistory->AddSample(trueWindDirection, trueWindSpeed);
 		}
 	}
 	// Every second could also take a screen capture
@@ -1212,11 +1712,40 @@ void RacingPlugin::LoadSettings(void) {
 		configSettings->Read("StartLineBias", &showStartline, false);
 		configSettings->Read("Laylines", &showLayLines, false);
 		configSettings->Read("WindAngles", &showWindAngles, false);
+		configSettings->Read("PerformanceTrack", &showPerformanceTrack, false);
 		configSettings->Read("DualCanvas", &showMultiCanvas, false);
 		configSettings->Read("StartTimer", &defaultTimerValue, 300);
+		configSettings->Read("PingDuration", &pingDuration, 5);
+		configSettings->Read("AntennaForeAft", &antennaForeAft, 0.0);
+		configSettings->Read("AntennaAthwartships", &antennaAthwartships, 0.0);
+		configSettings->Read("GaugeFrameRate", &gaugeFrameRate, 20);
 		configSettings->Read("Visible", &isWindWizardVisible, false);
+		configSettings->Read("HistoryVisible", &isWindHistoryVisible, false);
+		configSettings->Read("HistoryWindow", &historyWindow, 20);
 		configSettings->Read("SendNMEA2000Wind", &generatePGN130306, false);
 		configSettings->Read("SendNMEA0183Wind", &generateMWVSentence, false);
+		configSettings->Read("SendNMEA2000Drift", &generatePGN130577, false);
+		configSettings->Read("SendNMEA0183VMG", &generateVPWSentence, false);
+		configSettings->Read("SendNMEA0183Drift", &generateVDRSentence, false);
+		configSettings->Read("SendNMEA0183Performance", &generateXDRSentences, false);
+		// 10110 is the conventional port for NMEA 0183 over TCP & UDP
+		configSettings->Read("ServerEnabled", &isServerEnabled, false);
+		configSettings->Read("ServerTCPPort", &serverTcpPort, 10110);
+		configSettings->Read("ServerUDPAddress", &serverUdpAddress, "255.255.255.255");
+		configSettings->Read("ServerUDPPort", &serverUdpPort, 10110);
+		configSettings->Read("SendSignalK", &generateSignalKDeltas, false);
+		configSettings->Read("SharedMemoryEnabled", &isSharedMemoryEnabled, false);
+		configSettings->Read("SharedMemoryName", &sharedMemoryName, SHARED_DEFAULT_NAME);
+		configSettings->Read("LiveDataEnabled", &isLiveDataEnabled, false);
+		configSettings->Read("LiveDataPort", &liveDataPort, 8080);
+		// Interval (milliseconds) and priority of each generated message, eg. MWVInterval, MWVPriority
+		for (int i = 0; i < outputScheduler.GetCount(); i++) {
+			int interval, priority;
+			configSettings->Read(outputScheduler.GetName(i) + "Interval", &interval, outputScheduler.GetInterval(i));
+			configSettings->Read(outputScheduler.GetName(i) + "Priority", &priority, outputScheduler.GetPriority(i));
+			outputScheduler.SetInterval(i, interval);
+			outputScheduler.SetPriority(i, priority);
+		}
 		// Get the length of OpenCPN's Ship's Heading Predictor Length
 		// It is used for determining the length of the apparent wind arrow on the canvas
 		configSettings->SetPath("Settings");
@@ -1234,10 +1763,37 @@ void RacingPlugin::SaveSettings(void) {
 		configSettings->Write("Laylines", showLayLines);
 		configSettings->Write("DualCanvas", showMultiCanvas);
 		configSettings->Write("WindAngles", showWindAngles);
+		configSettings->Write("PerformanceTrack", showPerformanceTrack);
 		configSettings->Write("StartTimer", defaultTimerValue);
+		configSettings->Write("PingDuration", pingDuration);
+		configSettings->Write("AntennaForeAft", antennaForeAft);
+		configSettings->Write("AntennaAthwartships", antennaAthwartships);
+		configSettings->Write("GaugeFrameRate", gaugeFrameRate);
 		configSettings->Write("Visible", isWindWizardVisible);
+		configSettings->Write("HistoryVisible", isWindHistoryVisible);
+		if (windHistory != nullptr) {
+			historyWindow = windHistory->GetWindow();
+		}
+		configSettings->Write("HistoryWindow", historyWindow);
 		configSettings->Write("SendNMEA2000Wind", generatePGN130306);
 		configSettings->Write("SendNMEA0183Wind", generateMWVSentence);
+		configSettings->Write("SendNMEA2000Drift", generatePGN130577);
+		configSettings->Write("SendNMEA0183VMG", generateVPWSentence);
+		configSettings->Write("SendNMEA0183Drift", generateVDRSentence);
+		configSettings->Write("SendNMEA0183Performance", generateXDRSentences);
+		configSettings->Write("ServerEnabled", isServerEnabled);
+		configSettings->Write("ServerTCPPort", serverTcpPort);
+		configSettings->Write("ServerUDPAddress", serverUdpAddress);
+		configSettings->Write("ServerUDPPort", serverUdpPort);
+		configSettings->Write("SendSignalK", generateSignalKDeltas);
+		configSettings->Write("SharedMemoryEnabled", isSharedMemoryEnabled);
+		configSettings->Write("SharedMemoryName", sharedMemoryName);
+		configSettings->Write("LiveDataEnabled", isLiveDataEnabled);
+		configSettings->Write("LiveDataPort", liveDataPort);
+		for (int i = 0; i < outputScheduler.GetCount(); i++) {
+			configSettings->Write(outputScheduler.GetName(i) + "Interval", outputScheduler.GetInterval(i));
+			configSettings->Write(outputScheduler.GetName(i) + "Priority", outputScheduler.GetPriority(i));
+		}
 	}
 }
 
@@ -1248,50 +1804,234 @@ void RacingPlugin::OnDialogEvent(wxCommandEvent& event) {
 
 	// Keep the toolbar & canvas in sync with the display of the Countdown Timer dialog
 	case RACE_DIALOG_CLOSED:
+		starboardSampler.Cancel();
+		portSampler.Cancel();
+		ocsPredictor.ClearStartLine();
+		ocsPrediction = ocsPredictor.GetPrediction();
+		startLineBias.ClearStartLine();
 		if (!starboardMarkGuid.IsEmpty()) {
 			DeleteSingleWaypoint(starboardMarkGuid);
+			starboardMarkGuid.Clear();
 		}
 		if (!portMarkGuid.IsEmpty()) {
 			DeleteSingleWaypoint(portMarkGuid);
+			portMarkGuid.Clear();
 		}
 
 		isCountdownTimerVisible = false;
 		SetToolbarItemState(racingToolbarId, isCountdownTimerVisible);
 		break;
 
-		// Drop temporary waypoints to represent port & starboard ends of the start line
-		// Waypoint icons are found in \uidata\markicons
-	case RACE_DIALOG_STBD: {
-		PlugIn_Waypoint waypoint;
-		waypoint.m_IsVisible = true;
-		waypoint.m_MarkName = "Starboard";
-		waypoint.m_IconName = "Marks-Race-Committee-Start-Boat";
-		starboardMarkGuid = GetNewGUID();
-		waypoint.m_GUID = starboardMarkGuid;
-		waypoint.m_lat = currentLatitude; 
-		waypoint.m_lon = currentLongitude;
-		starboardMarkLatitude = currentLatitude;
-		starboardMarkLongitude = currentLongitude;
-		AddSingleWaypoint(&waypoint, false);
+		// Ping the port & starboard ends of the start line
+	case RACE_DIALOG_STBD: 
+	case RACE_DIALOG_PORT:
+		StartPing(event.GetId());
 		break;
+
+	default:
+		event.Skip();
+	}
+}
+
+// Start averaging position fixes for one end of the start line
+void RacingPlugin::StartPing(int markId) {
+
+	MarkSampler& sampler = (markId == RACE_DIALOG_PORT) ? portSampler : starboardSampler;
+	long long now = GpsClock::GetLocalMilliseconds();
+	sampler.Start(pingDuration * 1000LL, now);
+	// Include the current position, so that a zero duration ping is just the current fix
+	sampler.AddSample(bowLatitude, bowLongitude, now);
+	if (pingDuration == 0) {
+		CompletePing(markId);
+	}
+}
+
+// Calculate the averaged position of the mark and update the waypoint and Countdown Timer
+void RacingPlugin::CompletePing(int markId) {
+
+	MarkSampler& sampler = (markId == RACE_DIALOG_PORT) ? portSampler : starboardSampler;
+	double latitude = bowLatitude;
+	double longitude = bowLongitude;
+	double confidenceRadius = 0.0;
+
+	if (sampler.Finish()) {
+		latitude = sampler.GetLatitude();
+		longitude = sampler.GetLongitude();
+		confidenceRadius = sampler.GetConfidenceRadius();
 	}
-	case RACE_DIALOG_PORT: {
-		PlugIn_Waypoint waypoint;
-		waypoint.m_IsVisible = true;
+
+	wxLogMessage("Racing Plugin, Ping %s, %d samples, %d rejected, radius %.1f m", 
+		markId == RACE_DIALOG_PORT ? "Port" : "Starboard", sampler.GetSampleCount(), 
+		sampler.GetRejectedCount(), confidenceRadius);
+
+	UpdateStartLineMark(markId, latitude, longitude, confidenceRadius, sampler.GetSampleCount());
+
+	if (isCountdownTimerVisible) {
+		if (markId == RACE_DIALOG_PORT) {
+			racingWindow->SetPortMark(latitude, longitude, confidenceRadius);
+		}
+		else {
+			racingWindow->SetStarboardMark(latitude, longitude, confidenceRadius);
+		}
+	}
+}
+
+// Drop temporary waypoints to represent port & starboard ends of the start line
+// Waypoint icons are found in \uidata\markicons
+// Subsequent pings move the existing waypoint rather than deleting and recreating it
+void RacingPlugin::UpdateStartLineMark(int markId, double latitude, double longitude, double confidenceRadius, int sampleCount) {
+
+	PlugIn_Waypoint waypoint;
+	waypoint.m_IsVisible = true;
+	waypoint.m_lat = latitude;
+	waypoint.m_lon = longitude;
+	waypoint.m_MarkDescription = wxString::Format("Averaged over %d fixes, within %.1f m", sampleCount, confidenceRadius);
+
+	if (markId == RACE_DIALOG_PORT) {
 		waypoint.m_MarkName = "Port";
 		waypoint.m_IconName = "Marks-Race-Start";
-		portMarkGuid = GetNewGUID();
-		waypoint.m_GUID = portMarkGuid;
-		waypoint.m_lat = currentLatitude;
-		waypoint.m_lon = currentLongitude;
-		portMarkLatitude = currentLatitude;
-		portMarkLongitude = currentLongitude;
-		AddSingleWaypoint(&waypoint, false);
-		break;
+		portMarkLatitude = latitude;
+		portMarkLongitude = longitude;
+		portMarkRadius = confidenceRadius;
+		if (portMarkGuid.IsEmpty()) {
+			portMarkGuid = GetNewGUID();
+			waypoint.m_GUID = portMarkGuid;
+			AddSingleWaypoint(&waypoint, false);
+		}
+		else {
+			waypoint.m_GUID = portMarkGuid;
+			UpdateSingleWaypoint(&waypoint);
+		}
 	}
-	default:
-		event.Skip();
+	else {
+		waypoint.m_MarkName = "Starboard";
+		waypoint.m_IconName = "Marks-Race-Committee-Start-Boat";
+		starboardMarkLatitude = latitude;
+		starboardMarkLongitude = longitude;
+		starboardMarkRadius = confidenceRadius;
+		if (starboardMarkGuid.IsEmpty()) {
+			starboardMarkGuid = GetNewGUID();
+			waypoint.m_GUID = starboardMarkGuid;
+			AddSingleWaypoint(&waypoint, false);
+		}
+		else {
+			waypoint.m_GUID = starboardMarkGuid;
+			UpdateSingleWaypoint(&waypoint);
+		}
+	}
+
+	// Once both ends are pinged, the OCS predictor can measure distance to the line
+	if ((!starboardMarkGuid.IsEmpty()) && (!portMarkGuid.IsEmpty())) {
+		ocsPredictor.SetStartLine(starboardMarkLatitude, starboardMarkLongitude, portMarkLatitude, portMarkLongitude);
+		// GPS error of the bow, plus the uncertainty of the line from the ping radii (95% ~ 2 sigma)
+		double lineUncertainty = std::max(starboardMarkRadius, portMarkRadius) / 2.0;
+		ocsPredictor.SetPositionUncertainty(sqrt((2.5 * 2.5) + (lineUncertainty * lineUncertainty)));
+		startLineBias.SetStartLine(starboardMarkLatitude, starboardMarkLongitude, portMarkLatitude, portMarkLongitude);
+		UpdateStartLineBias();
+	}
+}
+
+// Run the OCS predictor for every position update, results are shared by the 
+// Countdown Timer, "Wind Wizard" gauge and the chart overlay
+void RacingPlugin::UpdateStartLinePrediction(void) {
+
+	if (!ocsPredictor.HasStartLine()) {
+		return;
+	}
+
+	double secondsToGun = NAN;
+	if (isCountdownTimerVisible) {
+		secondsToGun = racingWindow->GetSecondsToGun();
+	}
+
+	// Convert from OpenCPN's core units (knots) to metres/second
+	ocsPrediction = ocsPredictor.Update(GpsClock::GetLocalMilliseconds(), bowLatitude, bowLongitude,
+		courseOverGround, speedOverGround * 1852.0 / 3600.0, secondsToGun);
+}
+
+wxColour RacingPlugin::GetStartLineColour(void) {
+	if ((ocsPrediction.isValid) && (!isnan(ocsPrediction.probabilityOver))) {
+		if (ocsPrediction.probabilityOver >= 0.5) {
+			return *wxRED;
+		}
+		if (ocsPrediction.probabilityOver >= 0.2) {
+			return wxColour(255, 153, 51); // Orange
+		}
+	}
+	return *wxBLACK;
+}
+
+// Recalculate the geometry of the favoured end overlay, only called when the bias has changed
+void RacingPlugin::UpdateStartLineBias(void) {
+
+	const LineBias& bias = startLineBias.GetBias();
+	if (biasRevision == startLineBias.GetRevision()) {
+		return;
+	}
+	biasRevision = startLineBias.GetRevision();
+
+	if ((!bias.isValid) || (bias.favouredEnd == FAVOURED_NONE)) {
+		biasLabel = bias.isValid ? "Square" : wxString();
+		return;
 	}
+
+	// A line square to the wind, drawn from the unfavoured end towards the favoured end. 
+	// The favoured end is upwind of this line by the distance gained
+	double squareLength = bias.lineLength * cos(bias.biasAngle * M_PI / 180.0) / 1852.0;
+	if (bias.favouredEnd == FAVOURED_PORT) {
+		PositionBearingDistanceMercator_Plugin(starboardMarkLatitude, starboardMarkLongitude, 
+			fmod(bias.windDirection + 270.0, 360.0), squareLength, &squareLineLatitude, &squareLineLongitude);
+	}
+	else {
+		PositionBearingDistanceMercator_Plugin(portMarkLatitude, portMarkLongitude,
+			fmod(bias.windDirection + 90.0, 360.0), squareLength, &squareLineLatitude, &squareLineLongitude);
+	}
+
+	biasLabel = wxString::Format("%s +%.0f m", bias.favouredEnd == FAVOURED_PORT ? "Port" : "Stbd", bias.metresGained);
+
+	wxLogMessage("Racing Plugin, Line bias %.1f, TWD %.0f, %s end favoured by %.0f m", bias.biasAngle,
+		bias.windDirection, bias.favouredEnd == FAVOURED_PORT ? "Port" : "Starboard", bias.metresGained);
+}
+
+// Everything the chart overlay draws, compared by the overlay with the previous frame
+void RacingPlugin::GetOverlayInputs(OverlayInputs& inputs) {
+
+	inputs.showStartLine = showStartline;
+	inputs.hasStartLine = (!starboardMarkGuid.IsEmpty()) && (!portMarkGuid.IsEmpty());
+	inputs.starboardLatitude = starboardMarkLatitude;
+	inputs.starboardLongitude = starboardMarkLongitude;
+	inputs.portLatitude = portMarkLatitude;
+	inputs.portLongitude = portMarkLongitude;
+	inputs.startLineColour = GetStartLineColour();
+	inputs.trueWindDirection = trueWindDirection;
+
+	const LineBias& bias = startLineBias.GetBias();
+	if (bias.isValid) {
+		inputs.favouredEnd = bias.favouredEnd;
+		inputs.biasLabel = biasLabel;
+	}
+	else {
+		inputs.favouredEnd = FAVOURED_NONE;
+		inputs.biasLabel = wxEmptyString;
+	}
+	inputs.squareLineLatitude = squareLineLatitude;
+	inputs.squareLineLongitude = squareLineLongitude;
+
+	inputs.showWindAngles = showWindAngles;
+	inputs.boatLatitude = currentLatitude;
+	inputs.boatLongitude = currentLongitude;
+	inputs.ringRadius = headingPredictorLength;
+	if ((!isnan(apparentWindAngle)) && (!isnan(headingMagnetic))) {
+		inputs.apparentWindDirection = fmod(apparentWindAngle + headingMagnetic + 360.0, 360.0);
+	}
+	else {
+		inputs.apparentWindDirection = NAN;
+	}
+	inputs.apparentWindSpeed = apparentWindSpeed;
+
+	inputs.showTrack = showPerformanceTrack;
+	inputs.track = &trackHistory;
+	inputs.trackRevision = trackHistory.GetRevision();
 }
 
 // Retrieves the first interface for the selected protocol
@@ -1362,6 +2102,25 @@ void RacingPlugin::CalculateTrueWindV2() {
 	trueWindAngle = atan(u / v) * 180 / M_PI;
 }
 
+void RacingPlugin::UpdateDerivedData(void) {
+	double nan = std::numeric_limits<double>::quiet_NaN();
+
+	// Speed made good towards the wind
+	derivedData.velocityMadeGood = boatSpeed * cos(trueWindAngle * M_PI / 180.0f);
+
+	derivedData.targetSpeed = performanceTargets.GetTargetSpeed(trueWindSpeed, trueWindAngle);
+	derivedData.polarPercentage = derivedData.targetSpeed > 0.0 ? 100.0 * boatSpeed / derivedData.targetSpeed : nan;
+
+	// Variation is the difference between the true and magnetic headings
+	derivedData.setTrue = driftAngle;
+	derivedData.setMagnetic = fmod(driftAngle - (headingTrue - headingMagnetic) + 360.0f, 360.0f);
+	derivedData.drift = driftSpeed;
+
+	derivedData.lineDistance = ocsPrediction.isValid ? ocsPrediction.distanceToLine : nan;
+	derivedData.timeToLine = ocsPrediction.isValid ? ocsPrediction.timeToLine : nan;
+	derivedData.timeToBurn = ocsPrediction.isValid ? ocsPrediction.timeToBurn : nan;
+}
+
 void RacingPlugin::CalculateDrift() {
 	// The diffference between COG, SOG and STW and HDG
 	// Two ways of calculating, one using difference between projected positions from STW/HDG and COG/SOG
@@ -1390,6 +2149,35 @@ void RacingPlugin::CalculateDrift() {
 
 }
 
+// What matters at the gun is the bow, not the GPS antenna. 
+// Calculated once per position update, rather than by each consumer
+void RacingPlugin::CalculateBowPosition() {
+
+	bowLatitude = currentLatitude;
+	bowLongitude = currentLongitude;
+
+	if ((antennaForeAft == 0.0) && (antennaAthwartships == 0.0)) {
+		return;
+	}
+
+	// Prefer heading, when stationary on a mark COG is meaningless
+	double heading = !isnan(headingTrue) ? headingTrue : courseOverGround;
+	if (isnan(heading)) {
+		return;
+	}
+
+	// Offset from the antenna to the bow, forward and to starboard, rotated by the heading
+	double radians = heading * M_PI / 180.0;
+	double forward = antennaForeAft;
+	double starboard = -antennaAthwartships;
+	double north = (forward * cos(radians)) - (starboard * sin(radians));
+	double east = (forward * sin(radians)) + (starboard * cos(radians));
+
+	// 1' of latitude = 1NM = 1852 metres
+	bowLatitude = currentLatitude + (north / (1852.0 * 60.0));
+	bowLongitude = currentLongitude + (east / (1852.0 * 60.0 * cos(currentLatitude * M_PI / 180.0)));
+}
+
 // Raise the platform specific notification
 void RacingPlugin::SendNotification(wxString message) {
 	wxNotificationMessage* myNotification;
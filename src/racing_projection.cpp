@@ -0,0 +1,210 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Viewport keyed projection cache
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_projection.h"
+
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Mercator is undefined at the poles, OpenCPN limits charts to a similar latitude
+const double MAXIMUM_LATITUDE = 85.0;
+
+// Metres per degree of latitude, 1' = 1NM
+const double METRES_PER_DEGREE = 1852.0 * 60.0;
+
+void GeoPointArray::Clear(void) {
+	latitudes.clear();
+	longitudes.clear();
+	mercatorY.clear();
+}
+
+void GeoPointArray::Reserve(size_t count) {
+	latitudes.reserve(count);
+	longitudes.reserve(count);
+	mercatorY.reserve(count);
+}
+
+void GeoPointArray::Add(double latitude, double longitude) {
+	latitudes.push_back(latitude);
+	longitudes.push_back(longitude);
+	mercatorY.push_back(ProjectionCache::MercatorY(latitude));
+}
+
+void GeoPointArray::Erase(size_t count) {
+	if (count > latitudes.size()) {
+		count = latitudes.size();
+	}
+	latitudes.erase(latitudes.begin(), latitudes.begin() + count);
+	longitudes.erase(longitudes.begin(), longitudes.begin() + count);
+	mercatorY.erase(mercatorY.begin(), mercatorY.begin() + count);
+}
+
+ProjectionCache::ProjectionCache() {
+	isValid = false;
+	revision = 0;
+	isAffine = false;
+	originX = 0.0;
+	originY = 0.0;
+	lonAxisX = 0.0;
+	lonAxisY = 0.0;
+	mercatorAxisX = 0.0;
+	mercatorAxisY = 0.0;
+	centreMercatorY = 0.0;
+	pixelCount = 0;
+	pixelNext = 0;
+}
+
+bool ProjectionCache::Update(PlugIn_ViewPort* vp) {
+	ViewportKey current = GetViewportKey(vp);
+	if ((isValid) && (IsSameViewport(current, key))) {
+		return false;
+	}
+
+	viewport = *vp;
+	key = current;
+	isValid = true;
+	revision++;
+	pixelCount = 0;
+	pixelNext = 0;
+	Calibrate();
+	return true;
+}
+
+wxPoint ProjectionCache::GetPixel(double latitude, double longitude) {
+	for (int i = 0; i < pixelCount; i++) {
+		if ((pixels[i].latitude == latitude) && (pixels[i].longitude == longitude)) {
+			return pixels[i].pixel;
+		}
+	}
+
+	wxPoint pixel;
+	GetCanvasPixLL(&viewport, &pixel, latitude, longitude);
+
+	// Once full, the oldest entry is replaced
+	pixels[pixelNext].latitude = latitude;
+	pixels[pixelNext].longitude = longitude;
+	pixels[pixelNext].pixel = pixel;
+	pixelNext = (pixelNext + 1) % CACHE_SIZE;
+	if (pixelCount < CACHE_SIZE) {
+		pixelCount++;
+	}
+	return pixel;
+}
+
+void ProjectionCache::ProjectPoints(const GeoPointArray& points, std::vector<float>& x, std::vector<float>& y) {
+	size_t count = points.Size();
+	x.resize(count);
+	y.resize(count);
+
+	if (!isAffine) {
+		// Other projections are left to OpenCPN, one position at a time
+		for (size_t i = 0; i < count; i++) {
+			wxPoint2DDouble pixel;
+			GetDoubleCanvasPixLL(&viewport, &pixel, points.latitudes[i], points.longitudes[i]);
+			x[i] = static_cast<float>(pixel.m_x);
+			y[i] = static_cast<float>(pixel.m_y);
+		}
+		return;
+	}
+
+	// No branches or function calls, so the compiler can vectorise the loop
+	const double* longitudes = points.longitudes.data();
+	const double* mercatorY = points.mercatorY.data();
+	float* outputX = x.data();
+	float* outputY = y.data();
+	const double centreLongitude = key.longitude;
+	for (size_t i = 0; i < count; i++) {
+		// Longitude relative to the centre of the viewport, -180 .. 180 to handle the antimeridian
+		double longitude = longitudes[i] - centreLongitude;
+		longitude -= 360.0 * floor((longitude + 180.0) / 360.0);
+		double ordinate = mercatorY[i] - centreMercatorY;
+		outputX[i] = static_cast<float>(originX + (longitude * lonAxisX) + (ordinate * mercatorAxisX));
+		outputY[i] = static_cast<float>(originY + (longitude * lonAxisY) + (ordinate * mercatorAxisY));
+	}
+}
+
+void ProjectionCache::Calibrate(void) {
+
+	isAffine = (viewport.m_projection_type == PI_PROJECTION_MERCATOR) && (viewport.view_scale_ppm > 0.0) &&
+		(fabs(viewport.clat) < MAXIMUM_LATITUDE);
+	if (!isAffine) {
+		return;
+	}
+
+	// Calibrate over roughly a quarter of the screen, distant enough that rounding is insignificant,
+	// moving towards the equator so the reference positions remain valid
+	double metres = (viewport.pix_width > 0 ? viewport.pix_width : 1000) / 4.0 / viewport.view_scale_ppm;
+	double deltaLatitude = metres / METRES_PER_DEGREE;
+	if (viewport.clat > 0.0) {
+		deltaLatitude = -deltaLatitude;
+	}
+	double deltaLongitude = metres / (METRES_PER_DEGREE * cos(viewport.clat * M_PI / 180.0));
+
+	wxPoint2DDouble origin, east, north;
+	GetDoubleCanvasPixLL(&viewport, &origin, viewport.clat, viewport.clon);
+	GetDoubleCanvasPixLL(&viewport, &east, viewport.clat, viewport.clon + deltaLongitude);
+	GetDoubleCanvasPixLL(&viewport, &north, viewport.clat + deltaLatitude, viewport.clon);
+
+	centreMercatorY = MercatorY(viewport.clat);
+	double deltaMercatorY = MercatorY(viewport.clat + deltaLatitude) - centreMercatorY;
+
+	originX = origin.m_x;
+	originY = origin.m_y;
+	lonAxisX = (east.m_x - origin.m_x) / deltaLongitude;
+	lonAxisY = (east.m_y - origin.m_y) / deltaLongitude;
+	mercatorAxisX = (north.m_x - origin.m_x) / deltaMercatorY;
+	mercatorAxisY = (north.m_y - origin.m_y) / deltaMercatorY;
+}
+
+double ProjectionCache::MercatorY(double latitude) {
+	if (latitude > MAXIMUM_LATITUDE) {
+		latitude = MAXIMUM_LATITUDE;
+	}
+	else if (latitude < -MAXIMUM_LATITUDE) {
+		latitude = -MAXIMUM_LATITUDE;
+	}
+	return log(tan((M_PI / 4.0) + (latitude * M_PI / 360.0)));
+}
+
+ViewportKey ProjectionCache::GetViewportKey(PlugIn_ViewPort* vp) {
+	ViewportKey viewportKey;
+	viewportKey.latitude = vp->clat;
+	viewportKey.longitude = vp->clon;
+	viewportKey.scale = vp->view_scale_ppm;
+	viewportKey.rotation = vp->rotation;
+	viewportKey.skew = vp->skew;
+	viewportKey.width = vp->pix_width;
+	viewportKey.height = vp->pix_height;
+	viewportKey.projection = vp->m_projection_type;
+	return viewportKey;
+}
+
+bool ProjectionCache::IsSameViewport(const ViewportKey& key1, const ViewportKey& key2) {
+	return (key1.latitude == key2.latitude) && (key1.longitude == key2.longitude) &&
+		(key1.scale == key2.scale) && (key1.rotation == key2.rotation) && (key1.skew == key2.skew) &&
+		(key1.width == key2.width) && (key1.height == key2.height) && (key1.projection == key2.projection);
+}
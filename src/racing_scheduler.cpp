@@ -0,0 +1,168 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Output scheduler for generated NMEA 0183 sentences and NMEA 2000 PGNs
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Phases are successive multiples of the golden ratio, so however many outputs share an interval
+// they are spread roughly evenly across it
+const double PHASE_STEP = 0.6180339887;
+
+// Default number of outputs sent on a single tick
+const int DEFAULT_TICK_BUDGET = 2;
+
+// Intervals are limited to this range (milliseconds)
+const int MINIMUM_INTERVAL = 100;
+const int MAXIMUM_INTERVAL = 60000;
+
+OutputScheduler::OutputScheduler() {
+	tickBudget = DEFAULT_TICK_BUDGET;
+}
+
+int OutputScheduler::Add(const std::string& name, int interval, int priority, int maximumAge) {
+	Output output;
+	output.name = name;
+	output.interval = LimitInterval(interval);
+	output.priority = priority;
+	output.maximumAge = maximumAge;
+	output.enabled = true;
+	double integral;
+	output.phase = modf(outputs.size() * PHASE_STEP, &integral);
+	output.nextDue = 0;
+	output.statistics = { 0, 0, 0 };
+	outputs.push_back(output);
+	due.reserve(outputs.size());
+	return static_cast<int>(outputs.size()) - 1;
+}
+
+void OutputScheduler::SetInterval(int output, int interval) {
+	interval = LimitInterval(interval);
+	if (interval != outputs[output].interval) {
+		outputs[output].interval = interval;
+		// Restart the output's timeline on the next tick
+		outputs[output].nextDue = 0;
+	}
+}
+
+void OutputScheduler::SetPriority(int output, int priority) {
+	outputs[output].priority = priority;
+}
+
+void OutputScheduler::SetEnabled(int output, bool enabled) {
+	if (enabled != outputs[output].enabled) {
+		outputs[output].enabled = enabled;
+		outputs[output].nextDue = 0;
+	}
+}
+
+int OutputScheduler::GetInterval(int output) const {
+	return outputs[output].interval;
+}
+
+int OutputScheduler::GetPriority(int output) const {
+	return outputs[output].priority;
+}
+
+void OutputScheduler::SetTickBudget(int budget) {
+	tickBudget = std::max(1, budget);
+}
+
+const std::vector<int>& OutputScheduler::GetDue(long long now) {
+	due.clear();
+
+	for (size_t i = 0; i < outputs.size(); i++) {
+		Output& output = outputs[i];
+		if (!output.enabled) {
+			continue;
+		}
+
+		if (output.nextDue == 0) {
+			// Start the timeline at the output's phase within the current interval
+			long long start = now - (now % output.interval) + static_cast<long long>(output.phase * output.interval);
+			output.nextDue = start < now ? start + output.interval : start;
+		}
+
+		if (now >= output.nextDue) {
+			due.push_back(static_cast<int>(i));
+		}
+	}
+
+	// Highest priority first, then whichever has waited longest
+	std::sort(due.begin(), due.end(), [this](int a, int b) {
+		if (outputs[a].priority != outputs[b].priority) {
+			return outputs[a].priority > outputs[b].priority;
+		}
+		return outputs[a].nextDue < outputs[b].nextDue;
+	});
+
+	// The remainder stay due, and are sent on the following ticks
+	if (due.size() > static_cast<size_t>(tickBudget)) {
+		due.resize(tickBudget);
+	}
+
+	for (int i : due) {
+		Output& output = outputs[i];
+		output.nextDue += output.interval;
+		// Rather than catching up with a burst, skip any messages that were missed
+		if (output.nextDue <= now) {
+			long long missed = ((now - output.nextDue) / output.interval) + 1;
+			output.statistics.dropped += missed;
+			output.nextDue += missed * output.interval;
+		}
+	}
+
+	return due;
+}
+
+bool OutputScheduler::IsFresh(int output, long long inputTime, long long now) {
+	if ((inputTime > 0) && (now - inputTime <= outputs[output].maximumAge)) {
+		return true;
+	}
+	outputs[output].statistics.stale++;
+	return false;
+}
+
+void OutputScheduler::CountSent(int output) {
+	outputs[output].statistics.sent++;
+}
+
+void OutputScheduler::CountDropped(int output) {
+	outputs[output].statistics.dropped++;
+}
+
+const std::string& OutputScheduler::GetName(int output) const {
+	return outputs[output].name;
+}
+
+const OutputStatistics& OutputScheduler::GetStatistics(int output) const {
+	return outputs[output].statistics;
+}
+
+int OutputScheduler::LimitInterval(int interval) {
+	return std::min(std::max(interval, MINIMUM_INTERVAL), MAXIMUM_INTERVAL);
+}
@@ -0,0 +1,186 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: NMEA 0183 sentence builder
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_sentence.h"
+
+#include <cmath>
+
+// Powers of ten for the supported number of decimal places
+const double DECIMAL_SCALES[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0 };
+const int MAXIMUM_DECIMALS = 6;
+
+// Larger values could not be represented as fixed point, and could never fit in a sentence anyway
+const double MAXIMUM_VALUE = 1.0e12;
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+size_t FormatFixedPoint(double value, int decimals, char* buffer) {
+	if ((std::isnan(value)) || (std::fabs(value) >= MAXIMUM_VALUE)) {
+		return 0;
+	}
+
+	if (decimals < 0) {
+		decimals = 0;
+	}
+	else if (decimals > MAXIMUM_DECIMALS) {
+		decimals = MAXIMUM_DECIMALS;
+	}
+
+	// Round to the number of decimals, then write the digits with the decimal point inserted
+	unsigned long long fixed = static_cast<unsigned long long>(std::llround(std::fabs(value) * DECIMAL_SCALES[decimals]));
+	size_t length = 0;
+	if ((value < 0.0) && (fixed > 0)) {
+		buffer[length++] = '-';
+	}
+
+	// At least one digit before the decimal point
+	char digits[FIXED_POINT_SIZE];
+	int count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + (fixed % 10));
+		fixed /= 10;
+	} while ((fixed > 0) || (count <= decimals));
+
+	for (int i = count - 1; i >= 0; i--) {
+		buffer[length++] = digits[i];
+		if ((i == decimals) && (decimals > 0)) {
+			buffer[length++] = '.';
+		}
+	}
+	return length;
+}
+
+SentenceBuilder::SentenceBuilder() {
+	length = 0;
+	checksum = 0;
+	isOverflow = false;
+}
+
+void SentenceBuilder::Begin(const char* talker, const char* formatter) {
+	// The leading $ is not included in the checksum
+	buffer[0] = '$';
+	length = 1;
+	checksum = 0;
+	isOverflow = false;
+	AppendText(talker);
+	AppendText(formatter);
+}
+
+void SentenceBuilder::AddField(double value, int decimals) {
+	Append(',');
+	char digits[FIXED_POINT_SIZE];
+	size_t count = FormatFixedPoint(value, decimals, digits);
+	for (size_t i = 0; i < count; i++) {
+		Append(digits[i]);
+	}
+}
+
+void SentenceBuilder::AddField(int value) {
+	Append(',');
+	if (value < 0) {
+		Append('-');
+		AppendDigits(static_cast<unsigned long long>(-static_cast<long long>(value)), 1);
+	}
+	else {
+		AppendDigits(static_cast<unsigned long long>(value), 1);
+	}
+}
+
+void SentenceBuilder::AddField(char value) {
+	Append(',');
+	Append(value);
+}
+
+void SentenceBuilder::AddField(const char* value) {
+	Append(',');
+	AppendText(value);
+}
+
+void SentenceBuilder::AddEmptyField(void) {
+	Append(',');
+}
+
+bool SentenceBuilder::End(void) {
+	// The checksum itself is not included in the checksum
+	unsigned char sentenceChecksum = checksum;
+	Append('*');
+	Append(HEX_DIGITS[sentenceChecksum >> 4]);
+	Append(HEX_DIGITS[sentenceChecksum & 0x0F]);
+	Append('\r');
+	Append('\n');
+	return !isOverflow;
+}
+
+void SentenceBuilder::Append(char character) {
+	if (length < MAXIMUM_LENGTH) {
+		buffer[length++] = character;
+		checksum ^= static_cast<unsigned char>(character);
+	}
+	else {
+		isOverflow = true;
+	}
+}
+
+void SentenceBuilder::AppendText(const char* text) {
+	if (text != nullptr) {
+		while (*text != '\0') {
+			Append(*text++);
+		}
+	}
+}
+
+void SentenceBuilder::AppendDigits(unsigned long long value, int minimumDigits) {
+	char digits[24];
+	int count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	} while ((value > 0) || (count < minimumDigits));
+
+	while (count > 0) {
+		Append(digits[--count]);
+	}
+}
+
+std::shared_ptr<std::vector<uint8_t>> PayloadPool::Get(const uint8_t* data, size_t length) {
+	for (auto& payload : payloads) {
+		if (!payload) {
+			payload = std::make_shared<std::vector<uint8_t>>();
+		}
+		// Nothing else refers to this payload, so it can be overwritten
+		if (payload.use_count() == 1) {
+			payload->assign(data, data + length);
+			return payload;
+		}
+	}
+
+	// Every payload is still in use, so fall back to a new one
+	return std::make_shared<std::vector<uint8_t>>(data, data + length);
+}
+
+std::shared_ptr<std::vector<uint8_t>> PayloadPool::Get(const char* data, size_t length) {
+	return Get(reinterpret_cast<const uint8_t*>(data), length);
+}
@@ -0,0 +1,316 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: NMEA 0183 TCP & UDP server for crew tablets
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_server.h"
+#include "racing_socket.h"
+
+// STL
+#include <deque>
+
+// More clients than any crew has tablets
+const size_t MAXIMUM_CLIENTS = 32;
+
+// A client more than this many blocks behind has stopped reading
+const size_t MAXIMUM_QUEUED_BLOCKS = 64;
+
+// Sentences are broadcast in datagrams no larger than this, so they are not fragmented
+const size_t MAXIMUM_DATAGRAM = 1400;
+
+// The server thread wakes at least this often (milliseconds) to check whether it should stop
+const int POLL_TIMEOUT = 500;
+
+NmeaServer::NmeaServer() {
+	listener = NO_SOCKET;
+	broadcaster = NO_SOCKET;
+	waker = NO_SOCKET;
+	broadcastAddress = 0;
+	broadcastPort = 0;
+	wakePort = 0;
+	isRunning = false;
+	isStopping = false;
+	clientCount = 0;
+	droppedClients = 0;
+}
+
+NmeaServer::~NmeaServer() {
+	Stop();
+}
+
+bool NmeaServer::Start(int tcpPort, const std::string& udpAddress, int udpPort) {
+	if (isRunning) {
+		Stop();
+	}
+
+	if (!StartSockets()) {
+		return false;
+	}
+
+	if (!OpenSockets(tcpPort, udpAddress, udpPort)) {
+		CloseSockets();
+		FinishSockets();
+		return false;
+	}
+
+	pending.clear();
+	flushed.clear();
+	clientCount = 0;
+	isStopping = false;
+	isRunning = true;
+	thread = std::thread(&NmeaServer::Run, this);
+	return true;
+}
+
+bool NmeaServer::OpenSockets(int tcpPort, const std::string& udpAddress, int udpPort) {
+	waker = OpenWakeSocket(wakePort);
+	if (waker == NO_SOCKET) {
+		return false;
+	}
+
+	if (tcpPort > 0) {
+		listener = OpenListener(tcpPort);
+		if (listener == NO_SOCKET) {
+			return false;
+		}
+	}
+
+	if (udpPort > 0) {
+		broadcaster = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		if ((broadcaster == NO_SOCKET) || (inet_pton(AF_INET, udpAddress.c_str(), &broadcastAddress) != 1) ||
+			(!EnableOption(broadcaster, SOL_SOCKET, SO_BROADCAST)) || (!SetNonBlocking(broadcaster))) {
+			return false;
+		}
+		broadcastPort = htons(static_cast<uint16_t>(udpPort));
+	}
+	return true;
+}
+
+void NmeaServer::Stop(void) {
+	if (!isRunning) {
+		return;
+	}
+
+	isStopping = true;
+	Wake();
+	if (thread.joinable()) {
+		thread.join();
+	}
+	isRunning = false;
+	CloseSockets();
+	FinishSockets();
+}
+
+void NmeaServer::Append(const char* data, size_t length) {
+	if (isRunning) {
+		pending.append(data, length);
+	}
+}
+
+void NmeaServer::Flush(void) {
+	if ((!isRunning) || (pending.empty())) {
+		return;
+	}
+
+	// One immutable block per tick, shared by every client
+	std::shared_ptr<const std::string> block = std::make_shared<const std::string>(pending);
+	pending.clear();
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		flushed.push_back(block);
+	}
+	Wake();
+}
+
+void NmeaServer::Wake(void) {
+	WakeSocket(waker, wakePort);
+}
+
+void NmeaServer::Run(void) {
+
+	struct Client {
+		SocketHandle socket;
+		std::deque<std::shared_ptr<const std::string>> blocks;
+		// Bytes of the first block already sent
+		size_t offset;
+	};
+	std::vector<Client> clients;
+	std::vector<PollDescriptor> descriptors;
+	std::vector<std::shared_ptr<const std::string>> blocks;
+	char discard[512];
+
+	while (!isStopping) {
+
+		// The wake socket, the listener and the clients
+		descriptors.clear();
+		PollDescriptor descriptor;
+		descriptor.fd = waker;
+		descriptor.events = POLLIN;
+		descriptor.revents = 0;
+		descriptors.push_back(descriptor);
+		if ((listener != NO_SOCKET) && (clients.size() < MAXIMUM_CLIENTS)) {
+			descriptor.fd = listener;
+			descriptors.push_back(descriptor);
+		}
+		size_t firstClient = descriptors.size();
+		for (const Client& client : clients) {
+			descriptor.fd = client.socket;
+			descriptor.events = client.blocks.empty() ? POLLIN : POLLIN | POLLOUT;
+			descriptors.push_back(descriptor);
+		}
+
+		if (PollSockets(descriptors.data(), static_cast<unsigned long>(descriptors.size()), POLL_TIMEOUT) < 0) {
+			continue;
+		}
+
+		if (descriptors[0].revents & POLLIN) {
+			ClearWakeSocket(waker);
+		}
+
+		// New clients only receive sentences from now on
+		if ((firstClient > 1) && (descriptors[1].revents & POLLIN)) {
+			SocketHandle accepted;
+			while ((clients.size() < MAXIMUM_CLIENTS) && ((accepted = accept(listener, nullptr, nullptr)) != NO_SOCKET)) {
+				SetClientOptions(accepted);
+				descriptor.fd = accepted;
+				descriptor.events = POLLIN;
+				descriptor.revents = 0;
+				descriptors.push_back(descriptor);
+				clients.push_back({ accepted, {}, 0 });
+			}
+		}
+
+		// Anything a client sends is ignored, but a read also detects that it has disconnected
+		for (size_t i = 0; i < clients.size(); i++) {
+			short events = descriptors[firstClient + i].revents;
+			if (events & (POLLERR | POLLHUP | POLLNVAL)) {
+				CloseSocket(clients[i].socket);
+				clients[i].socket = NO_SOCKET;
+			}
+			else if (events & POLLIN) {
+				int received = recv(clients[i].socket, discard, sizeof(discard), 0);
+				if ((received == 0) || ((received < 0) && (!IsWouldBlock()))) {
+					CloseSocket(clients[i].socket);
+					clients[i].socket = NO_SOCKET;
+				}
+			}
+		}
+
+		// Collect the blocks flushed by the main thread
+		blocks.clear();
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			blocks.swap(flushed);
+		}
+		for (const std::shared_ptr<const std::string>& block : blocks) {
+			if (broadcaster != NO_SOCKET) {
+				Broadcast(*block);
+			}
+			for (Client& client : clients) {
+				if (client.socket != NO_SOCKET) {
+					client.blocks.push_back(block);
+				}
+			}
+		}
+
+		// Send as much as each client will accept without blocking
+		for (Client& client : clients) {
+			while ((client.socket != NO_SOCKET) && (!client.blocks.empty())) {
+				const std::string& block = *client.blocks.front();
+				int sent = send(client.socket, block.data() + client.offset, static_cast<int>(block.size() - client.offset), SEND_FLAGS);
+				if (sent < 0) {
+					if (!IsWouldBlock()) {
+						CloseSocket(client.socket);
+						client.socket = NO_SOCKET;
+					}
+					break;
+				}
+				client.offset += sent;
+				if (client.offset == block.size()) {
+					client.blocks.pop_front();
+					client.offset = 0;
+				}
+			}
+			// Whatever could not be sent is still waiting
+			if ((client.socket != NO_SOCKET) && (client.blocks.size() > MAXIMUM_QUEUED_BLOCKS)) {
+				CloseSocket(client.socket);
+				client.socket = NO_SOCKET;
+				droppedClients++;
+			}
+		}
+
+		// Remove the clients that were closed
+		size_t kept = 0;
+		for (size_t i = 0; i < clients.size(); i++) {
+			if (clients[i].socket != NO_SOCKET) {
+				if (kept != i) {
+					clients[kept] = std::move(clients[i]);
+				}
+				kept++;
+			}
+		}
+		clients.resize(kept);
+		clientCount = static_cast<int>(clients.size());
+	}
+
+	for (Client& client : clients) {
+		CloseSocket(client.socket);
+	}
+	clientCount = 0;
+}
+
+// Send a block in as few datagrams as possible, each ending at the end of a sentence
+void NmeaServer::Broadcast(const std::string& block) {
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = broadcastAddress;
+	address.sin_port = broadcastPort;
+
+	size_t start = 0;
+	while (start < block.size()) {
+		size_t end = block.size();
+		if (end - start > MAXIMUM_DATAGRAM) {
+			size_t lineEnd = block.rfind('\n', start + MAXIMUM_DATAGRAM - 1);
+			end = ((lineEnd != std::string::npos) && (lineEnd >= start)) ? lineEnd + 1 : start + MAXIMUM_DATAGRAM;
+		}
+		sendto(broadcaster, block.data() + start, static_cast<int>(end - start), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+		start = end;
+	}
+}
+
+void NmeaServer::CloseSockets(void) {
+	if (listener != NO_SOCKET) {
+		CloseSocket(listener);
+		listener = NO_SOCKET;
+	}
+	if (broadcaster != NO_SOCKET) {
+		CloseSocket(broadcaster);
+		broadcaster = NO_SOCKET;
+	}
+	if (waker != NO_SOCKET) {
+		CloseSocket(waker);
+		waker = NO_SOCKET;
+	}
+}
@@ -0,0 +1,160 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Shared memory export of the fused state for analysis tools
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_shared.h"
+
+#if defined (_WIN32)
+#include <windows.h>
+#elif !defined (__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// STL
+#include <cstring>
+
+// Readers rely on the sequence being updated in place, without a lock
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "The shared memory sequence must be lock free");
+
+SharedMemoryExport::SharedMemoryExport() {
+	shared = nullptr;
+#if defined (_WIN32)
+	mapping = nullptr;
+#endif
+}
+
+SharedMemoryExport::~SharedMemoryExport() {
+	Close();
+}
+
+bool SharedMemoryExport::Open(const std::string& name) {
+	if (shared != nullptr) {
+		Close();
+	}
+
+#if defined (__ANDROID__)
+	// Android does not provide POSIX shared memory
+	(void)name;
+	return false;
+#else
+#if defined (_WIN32)
+	segmentName = "Local\\" + name;
+	mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(SharedHeader), segmentName.c_str());
+	if (mapping == nullptr) {
+		return false;
+	}
+	void* address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedHeader));
+	if (address == nullptr) {
+		CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+#else
+	segmentName = "/" + name;
+	int descriptor = shm_open(segmentName.c_str(), O_CREAT | O_RDWR, 0644);
+	if (descriptor == -1) {
+		return false;
+	}
+	// The mapping remains valid once the descriptor is closed
+	void* address = MAP_FAILED;
+	if (ftruncate(descriptor, sizeof(SharedHeader)) == 0) {
+		address = mmap(nullptr, sizeof(SharedHeader), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	}
+	close(descriptor);
+	if (address == MAP_FAILED) {
+		shm_unlink(segmentName.c_str());
+		return false;
+	}
+#endif
+
+	shared = static_cast<SharedHeader*>(address);
+
+	// A segment left by a previous run keeps its sequence, so a reader still mapping it sees the change.
+	// If that run stopped part way through a write, the sequence is left odd
+	uint32_t sequence = shared->sequence.load(std::memory_order_relaxed);
+	if (sequence & 1) {
+		shared->sequence.store(sequence + 1, std::memory_order_relaxed);
+	}
+
+	BeginWrite();
+	shared->magic = SHARED_MAGIC;
+	shared->version = SHARED_VERSION;
+	shared->sampleSize = sizeof(SharedSample);
+	shared->ringSize = SHARED_RING_SIZE;
+	shared->isActive = 1;
+	shared->sampleCount = 0;
+	EndWrite();
+	return true;
+#endif
+}
+
+void SharedMemoryExport::Close(void) {
+	if (shared == nullptr) {
+		return;
+	}
+
+	BeginWrite();
+	shared->isActive = 0;
+	EndWrite();
+
+#if defined (_WIN32)
+	UnmapViewOfFile(shared);
+	CloseHandle(mapping);
+	mapping = nullptr;
+#elif !defined (__ANDROID__)
+	munmap(shared, sizeof(SharedHeader));
+	// Readers that still have it mapped keep their mapping, but it can no longer be opened
+	shm_unlink(segmentName.c_str());
+#endif
+	shared = nullptr;
+}
+
+void SharedMemoryExport::Write(const SharedSample& sample) {
+	if (shared == nullptr) {
+		return;
+	}
+
+	BeginWrite();
+	std::memcpy(&shared->current, &sample, sizeof(SharedSample));
+	std::memcpy(&shared->ring[shared->sampleCount % SHARED_RING_SIZE], &sample, sizeof(SharedSample));
+	shared->sampleCount++;
+	EndWrite();
+}
+
+// An odd sequence tells readers a write is in progress. The fence keeps the data writes after it
+void SharedMemoryExport::BeginWrite(void) {
+	uint32_t sequence = shared->sequence.load(std::memory_order_relaxed);
+	shared->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+// The release store keeps the data writes before it
+void SharedMemoryExport::EndWrite(void) {
+	uint32_t sequence = shared->sequence.load(std::memory_order_relaxed);
+	shared->sequence.store(sequence + 1, std::memory_order_release);
+}
@@ -0,0 +1,162 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: SignalK delta writer for the values we calculate
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_signalk.h"
+
+#include <cstring>
+#include <limits>
+
+// Unchanged values are sent again at least this often (milliseconds)
+const long long REFRESH_INTERVAL = 5000;
+
+// Space reserved for each path in the delta, in addition to its name
+const size_t VALUE_SIZE = 48;
+
+// Everything in a delta except the values
+const size_t ENVELOPE_SIZE = 160;
+
+const char DELTA_START[] = "{\"context\":\"vessels.self\",\"updates\":[{\"$source\":\"racing-plugin\",\"timestamp\":\"";
+const char VALUES_START[] = "\",\"values\":[";
+const char DELTA_END[] = "]}]}";
+
+SignalKDeltaWriter::SignalKDeltaWriter() {
+	delta.reserve(ENVELOPE_SIZE);
+}
+
+int SignalKDeltaWriter::Add(const char* path, int decimals) {
+	Path entry;
+	entry.name = path;
+	entry.decimals = decimals;
+	entry.value = std::numeric_limits<double>::quiet_NaN();
+	entry.sentLength = 0;
+	entry.isSent = false;
+	entry.sentTime = 0;
+	paths.push_back(entry);
+
+	size_t capacity = ENVELOPE_SIZE;
+	for (const Path& p : paths) {
+		capacity += p.name.size() + VALUE_SIZE;
+	}
+	delta.reserve(capacity);
+	return static_cast<int>(paths.size()) - 1;
+}
+
+void SignalKDeltaWriter::Set(int path, double value) {
+	paths[path].value = value;
+}
+
+bool SignalKDeltaWriter::Write(long long utcMilliseconds) {
+	delta.clear();
+	delta.append(DELTA_START);
+	AppendTimestamp(utcMilliseconds);
+	delta.append(VALUES_START);
+
+	bool isEmpty = true;
+	char text[FIXED_POINT_SIZE];
+	for (Path& path : paths) {
+		size_t length = FormatFixedPoint(path.value, path.decimals, text);
+		// A value that has never been available is not sent until it is
+		if ((!path.isSent) && (length == 0)) {
+			continue;
+		}
+		bool isChanged = (!path.isSent) || (length != path.sentLength) || (std::memcmp(text, path.sent.data(), length) != 0);
+		if ((!isChanged) && (utcMilliseconds - path.sentTime < REFRESH_INTERVAL)) {
+			continue;
+		}
+
+		if (!isEmpty) {
+			delta.push_back(',');
+		}
+		delta.append("{\"path\":\"");
+		delta.append(path.name);
+		delta.append("\",\"value\":");
+		if (length == 0) {
+			delta.append("null");
+		}
+		else {
+			delta.append(text, length);
+		}
+		delta.push_back('}');
+		isEmpty = false;
+
+		std::memcpy(path.sent.data(), text, length);
+		path.sentLength = length;
+		path.isSent = true;
+		path.sentTime = utcMilliseconds;
+	}
+
+	delta.append(DELTA_END);
+	return !isEmpty;
+}
+
+// ISO 8601, eg. 2026-10-18T10:15:30.250Z
+void SignalKDeltaWriter::AppendTimestamp(long long utcMilliseconds) {
+	long long days = utcMilliseconds / 86400000LL;
+	long long millisecondsOfDay = utcMilliseconds % 86400000LL;
+	if (millisecondsOfDay < 0) {
+		millisecondsOfDay += 86400000LL;
+		days--;
+	}
+
+	// Civil date from the number of days since 1/1/1970, Howard Hinnant's algorithm
+	days += 719468;
+	long long era = (days >= 0 ? days : days - 146096) / 146097;
+	long long dayOfEra = days - (era * 146097);
+	long long yearOfEra = (dayOfEra - (dayOfEra / 1460) + (dayOfEra / 36524) - (dayOfEra / 146096)) / 365;
+	long long dayOfYear = dayOfEra - ((365 * yearOfEra) + (yearOfEra / 4) - (yearOfEra / 100));
+	long long monthIndex = ((5 * dayOfYear) + 2) / 153;
+	int day = static_cast<int>(dayOfYear - (((153 * monthIndex) + 2) / 5) + 1);
+	int month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+	int year = static_cast<int>(yearOfEra + (era * 400) + (month <= 2 ? 1 : 0));
+
+	AppendDigits(year, 4);
+	delta.push_back('-');
+	AppendDigits(month, 2);
+	delta.push_back('-');
+	AppendDigits(day, 2);
+	delta.push_back('T');
+	AppendDigits(static_cast<int>(millisecondsOfDay / 3600000), 2);
+	delta.push_back(':');
+	AppendDigits(static_cast<int>((millisecondsOfDay / 60000) % 60), 2);
+	delta.push_back(':');
+	AppendDigits(static_cast<int>((millisecondsOfDay / 1000) % 60), 2);
+	delta.push_back('.');
+	AppendDigits(static_cast<int>(millisecondsOfDay % 1000), 3);
+	delta.push_back('Z');
+}
+
+void SignalKDeltaWriter::AppendDigits(int value, int digits) {
+	char text[12];
+	int count = 0;
+	do {
+		text[count++] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	} while ((value > 0) || (count < digits));
+
+	while (count > 0) {
+		delta.push_back(text[--count]);
+	}
+}
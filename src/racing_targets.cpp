@@ -0,0 +1,121 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Learned target boat speeds
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_targets.h"
+
+#include <limits>
+#include <cmath>
+
+// Width of each bin
+const double SPEED_BIN_WIDTH = 2.0;
+const double ANGLE_BIN_WIDTH = 10.0;
+
+// Samples (seconds at 1Hz) in a bin before its target is used
+const int MINIMUM_SAMPLES = 60;
+
+// Fraction of the difference applied when a sample is faster or slower than the target
+const double TARGET_RISE = 0.1;
+const double TARGET_DECAY = 0.0005;
+
+// Ignore samples when drifting or becalmed
+const double MINIMUM_BOAT_SPEED = 0.5;
+const double MINIMUM_WIND_SPEED = 1.0;
+
+PerformanceTargets::PerformanceTargets() {
+	Clear();
+}
+
+void PerformanceTargets::Clear(void) {
+	for (auto& target : targets) {
+		target.speed = 0.0;
+		target.samples = 0;
+	}
+}
+
+double PerformanceTargets::Update(double trueWindSpeed, double trueWindAngle, double boatSpeed) {
+
+	if (std::isnan(boatSpeed) || (boatSpeed < MINIMUM_BOAT_SPEED) || (trueWindSpeed < MINIMUM_WIND_SPEED)) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	int speedBin = GetSpeedBin(trueWindSpeed);
+	int angleBin = GetAngleBin(trueWindAngle);
+	if ((speedBin < 0) || (angleBin < 0)) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	Target& target = targets[(speedBin * ANGLE_BINS) + angleBin];
+	if (target.samples == 0) {
+		target.speed = boatSpeed;
+	}
+	else if (boatSpeed > target.speed) {
+		target.speed += TARGET_RISE * (boatSpeed - target.speed);
+	}
+	else {
+		target.speed -= TARGET_DECAY * (target.speed - boatSpeed);
+	}
+	target.samples++;
+
+	if (target.samples < MINIMUM_SAMPLES) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	return boatSpeed / target.speed;
+}
+
+double PerformanceTargets::GetTargetSpeed(double trueWindSpeed, double trueWindAngle) const {
+	int speedBin = GetSpeedBin(trueWindSpeed);
+	int angleBin = GetAngleBin(trueWindAngle);
+	if ((speedBin < 0) || (angleBin < 0)) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	const Target& target = targets[(speedBin * ANGLE_BINS) + angleBin];
+	if (target.samples < MINIMUM_SAMPLES) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	return target.speed;
+}
+
+int PerformanceTargets::GetSpeedBin(double trueWindSpeed) {
+	if (std::isnan(trueWindSpeed) || (trueWindSpeed < 0.0)) {
+		return -1;
+	}
+	int bin = static_cast<int>(trueWindSpeed / SPEED_BIN_WIDTH);
+	return bin < SPEED_BINS ? bin : -1;
+}
+
+int PerformanceTargets::GetAngleBin(double trueWindAngle) {
+	if (std::isnan(trueWindAngle)) {
+		return -1;
+	}
+	// Port and starboard tacks are treated alike
+	double angle = fabs(fmod(trueWindAngle, 360.0));
+	if (angle > 180.0) {
+		angle = 360.0 - angle;
+	}
+	int bin = static_cast<int>(angle / ANGLE_BIN_WIDTH);
+	return bin < ANGLE_BINS ? bin : ANGLE_BINS - 1;
+}
@@ -30,9 +30,14 @@
 // Constructor and destructor implementation
 RacingToolbox::RacingToolbox( wxWindow* parent) : RacingToolboxBase(parent) {
 	spinCountdownTimer->SetValue(defaultTimerValue / 60);
+	spinPingDuration->SetValue(pingDuration);
+	spinAntennaForeAft->SetValue(antennaForeAft);
+	spinAntennaAthwartships->SetValue(antennaAthwartships);
+	spinFrameRate->SetValue(gaugeFrameRate);
 	spinTackingAngle->SetValue(tackingAngle);
 	chkWindAngle->SetValue(showWindAngles);
 	chkLayLines->SetValue(showLayLines);
+	chkPerformanceTrack->SetValue(showPerformanceTrack);
 	chkStartLine->SetValue(showStartline);
 	chkMultiCanvas->SetValue(showMultiCanvas);
 	// Not used here, Would normally only save the settings if they have been changed
@@ -48,6 +53,26 @@ void RacingToolbox::OnCountdownTimerChanged(wxSpinEvent& event) {
 	settingsDirty = true;
 }
 
+void RacingToolbox::OnPingDurationChanged(wxSpinEvent& event) {
+	pingDuration = spinPingDuration->GetValue();
+	settingsDirty = true;
+}
+
+void RacingToolbox::OnAntennaForeAftChanged(wxSpinDoubleEvent& event) {
+	antennaForeAft = spinAntennaForeAft->GetValue();
+	settingsDirty = true;
+}
+
+void RacingToolbox::OnAntennaAthwartshipsChanged(wxSpinDoubleEvent& event) {
+	antennaAthwartships = spinAntennaAthwartships->GetValue();
+	settingsDirty = true;
+}
+
+void RacingToolbox::OnFrameRateChanged(wxSpinEvent& event) {
+	gaugeFrameRate = spinFrameRate->GetValue();
+	settingsDirty = true;
+}
+
 void RacingToolbox::OnTackingAngleChanged(wxSpinEvent& event) {
 	tackingAngle = spinTackingAngle->GetValue();
 	settingsDirty = true;
@@ -68,6 +93,11 @@ void RacingToolbox::OnLayLinesChanged(wxCommandEvent& event) {
 	settingsDirty = true;
 }
 
+void RacingToolbox::OnPerformanceTrackChanged(wxCommandEvent& event) {
+	showPerformanceTrack = chkPerformanceTrack->IsChecked();
+	settingsDirty = true;
+}
+
 void RacingToolbox::OnCanvasChanged(wxCommandEvent& event) {
 	showMultiCanvas = chkMultiCanvas->IsChecked();
 	settingsDirty = true;
@@ -21,6 +21,39 @@ RacingToolboxBase::RacingToolboxBase( wxWindow* parent, wxWindowID id, const wxP
 	spinCountdownTimer = new wxSpinCtrl( this, wxID_ANY, wxT("5"), wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 20, 0 );
 	bSizer1->Add( spinCountdownTimer, 0, wxALL, 5 );
 
+	labelPingDuration = new wxStaticText( this, wxID_ANY, wxT("Ping Duration (seconds)"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelPingDuration->Wrap( -1 );
+	bSizer1->Add( labelPingDuration, 0, wxALL, 5 );
+
+	spinPingDuration = new wxSpinCtrl( this, wxID_ANY, wxT("5"), wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, 30, 5 );
+	spinPingDuration->SetToolTip( wxT("Average the position over this period when pinging the start line, zero for a single fix") );
+	bSizer1->Add( spinPingDuration, 0, wxALL, 5 );
+
+	labelAntennaForeAft = new wxStaticText( this, wxID_ANY, wxT("GPS Antenna aft of Bow (metres)"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelAntennaForeAft->Wrap( -1 );
+	bSizer1->Add( labelAntennaForeAft, 0, wxALL, 5 );
+
+	spinAntennaForeAft = new wxSpinCtrlDouble( this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, 50, 0, 0.1 );
+	spinAntennaForeAft->SetDigits( 1 );
+	bSizer1->Add( spinAntennaForeAft, 0, wxALL, 5 );
+
+	labelAntennaAthwartships = new wxStaticText( this, wxID_ANY, wxT("GPS Antenna to Starboard of Centreline (metres)"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelAntennaAthwartships->Wrap( -1 );
+	bSizer1->Add( labelAntennaAthwartships, 0, wxALL, 5 );
+
+	spinAntennaAthwartships = new wxSpinCtrlDouble( this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, -10, 10, 0, 0.1 );
+	spinAntennaAthwartships->SetDigits( 1 );
+	spinAntennaAthwartships->SetToolTip( wxT("Negative values if the antenna is to port of the centreline") );
+	bSizer1->Add( spinAntennaAthwartships, 0, wxALL, 5 );
+
+	labelFrameRate = new wxStaticText( this, wxID_ANY, wxT("Wind Wizard Frame Rate (per second)"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelFrameRate->Wrap( -1 );
+	bSizer1->Add( labelFrameRate, 0, wxALL, 5 );
+
+	spinFrameRate = new wxSpinCtrl( this, wxID_ANY, wxT("20"), wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, 60, 20 );
+	spinFrameRate->SetToolTip( wxT("Rate at which the wind needles are animated between updates, zero to disable") );
+	bSizer1->Add( spinFrameRate, 0, wxALL, 5 );
+
 	labelTackingAngle = new wxStaticText( this, wxID_ANY, wxT("Tacking Angle (degrees)"), wxDefaultPosition, wxDefaultSize, 0 );
 	labelTackingAngle->Wrap( -1 );
 	bSizer1->Add( labelTackingAngle, 0, wxALL, 5 );
@@ -37,6 +70,10 @@ RacingToolboxBase::RacingToolboxBase( wxWindow* parent, wxWindowID id, const wxP
 	chkLayLines = new wxCheckBox( this, wxID_ANY, wxT("Show Lay Lines"), wxDefaultPosition, wxDefaultSize, 0 );
 	bSizer1->Add( chkLayLines, 0, wxALL, 5 );
 
+	chkPerformanceTrack = new wxCheckBox( this, wxID_ANY, wxT("Show Performance Track"), wxDefaultPosition, wxDefaultSize, 0 );
+	chkPerformanceTrack->SetToolTip( wxT("Colour our recent track by boat speed as a percentage of the target speed for the wind") );
+	bSizer1->Add( chkPerformanceTrack, 0, wxALL, 5 );
+
 	chkMultiCanvas = new wxCheckBox(this, wxID_ANY, wxT("Multi Canvas"), wxDefaultPosition, wxDefaultSize, 0);
 	bSizer1->Add(chkMultiCanvas, 0, wxALL, 5);
 
@@ -46,10 +83,15 @@ RacingToolboxBase::RacingToolboxBase( wxWindow* parent, wxWindowID id, const wxP
 
 	// Connect Events
 	spinCountdownTimer->Connect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnCountdownTimerChanged ), NULL, this );
+	spinPingDuration->Connect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnPingDurationChanged ), NULL, this );
+	spinAntennaForeAft->Connect( wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED, wxSpinDoubleEventHandler( RacingToolboxBase::OnAntennaForeAftChanged ), NULL, this );
+	spinAntennaAthwartships->Connect( wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED, wxSpinDoubleEventHandler( RacingToolboxBase::OnAntennaAthwartshipsChanged ), NULL, this );
+	spinFrameRate->Connect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnFrameRateChanged ), NULL, this );
 	spinTackingAngle->Connect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnTackingAngleChanged ), NULL, this );
 	chkWindAngle->Connect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnWindAngleChanged ), NULL, this );
 	chkStartLine->Connect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnStartLineChanged ), NULL, this );
 	chkLayLines->Connect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnLayLinesChanged ), NULL, this );
+	chkPerformanceTrack->Connect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnPerformanceTrackChanged ), NULL, this );
 	chkMultiCanvas->Connect(wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler(RacingToolboxBase::OnCanvasChanged), NULL, this);
 }
 
@@ -57,9 +99,14 @@ RacingToolboxBase::~RacingToolboxBase()
 {
 	// Disconnect Events
 	spinCountdownTimer->Disconnect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnCountdownTimerChanged ), NULL, this );
+	spinPingDuration->Disconnect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnPingDurationChanged ), NULL, this );
+	spinAntennaForeAft->Disconnect( wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED, wxSpinDoubleEventHandler( RacingToolboxBase::OnAntennaForeAftChanged ), NULL, this );
+	spinAntennaAthwartships->Disconnect( wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED, wxSpinDoubleEventHandler( RacingToolboxBase::OnAntennaAthwartshipsChanged ), NULL, this );
+	spinFrameRate->Disconnect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnFrameRateChanged ), NULL, this );
 	spinTackingAngle->Disconnect( wxEVT_COMMAND_SPINCTRL_UPDATED, wxSpinEventHandler( RacingToolboxBase::OnTackingAngleChanged ), NULL, this );
 	chkWindAngle->Disconnect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnWindAngleChanged ), NULL, this );
 	chkStartLine->Disconnect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnStartLineChanged ), NULL, this );
 	chkLayLines->Disconnect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnLayLinesChanged ), NULL, this );
+	chkPerformanceTrack->Disconnect( wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler( RacingToolboxBase::OnPerformanceTrackChanged ), NULL, this );
 	chkMultiCanvas->Disconnect(wxEVT_COMMAND_CHECKBOX_CLICKED, wxCommandEventHandler(RacingToolboxBase::OnCanvasChanged), NULL, this);
 }
@@ -0,0 +1,216 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Track history with level of detail decimation
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_track.h"
+
+#include <utility>
+// M_PI for Microsoft Visual C++
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Metres per degree of latitude, 1' = 1NM
+const double METRES_PER_DEGREE = 1852.0 * 60.0;
+
+// Tolerance of the most detailed level (metres), each level doubles the previous
+const double BASE_TOLERANCE = 0.5;
+
+// Default duration of the track (seconds)
+const int DEFAULT_DURATION = 6 * 60 * 60;
+
+TrackHistory::TrackHistory() {
+	durationMilliseconds = DEFAULT_DURATION * 1000LL;
+	revision = 0;
+}
+
+void TrackHistory::Clear(void) {
+	points.Clear();
+	times.clear();
+	efficiencies.clear();
+	for (int i = 0; i < LEVEL_COUNT; i++) {
+		levels[i].clear();
+		chunkOffsets[i].clear();
+	}
+	revision++;
+}
+
+void TrackHistory::SetDuration(int seconds) {
+	durationMilliseconds = (seconds > 0 ? seconds : DEFAULT_DURATION) * 1000LL;
+}
+
+void TrackHistory::Add(long long timeMilliseconds, double latitude, double longitude, double efficiency) {
+	points.Add(latitude, longitude);
+	times.push_back(timeMilliseconds);
+	efficiencies.push_back(static_cast<float>(efficiency));
+	revision++;
+
+	// Chunks are only ever discarded whole, so chunk boundaries remain multiples of the chunk size
+	unsigned int count = static_cast<unsigned int>(times.size());
+	if ((count % CHUNK_SIZE) == 0) {
+		SimplifyChunk(count - CHUNK_SIZE, count - 1);
+	}
+
+	Expire(timeMilliseconds);
+}
+
+void TrackHistory::GetVisibleIndices(double pixelsPerMetre, std::vector<unsigned int>& indices) const {
+	indices.clear();
+	unsigned int count = static_cast<unsigned int>(times.size());
+
+	// The coarsest level whose tolerance is within a pixel
+	int level = -1;
+	if (pixelsPerMetre > 0.0) {
+		double pixelSize = 1.0 / pixelsPerMetre;
+		double tolerance = BASE_TOLERANCE;
+		while ((level + 1 < LEVEL_COUNT) && (tolerance <= pixelSize)) {
+			level++;
+			tolerance *= 2.0;
+		}
+	}
+
+	unsigned int first = 0;
+	if (level >= 0) {
+		indices.assign(levels[level].begin(), levels[level].end());
+		first = static_cast<unsigned int>(chunkOffsets[level].size()) * CHUNK_SIZE;
+	}
+
+	// The incomplete chunk, or everything when zoomed right in
+	for (unsigned int i = first; i < count; i++) {
+		indices.push_back(i);
+	}
+}
+
+void TrackHistory::SimplifyChunk(unsigned int first, unsigned int last) {
+	std::vector<unsigned int> input;
+	input.reserve(last - first + 1);
+	for (unsigned int i = first; i <= last; i++) {
+		input.push_back(i);
+	}
+
+	// Each level simplifies the output of the previous level, which is already smaller
+	double tolerance = BASE_TOLERANCE;
+	for (int level = 0; level < LEVEL_COUNT; level++) {
+		const std::vector<unsigned int>& source = level == 0 ? input : levels[level - 1];
+		size_t begin = level == 0 ? 0 : chunkOffsets[level - 1].back();
+		chunkOffsets[level].push_back(levels[level].size());
+		Simplify(source, begin, source.size(), tolerance, levels[level]);
+		tolerance *= 2.0;
+	}
+}
+
+void TrackHistory::Simplify(const std::vector<unsigned int>& input, size_t begin, size_t end, double tolerance,
+	std::vector<unsigned int>& output) const {
+
+	if (end - begin <= 2) {
+		output.insert(output.end(), input.begin() + begin, input.begin() + end);
+		return;
+	}
+
+	// Over a chunk, a flat earth is accurate enough
+	const double referenceLatitude = points.latitudes[input[begin]];
+	const double referenceLongitude = points.longitudes[input[begin]];
+	const double longitudeScale = METRES_PER_DEGREE * cos(referenceLatitude * M_PI / 180.0);
+	auto x = [&](unsigned int i) {
+		double longitude = points.longitudes[i] - referenceLongitude;
+		longitude -= 360.0 * floor((longitude + 180.0) / 360.0);
+		return longitude * longitudeScale;
+	};
+	auto y = [&](unsigned int i) {
+		return (points.latitudes[i] - referenceLatitude) * METRES_PER_DEGREE;
+	};
+
+	std::vector<char> isRetained(end - begin, 0);
+	isRetained.front() = 1;
+	isRetained.back() = 1;
+
+	// Iterative rather than recursive, a straight track would otherwise recurse once per sample
+	std::vector<std::pair<size_t, size_t>> spans;
+	spans.push_back(std::make_pair(begin, end - 1));
+	while (!spans.empty()) {
+		size_t start = spans.back().first;
+		size_t finish = spans.back().second;
+		spans.pop_back();
+
+		double x1 = x(input[start]);
+		double y1 = y(input[start]);
+		double dx = x(input[finish]) - x1;
+		double dy = y(input[finish]) - y1;
+		double lengthSquared = (dx * dx) + (dy * dy);
+
+		double furthestDistance = 0.0;
+		size_t furthest = start;
+		for (size_t i = start + 1; i < finish; i++) {
+			double px = x(input[i]) - x1;
+			double py = y(input[i]) - y1;
+			double distance;
+			if (lengthSquared > 0.0) {
+				// Distance from the segment, clamped to its ends
+				double t = ((px * dx) + (py * dy)) / lengthSquared;
+				t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+				distance = hypot(px - (t * dx), py - (t * dy));
+			}
+			else {
+				distance = hypot(px, py);
+			}
+			if (distance > furthestDistance) {
+				furthestDistance = distance;
+				furthest = i;
+			}
+		}
+
+		if (furthestDistance > tolerance) {
+			isRetained[furthest - begin] = 1;
+			spans.push_back(std::make_pair(start, furthest));
+			spans.push_back(std::make_pair(furthest, finish));
+		}
+	}
+
+	for (size_t i = begin; i < end; i++) {
+		if (isRetained[i - begin]) {
+			output.push_back(input[i]);
+		}
+	}
+}
+
+void TrackHistory::Expire(long long timeMilliseconds) {
+	while ((!chunkOffsets[0].empty()) && ((timeMilliseconds - times[CHUNK_SIZE - 1]) > durationMilliseconds)) {
+		points.Erase(CHUNK_SIZE);
+		times.erase(times.begin(), times.begin() + CHUNK_SIZE);
+		efficiencies.erase(efficiencies.begin(), efficiencies.begin() + CHUNK_SIZE);
+
+		for (int level = 0; level < LEVEL_COUNT; level++) {
+			size_t retained = chunkOffsets[level].size() > 1 ? chunkOffsets[level][1] : levels[level].size();
+			levels[level].erase(levels[level].begin(), levels[level].begin() + retained);
+			for (auto& index : levels[level]) {
+				index -= CHUNK_SIZE;
+			}
+			chunkOffsets[level].erase(chunkOffsets[level].begin());
+			for (auto& offset : chunkOffsets[level]) {
+				offset -= retained;
+			}
+		}
+		revision++;
+	}
+}
@@ -0,0 +1,791 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: HTTP & WebSocket live data server for crew displays
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+#include "racing_webserver.h"
+#include "racing_socket.h"
+
+// Locale independent number formatting
+#include "racing_sentence.h"
+
+// STL
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+// Enough for every phone on board, and then some
+const size_t MAXIMUM_CONNECTIONS = 64;
+
+// Longest HTTP request we accept, browsers send far less
+const size_t MAXIMUM_REQUEST = 4096;
+
+// Longest message we accept from a browser, we only expect control frames
+const size_t MAXIMUM_MESSAGE = 1024;
+
+// Responses, SignalK deltas & control frames waiting to be sent to a connection
+const size_t MAXIMUM_QUEUED = 64;
+
+// A request must arrive within this time (milliseconds) of connecting, and a connection
+// that makes no progress sending for this long has stopped reading
+const long long REQUEST_TIMEOUT = 5000;
+const long long SEND_TIMEOUT = 10000;
+
+// The server thread wakes at least this often (milliseconds) to check whether it should stop
+const int POLL_TIMEOUT = 500;
+
+// Appended to the client's key to form the accept key, from RFC 6455
+const char WEBSOCKET_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// WebSocket opcodes, the first byte of a frame includes the FIN bit
+const unsigned char OPCODE_TEXT = 0x01;
+const unsigned char OPCODE_CLOSE = 0x08;
+const unsigned char OPCODE_PING = 0x09;
+const unsigned char OPCODE_PONG = 0x0A;
+const unsigned char FINAL_FRAME = 0x80;
+
+// Paths of the WebSocket streams
+const char LIVE_DATA_PATH[] = "/live";
+const char SIGNALK_STREAM_PATH[] = "/signalk/v1/stream";
+
+// Version of the SignalK specification our deltas follow
+const char SIGNALK_VERSION[] = "1.7.0";
+
+// The live data page. The element identifiers are the names of the snapshot's fields
+const char LIVE_DATA_PAGE[] = R"(<!DOCTYPE html>
+<html><head><meta charset="utf-8"><meta name="viewport" content="width=device-width,initial-scale=1">
+<title>Racing</title>
+<style>
+body{margin:0;background:#000;color:#fff;font-family:sans-serif}
+#values{display:grid;grid-template-columns:1fr 1fr;gap:1px;background:#333}
+#values div{background:#000;padding:2vw;text-align:center}
+#values div.wide{grid-column:span 2}
+.label{display:block;font-size:4vw;color:#aaa}
+.value{display:block;font-size:11vw;font-weight:bold}
+.wide .value{font-size:24vw}
+.over{color:#f33}
+#status{padding:2vw;font-size:4vw;color:#aaa;text-align:center}
+</style></head><body>
+<div id="values">
+<div class="wide"><span class="label">Gun</span><span class="value" id="secondsToGun">-</span></div>
+<div><span class="label">Line m</span><span class="value" id="lineDistance">-</span></div>
+<div><span class="label">To Line s</span><span class="value" id="timeToLine">-</span></div>
+<div><span class="label">Burn s</span><span class="value" id="timeToBurn">-</span></div>
+<div><span class="label">Over %</span><span class="value" id="percentOver">-</span></div>
+<div><span class="label">TWS kn</span><span class="value" id="trueWindSpeed">-</span></div>
+<div><span class="label">TWA &deg;</span><span class="value" id="trueWindAngle">-</span></div>
+<div><span class="label">TWD &deg;</span><span class="value" id="trueWindDirection">-</span></div>
+<div><span class="label">BSP kn</span><span class="value" id="boatSpeed">-</span></div>
+<div><span class="label">Target kn</span><span class="value" id="targetSpeed">-</span></div>
+<div><span class="label">VMG kn</span><span class="value" id="velocityMadeGood">-</span></div>
+<div><span class="label">SOG kn</span><span class="value" id="speedOverGround">-</span></div>
+<div><span class="label">COG &deg;</span><span class="value" id="courseOverGround">-</span></div>
+</div>
+<div id="status">Connecting</div>
+<script>
+var formats={secondsToGun:function(v){var s=Math.abs(Math.round(v));return (v<0?'+':'')+Math.floor(s/60)+':'+('0'+s%60).slice(-2);}};
+function show(data){
+for(var name in data){var e=document.getElementById(name);if(e){var v=data[name];e.textContent=(v===null)?'-':(formats[name]?formats[name](v):v);}}
+document.getElementById('lineDistance').className='value'+((data.lineDistance<0)?' over':'');
+document.getElementById('percentOver').className='value'+((data.percentOver>=50)?' over':'');
+}
+function connect(){
+var socket=new WebSocket((location.protocol=='https:'?'wss://':'ws://')+location.host+'/live');
+var status=document.getElementById('status');
+socket.onopen=function(){status.textContent='Live';};
+socket.onmessage=function(message){show(JSON.parse(message.data));};
+socket.onclose=function(){status.textContent='Reconnecting';setTimeout(connect,2000);};
+}
+connect();
+</script></body></html>
+)";
+
+struct LiveDataServer::Connection {
+	SocketHandle socket;
+	// Whether the connection has been upgraded to a WebSocket, and whether it is a SignalK stream
+	bool isWebSocket;
+	bool isSignalK;
+	// Close once everything queued has been sent
+	bool isClosing;
+	// Request or frames received, not yet handled
+	std::string input;
+	// Responses & frames to send, the first partially sent up to offset
+	std::deque<std::shared_ptr<const std::string>> queue;
+	size_t offset;
+	// Whether the last in the queue is a snapshot that has not been started
+	bool isSnapshotQueued;
+	// Revision of the last snapshot queued
+	unsigned long long revision;
+	// When the connection was accepted, or last made progress sending
+	long long lastActivity;
+};
+
+static long long GetMilliseconds(void) {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint32_t RotateLeft(uint32_t value, int bits) {
+	return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1 digest, only used for the WebSocket handshake
+static void Sha1(const std::string& message, unsigned char digest[20]) {
+	uint32_t hash[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+	// Padded with a one bit, zeros and the length in bits to a multiple of 64 bytes
+	std::string data = message;
+	data.push_back(static_cast<char>(0x80));
+	while (data.size() % 64 != 56) {
+		data.push_back(0);
+	}
+	unsigned long long bits = static_cast<unsigned long long>(message.size()) * 8;
+	for (int i = 7; i >= 0; i--) {
+		data.push_back(static_cast<char>((bits >> (i * 8)) & 0xFF));
+	}
+
+	uint32_t words[80];
+	for (size_t block = 0; block < data.size(); block += 64) {
+		for (int i = 0; i < 16; i++) {
+			words[i] = (static_cast<uint32_t>(static_cast<unsigned char>(data[block + (i * 4)])) << 24) |
+				(static_cast<uint32_t>(static_cast<unsigned char>(data[block + (i * 4) + 1])) << 16) |
+				(static_cast<uint32_t>(static_cast<unsigned char>(data[block + (i * 4) + 2])) << 8) |
+				static_cast<uint32_t>(static_cast<unsigned char>(data[block + (i * 4) + 3]));
+		}
+		for (int i = 16; i < 80; i++) {
+			words[i] = RotateLeft(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+		}
+
+		uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3], e = hash[4];
+		for (int i = 0; i < 80; i++) {
+			uint32_t f, k;
+			if (i < 20) {
+				f = (b & c) | ((~b) & d);
+				k = 0x5A827999;
+			}
+			else if (i < 40) {
+				f = b ^ c ^ d;
+				k = 0x6ED9EBA1;
+			}
+			else if (i < 60) {
+				f = (b & c) | (b & d) | (c & d);
+				k = 0x8F1BBCDC;
+			}
+			else {
+				f = b ^ c ^ d;
+				k = 0xCA62C1D6;
+			}
+			uint32_t temp = RotateLeft(a, 5) + f + e + k + words[i];
+			e = d;
+			d = c;
+			c = RotateLeft(b, 30);
+			b = a;
+			a = temp;
+		}
+		hash[0] += a;
+		hash[1] += b;
+		hash[2] += c;
+		hash[3] += d;
+		hash[4] += e;
+	}
+
+	for (int i = 0; i < 5; i++) {
+		digest[i * 4] = static_cast<unsigned char>(hash[i] >> 24);
+		digest[(i * 4) + 1] = static_cast<unsigned char>(hash[i] >> 16);
+		digest[(i * 4) + 2] = static_cast<unsigned char>(hash[i] >> 8);
+		digest[(i * 4) + 3] = static_cast<unsigned char>(hash[i]);
+	}
+}
+
+static std::string Base64(const unsigned char* data, size_t length) {
+	const char characters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string encoded;
+	for (size_t i = 0; i < length; i += 3) {
+		uint32_t triple = static_cast<uint32_t>(data[i]) << 16;
+		if (i + 1 < length) {
+			triple |= static_cast<uint32_t>(data[i + 1]) << 8;
+		}
+		if (i + 2 < length) {
+			triple |= data[i + 2];
+		}
+		encoded.push_back(characters[(triple >> 18) & 0x3F]);
+		encoded.push_back(characters[(triple >> 12) & 0x3F]);
+		encoded.push_back((i + 1 < length) ? characters[(triple >> 6) & 0x3F] : '=');
+		encoded.push_back((i + 2 < length) ? characters[triple & 0x3F] : '=');
+	}
+	return encoded;
+}
+
+// The Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+static std::string AcceptKey(const std::string& key) {
+	unsigned char digest[20];
+	Sha1(key + WEBSOCKET_GUID, digest);
+	return Base64(digest, sizeof(digest));
+}
+
+// Header of an unmasked frame, as sent by a server
+static std::string FrameHeader(unsigned char opcode, size_t length) {
+	std::string header;
+	header.push_back(static_cast<char>(FINAL_FRAME | opcode));
+	if (length < 126) {
+		header.push_back(static_cast<char>(length));
+	}
+	else if (length <= 0xFFFF) {
+		header.push_back(126);
+		header.push_back(static_cast<char>((length >> 8) & 0xFF));
+		header.push_back(static_cast<char>(length & 0xFF));
+	}
+	else {
+		header.push_back(127);
+		for (int i = 7; i >= 0; i--) {
+			header.push_back(static_cast<char>((static_cast<unsigned long long>(length) >> (i * 8)) & 0xFF));
+		}
+	}
+	return header;
+}
+
+// A complete HTTP response, the connection is closed once it has been sent
+static std::string HttpResponse(const char* status, const char* contentType, const std::string& body) {
+	return std::string("HTTP/1.1 ") + status + "\r\n" +
+		"Content-Type: " + contentType + "\r\n" +
+		"Content-Length: " + std::to_string(body.size()) + "\r\n" +
+		"Cache-Control: no-store\r\n" +
+		"Connection: close\r\n\r\n" + body;
+}
+
+static std::string ToLower(std::string text) {
+	std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+	return text;
+}
+
+static std::string Trim(const std::string& text) {
+	size_t first = text.find_first_not_of(" \t");
+	if (first == std::string::npos) {
+		return std::string();
+	}
+	return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+void JsonWriter::Begin(void) {
+	text.clear();
+	text.push_back('{');
+}
+
+void JsonWriter::AddField(const char* name, double value, int decimals) {
+	AddName(name);
+	char digits[FIXED_POINT_SIZE];
+	size_t count = FormatFixedPoint(value, decimals, digits);
+	if (count == 0) {
+		text.append("null");
+	}
+	else {
+		text.append(digits, count);
+	}
+}
+
+void JsonWriter::AddField(const char* name, bool value) {
+	AddName(name);
+	text.append(value ? "true" : "false");
+}
+
+void JsonWriter::End(void) {
+	text.push_back('}');
+}
+
+// Names are our own identifiers, so need no escaping
+void JsonWriter::AddName(const char* name) {
+	if (text.size() > 1) {
+		text.push_back(',');
+	}
+	text.push_back('"');
+	text.append(name);
+	text.append("\":");
+}
+
+LiveDataServer::LiveDataServer() {
+	snapshotHeaderLength = 0;
+	snapshotRevision = 0;
+	listener = NO_SOCKET;
+	waker = NO_SOCKET;
+	wakePort = 0;
+	isRunning = false;
+	isStopping = false;
+	clientCount = 0;
+	droppedClients = 0;
+}
+
+LiveDataServer::~LiveDataServer() {
+	Stop();
+}
+
+bool LiveDataServer::Start(int port) {
+	if (isRunning) {
+		Stop();
+	}
+
+	if (!StartSockets()) {
+		return false;
+	}
+
+	waker = OpenWakeSocket(wakePort);
+	listener = OpenListener(port);
+	if ((waker == NO_SOCKET) || (listener == NO_SOCKET)) {
+		CloseSockets();
+		FinishSockets();
+		return false;
+	}
+
+	page = std::make_shared<const std::string>(HttpResponse("200 OK", "text/html; charset=utf-8", LIVE_DATA_PAGE));
+	snapshot.reset();
+	snapshotHeaderLength = 0;
+	snapshotRevision = 0;
+	deltas.clear();
+	clientCount = 0;
+	isStopping = false;
+	isRunning = true;
+	thread = std::thread(&LiveDataServer::Run, this);
+	return true;
+}
+
+void LiveDataServer::Stop(void) {
+	if (!isRunning) {
+		return;
+	}
+
+	isStopping = true;
+	Wake();
+	if (thread.joinable()) {
+		thread.join();
+	}
+	isRunning = false;
+	CloseSockets();
+	FinishSockets();
+}
+
+void LiveDataServer::Publish(const std::string& json) {
+	if (!isRunning) {
+		return;
+	}
+
+	// Framed once, the same frame is sent to every connection
+	std::string header = FrameHeader(OPCODE_TEXT, json.size());
+	std::shared_ptr<const std::string> frame = std::make_shared<const std::string>(header + json);
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		snapshot = frame;
+		snapshotHeaderLength = header.size();
+		snapshotRevision++;
+	}
+	Wake();
+}
+
+void LiveDataServer::PublishDelta(const std::string& json) {
+	if (!isRunning) {
+		return;
+	}
+
+	std::shared_ptr<const std::string> frame = std::make_shared<const std::string>(FrameHeader(OPCODE_TEXT, json.size()) + json);
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		deltas.push_back(frame);
+	}
+	Wake();
+}
+
+void LiveDataServer::Wake(void) {
+	WakeSocket(waker, wakePort);
+}
+
+void LiveDataServer::Run(void) {
+
+	std::vector<Connection> connections;
+	std::vector<PollDescriptor> descriptors;
+	std::vector<std::shared_ptr<const std::string>> collected;
+
+	while (!isStopping) {
+
+		// The wake socket, the listener and the connections
+		descriptors.clear();
+		PollDescriptor descriptor;
+		descriptor.fd = waker;
+		descriptor.events = POLLIN;
+		descriptor.revents = 0;
+		descriptors.push_back(descriptor);
+		bool isAccepting = connections.size() < MAXIMUM_CONNECTIONS;
+		if (isAccepting) {
+			descriptor.fd = listener;
+			descriptors.push_back(descriptor);
+		}
+		size_t firstConnection = descriptors.size();
+		for (const Connection& connection : connections) {
+			descriptor.fd = connection.socket;
+			descriptor.events = connection.queue.empty() ? POLLIN : POLLIN | POLLOUT;
+			descriptors.push_back(descriptor);
+		}
+
+		if (PollSockets(descriptors.data(), static_cast<unsigned long>(descriptors.size()), POLL_TIMEOUT) < 0) {
+			continue;
+		}
+
+		if (descriptors[0].revents & POLLIN) {
+			ClearWakeSocket(waker);
+		}
+
+		long long now = GetMilliseconds();
+
+		if ((isAccepting) && (descriptors[1].revents & POLLIN)) {
+			SocketHandle accepted;
+			while ((connections.size() < MAXIMUM_CONNECTIONS) && ((accepted = accept(listener, nullptr, nullptr)) != NO_SOCKET)) {
+				SetClientOptions(accepted);
+				Connection connection;
+				connection.socket = accepted;
+				connection.isWebSocket = false;
+				connection.isSignalK = false;
+				connection.isClosing = false;
+				connection.offset = 0;
+				connection.isSnapshotQueued = false;
+				connection.revision = 0;
+				connection.lastActivity = now;
+				connections.push_back(std::move(connection));
+			}
+		}
+
+		for (size_t i = 0; i < connections.size(); i++) {
+			Connection& connection = connections[i];
+			short events = (firstConnection + i < descriptors.size()) ? descriptors[firstConnection + i].revents : 0;
+			if (events & (POLLERR | POLLNVAL)) {
+				CloseSocket(connection.socket);
+				connection.socket = NO_SOCKET;
+			}
+			// A hang up is seen by the read returning zero
+			else if ((events & (POLLIN | POLLHUP)) && (!Receive(connection))) {
+				CloseSocket(connection.socket);
+				connection.socket = NO_SOCKET;
+			}
+		}
+
+		// Queue the latest snapshot, replacing one that has not been started
+		std::shared_ptr<const std::string> latest;
+		unsigned long long revision;
+		collected.clear();
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			latest = snapshot;
+			revision = snapshotRevision;
+			collected.swap(deltas);
+		}
+		if (latest) {
+			for (Connection& connection : connections) {
+				if ((connection.socket == NO_SOCKET) || (!connection.isWebSocket) || (connection.isSignalK) ||
+					(connection.isClosing) || (connection.revision == revision)) {
+					continue;
+				}
+				bool isStarted = (connection.queue.size() == 1) && (connection.offset > 0);
+				if ((connection.isSnapshotQueued) && (!isStarted)) {
+					connection.queue.back() = latest;
+				}
+				else {
+					if (connection.queue.empty()) {
+						connection.lastActivity = now;
+					}
+					connection.queue.push_back(latest);
+					connection.isSnapshotQueued = true;
+				}
+				connection.revision = revision;
+			}
+		}
+
+		// Every delta is queued to every SignalK connection
+		for (Connection& connection : connections) {
+			if ((connection.socket == NO_SOCKET) || (!connection.isSignalK) || (connection.isClosing) || (collected.empty())) {
+				continue;
+			}
+			if (connection.queue.empty()) {
+				connection.lastActivity = now;
+			}
+			connection.queue.insert(connection.queue.end(), collected.begin(), collected.end());
+			connection.isSnapshotQueued = false;
+			if (connection.queue.size() > MAXIMUM_QUEUED) {
+				CloseSocket(connection.socket);
+				connection.socket = NO_SOCKET;
+				droppedClients++;
+			}
+		}
+
+		for (Connection& connection : connections) {
+			if (connection.socket == NO_SOCKET) {
+				continue;
+			}
+			if (!Send(connection)) {
+				CloseSocket(connection.socket);
+				connection.socket = NO_SOCKET;
+				continue;
+			}
+			if (!connection.queue.empty()) {
+				if (now - connection.lastActivity > SEND_TIMEOUT) {
+					CloseSocket(connection.socket);
+					connection.socket = NO_SOCKET;
+					droppedClients++;
+				}
+			}
+			else if ((connection.isClosing) || ((!connection.isWebSocket) && (now - connection.lastActivity > REQUEST_TIMEOUT))) {
+				CloseSocket(connection.socket);
+				connection.socket = NO_SOCKET;
+			}
+		}
+
+		// Remove the connections that were closed
+		size_t kept = 0;
+		int webSockets = 0;
+		for (size_t i = 0; i < connections.size(); i++) {
+			if (connections[i].socket != NO_SOCKET) {
+				if (connections[i].isWebSocket) {
+					webSockets++;
+				}
+				if (kept != i) {
+					connections[kept] = std::move(connections[i]);
+				}
+				kept++;
+			}
+		}
+		connections.resize(kept);
+		clientCount = webSockets;
+	}
+
+	for (Connection& connection : connections) {
+		CloseSocket(connection.socket);
+	}
+	clientCount = 0;
+}
+
+// Returns false if the connection should be closed
+bool LiveDataServer::Receive(Connection& connection) {
+	char buffer[1024];
+	while (true) {
+		int received = recv(connection.socket, buffer, sizeof(buffer), 0);
+		if (received == 0) {
+			return false;
+		}
+		if (received < 0) {
+			return IsWouldBlock();
+		}
+		// Anything received once closing is ignored
+		if (connection.isClosing) {
+			continue;
+		}
+		connection.input.append(buffer, received);
+		if (!(connection.isWebSocket ? HandleFrames(connection) : HandleRequest(connection))) {
+			return false;
+		}
+	}
+}
+
+bool LiveDataServer::HandleRequest(Connection& connection) {
+	size_t requestEnd = connection.input.find("\r\n\r\n");
+	if (requestEnd == std::string::npos) {
+		return connection.input.size() <= MAXIMUM_REQUEST;
+	}
+
+	// eg. GET /live HTTP/1.1, followed by the headers
+	size_t lineEnd = connection.input.find("\r\n");
+	std::string requestLine = connection.input.substr(0, lineEnd);
+	size_t methodEnd = requestLine.find(' ');
+	size_t pathEnd = requestLine.find(' ', methodEnd + 1);
+	if ((methodEnd == std::string::npos) || (pathEnd == std::string::npos)) {
+		return false;
+	}
+	std::string method = requestLine.substr(0, methodEnd);
+	std::string path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+	path = path.substr(0, path.find('?'));
+
+	std::string upgrade, key, version, host;
+	size_t lineStart = lineEnd + 2;
+	while (lineStart < requestEnd) {
+		lineEnd = connection.input.find("\r\n", lineStart);
+		size_t separator = connection.input.find(':', lineStart);
+		if ((separator != std::string::npos) && (separator < lineEnd)) {
+			std::string name = ToLower(Trim(connection.input.substr(lineStart, separator - lineStart)));
+			std::string value = Trim(connection.input.substr(separator + 1, lineEnd - separator - 1));
+			if (name == "upgrade") {
+				upgrade = ToLower(value);
+			}
+			else if (name == "sec-websocket-key") {
+				key = value;
+			}
+			else if (name == "sec-websocket-version") {
+				version = value;
+			}
+			else if (name == "host") {
+				host = value;
+			}
+		}
+		lineStart = lineEnd + 2;
+	}
+
+	// Anything following the request is the start of the WebSocket frames
+	connection.input.erase(0, requestEnd + 4);
+
+	if (method != "GET") {
+		connection.queue.push_back(std::make_shared<const std::string>(HttpResponse("405 Method Not Allowed", "text/plain", "")));
+		connection.isClosing = true;
+		return true;
+	}
+
+	if (upgrade == "websocket") {
+		if ((key.empty()) || (version != "13") || ((path != LIVE_DATA_PATH) && (path != SIGNALK_STREAM_PATH))) {
+			connection.queue.push_back(std::make_shared<const std::string>(
+				"HTTP/1.1 426 Upgrade Required\r\nSec-WebSocket-Version: 13\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"));
+			connection.isClosing = true;
+			return true;
+		}
+		connection.queue.push_back(std::make_shared<const std::string>(
+			"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " +
+			AcceptKey(key) + "\r\n\r\n"));
+		connection.isWebSocket = true;
+		if (path == SIGNALK_STREAM_PATH) {
+			// SignalK clients expect a hello message first
+			std::string hello = std::string("{\"name\":\"OpenCPN Racing Plugin\",\"version\":\"") + SIGNALK_VERSION +
+				"\",\"self\":\"vessels.self\",\"roundTripMeasurements\":false}";
+			connection.queue.push_back(std::make_shared<const std::string>(FrameHeader(OPCODE_TEXT, hello.size()) + hello));
+			connection.isSignalK = true;
+		}
+		return HandleFrames(connection);
+	}
+
+	if ((path == "/") || (path == "/index.html")) {
+		connection.queue.push_back(page);
+	}
+	else if (path == "/data") {
+		std::string json = "{}";
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (snapshot) {
+				json = snapshot->substr(snapshotHeaderLength);
+			}
+		}
+		connection.queue.push_back(std::make_shared<const std::string>(HttpResponse("200 OK", "application/json", json)));
+	}
+	else if ((path == "/signalk") || (path == "/signalk/")) {
+		// Discovery, from which a SignalK client finds the stream
+		std::string discovery = std::string("{\"endpoints\":{\"v1\":{\"version\":\"") + SIGNALK_VERSION +
+			"\",\"signalk-ws\":\"ws://" + host + SIGNALK_STREAM_PATH + "\"}},\"server\":{\"id\":\"racing-plugin\"}}";
+		connection.queue.push_back(std::make_shared<const std::string>(HttpResponse("200 OK", "application/json", discovery)));
+	}
+	else {
+		connection.queue.push_back(std::make_shared<const std::string>(HttpResponse("404 Not Found", "text/plain", "")));
+	}
+	connection.isClosing = true;
+	return true;
+}
+
+// Frames from a browser are masked. Pings are answered and a close is echoed, anything else,
+// such as a SignalK subscription, is ignored
+bool LiveDataServer::HandleFrames(Connection& connection) {
+	std::string& input = connection.input;
+	while (input.size() >= 2) {
+		unsigned char opcode = static_cast<unsigned char>(input[0]) & 0x0F;
+		bool isMasked = (static_cast<unsigned char>(input[1]) & 0x80) != 0;
+		unsigned long long length = static_cast<unsigned char>(input[1]) & 0x7F;
+		size_t headerLength = 2;
+		if (length == 126) {
+			if (input.size() < 4) {
+				return true;
+			}
+			length = (static_cast<unsigned long long>(static_cast<unsigned char>(input[2])) << 8) | static_cast<unsigned char>(input[3]);
+			headerLength = 4;
+		}
+		else if (length == 127) {
+			if (input.size() < 10) {
+				return true;
+			}
+			length = 0;
+			for (int i = 2; i < 10; i++) {
+				length = (length << 8) | static_cast<unsigned char>(input[i]);
+			}
+			headerLength = 10;
+		}
+
+		if ((!isMasked) || (length > MAXIMUM_MESSAGE)) {
+			return false;
+		}
+		if (input.size() < headerLength + 4 + length) {
+			return true;
+		}
+
+		const char* mask = input.data() + headerLength;
+		std::string payload = input.substr(headerLength + 4, static_cast<size_t>(length));
+		for (size_t i = 0; i < payload.size(); i++) {
+			payload[i] ^= mask[i % 4];
+		}
+		input.erase(0, headerLength + 4 + static_cast<size_t>(length));
+
+		if (opcode == OPCODE_CLOSE) {
+			// Echo the status code, then close once it has been sent
+			connection.queue.push_back(std::make_shared<const std::string>(FrameHeader(OPCODE_CLOSE, std::min<size_t>(payload.size(), 2)) + payload.substr(0, 2)));
+			connection.isSnapshotQueued = false;
+			connection.isClosing = true;
+			input.clear();
+			return true;
+		}
+		if (opcode == OPCODE_PING) {
+			connection.queue.push_back(std::make_shared<const std::string>(FrameHeader(OPCODE_PONG, payload.size()) + payload));
+			connection.isSnapshotQueued = false;
+		}
+		if (connection.queue.size() > MAXIMUM_QUEUED) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Send as much as the connection will accept without blocking. Returns false if the connection failed
+bool LiveDataServer::Send(Connection& connection) {
+	while (!connection.queue.empty()) {
+		const std::string& data = *connection.queue.front();
+		int sent = send(connection.socket, data.data() + connection.offset, static_cast<int>(data.size() - connection.offset), SEND_FLAGS);
+		if (sent < 0) {
+			return IsWouldBlock();
+		}
+		connection.offset += sent;
+		connection.lastActivity = GetMilliseconds();
+		if (connection.offset == data.size()) {
+			connection.queue.pop_front();
+			connection.offset = 0;
+		}
+	}
+	connection.isSnapshotQueued = false;
+	return true;
+}
+
+void LiveDataServer::CloseSockets(void) {
+	if (listener != NO_SOCKET) {
+		CloseSocket(listener);
+		listener = NO_SOCKET;
+	}
+	if (waker != NO_SOCKET) {
+		CloseSocket(waker);
+		waker = NO_SOCKET;
+	}
+}
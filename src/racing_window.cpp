@@ -56,6 +56,8 @@ void RacingWindow::Initialize(void) {
 	labelTimer->SetFont( bigFont );
 	labelDistance->SetFont( bigFont );
 	labelTTG->SetFont( bigFont );
+	labelBurn->SetFont( bigFont );
+	labelOCS->SetFont( bigFont );
 		
 	// Ensure the dialog is sized correctly	
 	Fit();
@@ -74,6 +76,11 @@ void RacingWindow::Initialize(void) {
 	// Initialize state of whether we have pinged the port & starboard ends of the start line
 	portMark = false;
 	starboardMark = false;
+
+	// Countdown is started manually until a UTC gun time is scheduled
+	isGunScheduled = false;
+	gunTime = 0;
+	startTime = 0;
 }
 
 void RacingWindow::OnClose(wxCloseEvent& event) {
@@ -100,7 +107,17 @@ void RacingWindow::Close() {
 void RacingWindow::OnTimer(wxTimerEvent& event) {
 
 	// Display the stopwatch
-	totalSeconds -= 1;
+	if (isGunScheduled) {
+		// Derive the countdown from GPS time rather than counting timer ticks, 
+		// so that it neither drifts nor depends on when the button was pressed
+		long long remaining = gunTime - gpsClock.GetUTCMilliseconds();
+		// Round towards the gun, eg. 4:59.5 is displayed as 5:00
+		totalSeconds = remaining >= 0 ? static_cast<int>((remaining + 999) / 1000) : -static_cast<int>(-remaining / 1000);
+		ScheduleNextTick(remaining);
+	}
+	else {
+		totalSeconds -= 1;
+	}
 	int minutes = trunc(totalSeconds / 60);
 	int seconds = totalSeconds - (minutes * 60);
 	if (totalSeconds < 0) {
@@ -114,48 +131,45 @@ void RacingWindow::OnTimer(wxTimerEvent& event) {
 	labelSpeed->SetLabel(wxString::Format("%02.2f %s",toUsrSpeed_Plugin(speedOverGround), 
 		getUsrSpeedUnit_Plugin()));
 	
-	// If we've pinged each end of the start line
-	if ((portMark) && (starboardMark)) {
-		double distance;
-		// Determine if our current course crosses the start line
-		if (CalculateIntersection(starboardLatitude, starboardLongitude, startLineBearing, currentLatitude, currentLongitude, courseOverGround, &intersectLatitude, &intersectLongitude)) {
-			
-			if (IsWithinBoundingBox(intersectLatitude, intersectLongitude)) {
-				// Calculate distance from our current position to where we intersect with the start line
-				distance = HaversineFormula(currentLatitude, currentLongitude, intersectLatitude, intersectLongitude);
-				// Calculate how long to cross the start line, given our current speed.
-				if (wxFinite(distance / speedOverGround) != 0) {
-					double ttg = distance / speedOverGround;
-					minutes = floor(ttg * 60);
-					seconds = ((ttg * 60) - minutes) * 60;
-					labelTTG->SetLabel(wxString::Format("%d:%02d", minutes, seconds));
-				}
-				else {
-					// Not crossing start line at current speed
-					labelTTG->SetLabel("...");
-				}
-			}
-			else {
-				 // Not crosing start line between port & starboard marks
-				labelTTG->SetLabel("---");
-				// Calculate distance from our current position to starborad mark
-				distance = HaversineFormula(currentLatitude, currentLongitude, starboardLatitude, starboardLongitude);
-			}
+	// If we've pinged each end of the start line, display the OCS predictor's results
+	if ((portMark) && (starboardMark) && (ocsPrediction.isValid)) {
+		if (isnan(ocsPrediction.timeToLine)) {
+			// Already over, or not closing the start line at current speed
+			labelTTG->SetLabel(ocsPrediction.distanceToLine < 0 ? "OCS" : "...");
+		}
+		else if (!ocsPrediction.isWithinLine) {
+			// Not crossing start line between port & starboard marks
+			labelTTG->SetLabel("---");
 		}
 		else {
-			// Current course does not cross start line 
-			labelTTG->SetLabel("xxx");
-			// Calculate distance from our current position to starborad mark
-			distance = HaversineFormula(currentLatitude, currentLongitude, starboardLatitude, starboardLongitude);
+			minutes = static_cast<int>(ocsPrediction.timeToLine) / 60;
+			seconds = static_cast<int>(ocsPrediction.timeToLine) % 60;
+			labelTTG->SetLabel(wxString::Format("%d:%02d", minutes, seconds));
 		}
-		// Display distance in user's units
-		labelDistance->SetLabel(wxString::Format("%5.2f %s", toUsrDistance_Plugin(distance),
+
+		// Display perpendicular distance to the line in user's units, negative if on the course side
+		labelDistance->SetLabel(wxString::Format("%5.2f %s", toUsrDistance_Plugin(ocsPrediction.distanceToLine / 1852.0),
 			getUsrDistanceUnit_Plugin()));
+
+		// Time to burn, and the probability of being over at the gun
+		if (isnan(ocsPrediction.timeToBurn)) {
+			labelBurn->SetLabel("--:--");
+			labelOCS->SetLabel("--");
+			labelOCS->SetForegroundColour(labelTTG->GetForegroundColour());
+		}
+		else {
+			int burn = static_cast<int>(round(fabs(ocsPrediction.timeToBurn)));
+			labelBurn->SetLabel(wxString::Format("%c%d:%02d", ocsPrediction.timeToBurn < 0 ? '-' : '+', burn / 60, burn % 60));
+			labelOCS->SetLabel(wxString::Format("OCS %d%%", static_cast<int>(round(ocsPrediction.probabilityOver * 100.0))));
+			labelOCS->SetForegroundColour(ocsPrediction.probabilityOver >= 0.5 ? *wxRED : labelTTG->GetForegroundColour());
+		}
 	}
 	else {
 		// Have yet to ping each end of the start line
 		labelTTG->SetLabel("<->");
 		labelDistance->SetLabel("<->");
+		labelBurn->SetLabel("<->");
+		labelOCS->SetLabel("<->");
 	}
 }
 
@@ -164,44 +178,120 @@ void RacingWindow::OnReset(wxCommandEvent &event) {
 	if (stopWatch->IsRunning()) {
 		stopWatch->Stop();
 	}
+	isGunScheduled = false;
 	ResetTimer();
 }
 
 void RacingWindow::OnStart(wxCommandEvent &event) {
 
+	isGunScheduled = false;
 	totalSeconds = defaultTimerValue;
+	startTime = GpsClock::GetLocalMilliseconds();
 	stopWatch->Start(1000, wxTIMER_CONTINUOUS);
 } 
 
+double RacingWindow::GetSecondsToGun(void) {
+
+	if (!stopWatch->IsRunning()) {
+		return NAN;
+	}
+	if (isGunScheduled) {
+		return (gunTime - gpsClock.GetUTCMilliseconds()) / 1000.0;
+	}
+	return defaultTimerValue - ((GpsClock::GetLocalMilliseconds() - startTime) / 1000.0);
+}
+
+// Schedule the start gun at an absolute UTC time, as used by the race committee
+void RacingWindow::OnGunTime(wxCommandEvent &event) {
+
+	// All three fields are required, anything following them is rejected
+	int hours, minutes, seconds;
+	char trailing;
+	if ((wxSscanf(textGunTime->GetValue().Strip(wxString::both), "%d:%d:%d%c", &hours, &minutes, &seconds, &trailing) != 3) ||
+		(hours < 0) || (hours > 23) || (minutes < 0) || (minutes > 59) || (seconds < 0) || (seconds > 59)) {
+		wxMessageBox("Enter the time of the gun as hh:mm:ss UTC", "Race Start Display", wxOK | wxICON_WARNING);
+		return;
+	}
+
+	if (!gpsClock.IsSynchronised()) {
+		wxMessageBox("GPS time (ZDA, RMC or PGN 126992) is not yet available", "Race Start Display", wxOK | wxICON_WARNING);
+		return;
+	}
+
+	const long long millisecondsPerDay = 86400000LL;
+	long long now = gpsClock.GetUTCMilliseconds();
+	gunTime = (now - (now % millisecondsPerDay)) + (((hours * 3600LL) + (minutes * 60LL) + seconds) * 1000LL);
+
+	// Pick the gun nearest to now, in case the start is either side of midnight UTC
+	if (gunTime - now > millisecondsPerDay / 2) {
+		gunTime -= millisecondsPerDay;
+	}
+	else if (now - gunTime > millisecondsPerDay / 2) {
+		gunTime += millisecondsPerDay;
+	}
+
+	wxLogMessage("Racing Plugin, Gun scheduled at %s UTC, GPS clock jitter %lld ms", textGunTime->GetValue(), gpsClock.GetJitter());
+
+	isGunScheduled = true;
+	if (stopWatch->IsRunning()) {
+		stopWatch->Stop();
+	}
+	// Fire immediately to display the countdown, thereafter aligned to GPS seconds
+	stopWatch->StartOnce(1);
+}
+
+// Fire just after the next whole second of GPS time, so the display changes within a few milliseconds of the true second
+void RacingWindow::ScheduleNextTick(long long remainingMilliseconds) {
+
+	long long delay = remainingMilliseconds % 1000;
+	if (delay <= 0) {
+		delay += 1000;
+	}
+	// A couple of milliseconds of slack ensures we wake after, not before, the second boundary
+	stopWatch->StartOnce(static_cast<int>(delay) + 2);
+}
+
 void RacingWindow::OnStarboard(wxCommandEvent &event) {
 
+	// Notify parent to ping the starboard end, the button turns green once the ping is complete
+	buttonStarboard->SetBackgroundColour(*wxYELLOW);
+	wxCommandEvent *commandEvent = new wxCommandEvent(wxEVT_RACE_DIALOG_EVENT, RACE_DIALOG_STBD);
+	wxQueueEvent(eventHandlerAddress, commandEvent);
+}
+
+void RacingWindow::OnPort(wxCommandEvent &event) {
+
+	// Notify parent to ping the port end
+	buttonPort->SetBackgroundColour(*wxYELLOW);
+	wxCommandEvent *commandEvent = new wxCommandEvent(wxEVT_RACE_DIALOG_EVENT, RACE_DIALOG_PORT);
+	wxQueueEvent(eventHandlerAddress, commandEvent);
+}
+
+void RacingWindow::SetStarboardMark(double latitude, double longitude, double confidenceRadius) {
+
 	// Save the position for the Starboard Mark
-	starboardLatitude = currentLatitude;
-	starboardLongitude = currentLongitude;
+	starboardLatitude = latitude;
+	starboardLongitude = longitude;
 	starboardMark = true;
 	buttonStarboard->SetBackgroundColour(*wxGREEN);
-	// Notify parent to drop a waypoint at the starboard end
-	wxCommandEvent *commandEvent = new wxCommandEvent(wxEVT_RACE_DIALOG_EVENT, RACE_DIALOG_STBD);
-	wxQueueEvent(eventHandlerAddress, commandEvent);
+	buttonStarboard->SetToolTip(wxString::Format("Starboard mark within %.1f m", confidenceRadius));
 	// If we've pinged both ends calculate the bearing of the start line
 	if (portMark && starboardMark) {
-		startLineBearing = BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
+		startLineBearing = StartLineBias::BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
 	}
 }
 
-void RacingWindow::OnPort(wxCommandEvent &event) {
+void RacingWindow::SetPortMark(double latitude, double longitude, double confidenceRadius) {
 
 	// Save the position for the Port Mark
-	portLatitude = currentLatitude;
-	portLongitude = currentLongitude;
+	portLatitude = latitude;
+	portLongitude = longitude;
 	portMark = true;
-	buttonPort->SetBackgroundColour(*wxGREEN);	
-	// Notify parent to drop a waypoint at the port end
-	wxCommandEvent *commandEvent = new wxCommandEvent(wxEVT_RACE_DIALOG_EVENT, RACE_DIALOG_PORT);
-	wxQueueEvent(eventHandlerAddress, commandEvent);
+	buttonPort->SetBackgroundColour(*wxGREEN);
+	buttonPort->SetToolTip(wxString::Format("Port mark within %.1f m", confidenceRadius));
 	// If we've pinged both ends calculate the bearing of the start line
 	if (portMark && starboardMark) {
-		startLineBearing = BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
+		startLineBearing = StartLineBias::BearingBetweenPoints(starboardLatitude, starboardLongitude, portLatitude, portLongitude);
 	}
 }
 
@@ -218,6 +308,8 @@ void RacingWindow::ResetTimer(void) {
 	labelSpeed->SetLabel("STW");
 	labelDistance->SetLabel("DTD");
 	labelTTG->SetLabel("ETA");
+	labelBurn->SetLabel("BURN");
+	labelOCS->SetLabel("OCS");
 }
 
 // Navigation Formulas
@@ -290,31 +382,6 @@ bool RacingWindow::CalculateIntersection(double latitude1, double longitude1, do
 }
 
 	
-	// BUG BUG UNUSED
-	//bearing
-	//const p1 = new LatLon(52.205, 0.119);
-	//const p2 = new LatLon(48.857, 2.351);
-	//const b1 = p1.initialBearingTo(p2); // 156.2°
-	//
-	double RacingWindow::BearingBetweenPoints(double lat1, double lon1, double lat2, double lon2) {
-
-		// tanθ = sindeltaLon⋅coslat2 / coslat1⋅sinlat2 − sinlat1⋅coslat2⋅cosdeltaLon
-		// see mathforum.org/library/drmath/view/55417.html for derivation
-
-		double theta1 = lat1 * M_PI / 180;
-		double theta2 = lat2 * M_PI / 180;
-		double delta = (lon2 - lon1) * M_PI / 180;;
-
-		double x = cos(theta1) * sin(theta2) - sin(theta1) * cos(theta2) * cos(delta);
-		double y = sin(delta) * cos(theta2);
-		double bearing = atan2(y, x);
-
-		return bearing * 180 / M_PI;;
-
-		// or
-		//return fmod(atan2(sin((lon1 * M_PI / 180 )- (lon2 * M_PI / 180))*cos((lat2 * M_PI / 180)), cos((lat1* M_PI / 180))*sin((lat2* M_PI / 180)) - sin((lat1* M_PI / 180))*cos((lat2* M_PI / 180))*cos((lon1* M_PI / 180) - (lon2* M_PI / 180))), (2 * M_PI));
-	}
-
 // Determine distance between two points using the Haversine Formula
 // Refer to http://www.movable-type.co.uk/scripts/latlong.html
 double RacingWindow::HaversineFormula(double latutude1, double longitude1, double latitude2, double longitude2) {
@@ -17,7 +17,7 @@ RacingWindowBase::RacingWindowBase( wxWindow* parent, wxWindowID id, const wxStr
 	sizerWindow = new wxBoxSizer( wxVERTICAL );
 
 	wxGridSizer* sizerGrid;
-	sizerGrid = new wxGridSizer( 5, 2, 0, 0 );
+	sizerGrid = new wxGridSizer( 7, 2, 0, 0 );
 
 	labelSpeed = new wxStaticText( this, wxID_ANY, wxT("Speed"), wxDefaultPosition, wxDefaultSize, 0 );
 	labelSpeed->Wrap( -1 );
@@ -35,6 +35,16 @@ RacingWindowBase::RacingWindowBase( wxWindow* parent, wxWindowID id, const wxStr
 	labelDistance->Wrap( -1 );
 	sizerGrid->Add( labelDistance, 0, wxALL, 5 );
 
+	labelBurn = new wxStaticText( this, wxID_ANY, wxT("Burn"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelBurn->Wrap( -1 );
+	labelBurn->SetToolTip( wxT("Time to burn before the gun, negative if late") );
+	sizerGrid->Add( labelBurn, 0, wxALL, 5 );
+
+	labelOCS = new wxStaticText( this, wxID_ANY, wxT("OCS"), wxDefaultPosition, wxDefaultSize, 0 );
+	labelOCS->Wrap( -1 );
+	labelOCS->SetToolTip( wxT("Probability of being over the line at the gun") );
+	sizerGrid->Add( labelOCS, 0, wxALL, 5 );
+
 	buttonTimer = new wxButton( this, wxID_ANY, wxT("Start"), wxDefaultPosition, wxDefaultSize, 0 );
 	sizerGrid->Add( buttonTimer, 0, wxALL, 5 );
 
@@ -50,6 +60,15 @@ RacingWindowBase::RacingWindowBase( wxWindow* parent, wxWindowID id, const wxStr
 	buttonCancel = new wxButton( this, wxID_ANY, wxT("Cancel"), wxDefaultPosition, wxDefaultSize, 0 );
 	sizerGrid->Add( buttonCancel, 0, wxALL, 5 );
 
+	sizerGrid->Add( 0, 0, 1, wxEXPAND, 5 );
+
+	textGunTime = new wxTextCtrl( this, wxID_ANY, wxT("00:00:00"), wxDefaultPosition, wxDefaultSize, 0 );
+	textGunTime->SetToolTip( wxT("Time of the start gun, hh:mm:ss UTC") );
+	sizerGrid->Add( textGunTime, 0, wxALL, 5 );
+
+	buttonGunTime = new wxButton( this, wxID_ANY, wxT("UTC Gun"), wxDefaultPosition, wxDefaultSize, 0 );
+	sizerGrid->Add( buttonGunTime, 0, wxALL, 5 );
+
 
 	sizerWindow->Add( sizerGrid, 1, wxEXPAND, 5 );
 
@@ -66,6 +85,7 @@ RacingWindowBase::RacingWindowBase( wxWindow* parent, wxWindowID id, const wxStr
 	buttonPort->Connect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnPort ), NULL, this );
 	buttonStarboard->Connect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnStarboard ), NULL, this );
 	buttonCancel->Connect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnCancel ), NULL, this );
+	buttonGunTime->Connect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnGunTime ), NULL, this );
 }
 
 RacingWindowBase::~RacingWindowBase()
@@ -77,5 +97,6 @@ RacingWindowBase::~RacingWindowBase()
 	buttonPort->Disconnect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnPort ), NULL, this );
 	buttonStarboard->Disconnect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnStarboard ), NULL, this );
 	buttonCancel->Disconnect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnCancel ), NULL, this );
+	buttonGunTime->Disconnect( wxEVT_COMMAND_BUTTON_CLICKED, wxCommandEventHandler( RacingWindowBase::OnGunTime ), NULL, this );
 
 }
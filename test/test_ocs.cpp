@@ -0,0 +1,272 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Replays starts through the over early (OCS) predictor
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// Usage: test_ocs <data directory>
+// Each start is a CSV file of bow positions, courses (degrees) and speeds (metres/second) with the
+// time to the gun, the distance to the line and, where the speed has been steady for longer than
+// the acceleration horizon, the time to the line. Comment lines give the ends of the start line and
+// whether the boat was over at the gun.
+
+#include "racing_ocs.h"
+
+// STL
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// The starts replayed, in the data directory
+const char* START_FILES[] = { "ocs_on_time.csv", "ocs_early.csv", "ocs_burn_accelerate.csv", "ocs_over.csv" };
+
+// Distance to the line within five sigma of the position noise (metres)
+const double DISTANCE_TOLERANCE = 2.5;
+
+// Time to line within a second plus a fraction of the time. The speed noise of the data (metres/second)
+// is a larger fraction of a slower speed, so the fraction allows for six sigma of it
+const double TIME_TOLERANCE = 1.0;
+const double TIME_TOLERANCE_FRACTION = 0.1;
+const double SPEED_NOISE = 0.05;
+const double SPEED_NOISE_SIGMAS = 6.0;
+
+// Only predictions this close to the line are checked (seconds), further out a small speed error dominates
+const double MAXIMUM_CHECKED_TIME = 60.0;
+
+// In the last few seconds the probability of being over must be decisive
+const double DECISIVE_SECONDS = 3.0;
+const double DECISIVE_PROBABILITY = 0.9;
+
+struct StartSample {
+	long long time;
+	double latitude;
+	double longitude;
+	double course;
+	double speed;
+	double secondsToGun;
+	double distanceToLine;
+	double timeToLine;
+};
+
+struct Start {
+	double starboardLatitude;
+	double starboardLongitude;
+	double portLatitude;
+	double portLongitude;
+	bool isOver;
+	std::vector<StartSample> samples;
+};
+
+static int failures = 0;
+
+static void Fail(const char* file, const StartSample& sample, const char* message, double actual, double expected) {
+	std::printf("FAIL %s, %.1f s to gun: %s, %.3f, expected %.3f\n", file, sample.secondsToGun, message, actual, expected);
+	failures++;
+}
+
+// An empty field is NaN
+static double ParseField(const std::string& field) {
+	if (field.empty()) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+	return std::stod(field);
+}
+
+static bool LoadStart(const std::string& path, Start& start) {
+	std::ifstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	start.isOver = false;
+	start.samples.clear();
+	bool hasLine = false;
+	bool hasHeader = false;
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty()) {
+			continue;
+		}
+		if (line[0] == '#') {
+			if (std::sscanf(line.c_str(), "# line,%lf,%lf,%lf,%lf", &start.starboardLatitude, &start.starboardLongitude,
+				&start.portLatitude, &start.portLongitude) == 4) {
+				hasLine = true;
+			}
+			int over;
+			if (std::sscanf(line.c_str(), "# over,%d", &over) == 1) {
+				start.isOver = over != 0;
+			}
+			continue;
+		}
+		// Column names
+		if (!hasHeader) {
+			hasHeader = true;
+			continue;
+		}
+
+		std::vector<std::string> fields;
+		std::stringstream stream(line);
+		std::string field;
+		while (std::getline(stream, field, ',')) {
+			fields.push_back(field);
+		}
+		// A trailing empty field is not returned by getline
+		if (line.back() == ',') {
+			fields.push_back("");
+		}
+		if (fields.size() != 8) {
+			return false;
+		}
+
+		StartSample sample;
+		sample.time = std::stoll(fields[0]);
+		sample.latitude = ParseField(fields[1]);
+		sample.longitude = ParseField(fields[2]);
+		sample.course = ParseField(fields[3]);
+		sample.speed = ParseField(fields[4]);
+		sample.secondsToGun = ParseField(fields[5]);
+		sample.distanceToLine = ParseField(fields[6]);
+		sample.timeToLine = ParseField(fields[7]);
+		start.samples.push_back(sample);
+	}
+	return hasLine && (!start.samples.empty());
+}
+
+static bool IsWithin(double actual, double expected, double tolerance) {
+	return (!std::isnan(actual)) && (std::fabs(actual - expected) <= tolerance);
+}
+
+static void ReplayStart(const char* name, const Start& start) {
+	OcsPredictor predictor;
+	predictor.SetStartLine(start.starboardLatitude, start.starboardLongitude, start.portLatitude, start.portLongitude);
+
+	int checkedTimes = 0;
+	int checkedProbabilities = 0;
+	for (const StartSample& sample : start.samples) {
+		const OcsPrediction& prediction = predictor.Update(sample.time, sample.latitude, sample.longitude,
+			sample.course, sample.speed, sample.secondsToGun);
+
+		if (!prediction.isValid) {
+			Fail(name, sample, "prediction not valid", 0.0, 1.0);
+			continue;
+		}
+		if (!IsWithin(prediction.distanceToLine, sample.distanceToLine, DISTANCE_TOLERANCE)) {
+			Fail(name, sample, "distance to line", prediction.distanceToLine, sample.distanceToLine);
+		}
+
+		// Once over there is no time to the line
+		if ((sample.distanceToLine < -DISTANCE_TOLERANCE) && (!std::isnan(prediction.timeToLine))) {
+			Fail(name, sample, "time to line when over", prediction.timeToLine, std::numeric_limits<double>::quiet_NaN());
+		}
+
+		// Closer to the line, the position noise may put the bow over it
+		if ((!std::isnan(sample.timeToLine)) && (sample.timeToLine <= MAXIMUM_CHECKED_TIME) && (sample.distanceToLine > DISTANCE_TOLERANCE)) {
+			double fraction = TIME_TOLERANCE_FRACTION + (SPEED_NOISE_SIGMAS * SPEED_NOISE / sample.speed);
+			double tolerance = (sample.timeToLine * fraction) + TIME_TOLERANCE;
+			if (!IsWithin(prediction.timeToLine, sample.timeToLine, tolerance)) {
+				Fail(name, sample, "time to line", prediction.timeToLine, sample.timeToLine);
+			}
+			double timeToBurn = sample.secondsToGun - sample.timeToLine;
+			if (!IsWithin(prediction.timeToBurn, timeToBurn, tolerance)) {
+				Fail(name, sample, "time to burn", prediction.timeToBurn, timeToBurn);
+			}
+			checkedTimes++;
+		}
+
+		if ((std::isnan(prediction.probabilityOver)) || (prediction.probabilityOver < 0.0) || (prediction.probabilityOver > 1.0)) {
+			Fail(name, sample, "probability over out of range", prediction.probabilityOver, 0.5);
+		}
+		else if ((sample.secondsToGun > 0.0) && (sample.secondsToGun <= DECISIVE_SECONDS)) {
+			bool isDecisive = start.isOver ? prediction.probabilityOver >= DECISIVE_PROBABILITY :
+				prediction.probabilityOver <= 1.0 - DECISIVE_PROBABILITY;
+			if (!isDecisive) {
+				Fail(name, sample, "probability over", prediction.probabilityOver, start.isOver ? 1.0 : 0.0);
+			}
+			checkedProbabilities++;
+		}
+	}
+
+	// Each start must have exercised the checks it was recorded for
+	if ((checkedProbabilities == 0) || ((!start.isOver) && (checkedTimes == 0))) {
+		std::printf("FAIL %s: %d times and %d probabilities checked\n", name, checkedTimes, checkedProbabilities);
+		failures++;
+	}
+	std::printf("%s: %zu samples, %d times and %d probabilities checked\n", name, start.samples.size(), checkedTimes, checkedProbabilities);
+}
+
+// Without a time to the gun, there is a time to the line but nothing to burn
+static void ReplayWithoutGun(const char* name, const Start& start) {
+	OcsPredictor predictor;
+	predictor.SetStartLine(start.starboardLatitude, start.starboardLongitude, start.portLatitude, start.portLongitude);
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	for (const StartSample& sample : start.samples) {
+		const OcsPrediction& prediction = predictor.Update(sample.time, sample.latitude, sample.longitude,
+			sample.course, sample.speed, nan);
+		if ((!std::isnan(prediction.timeToBurn)) || (!std::isnan(prediction.probabilityOver))) {
+			Fail(name, sample, "burn or probability without a gun", prediction.timeToBurn, nan);
+			return;
+		}
+		if ((!std::isnan(sample.timeToLine)) && (sample.distanceToLine > DISTANCE_TOLERANCE) && (std::isnan(prediction.timeToLine))) {
+			Fail(name, sample, "no time to line without a gun", prediction.timeToLine, sample.timeToLine);
+			return;
+		}
+	}
+}
+
+// Until both ends are pinged there is no prediction
+static void PredictWithoutLine(void) {
+	OcsPredictor predictor;
+	const OcsPrediction& prediction = predictor.Update(0, 50.0, -1.0, 0.0, 4.0, 30.0);
+	if (prediction.isValid) {
+		std::printf("FAIL prediction without a start line\n");
+		failures++;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2) {
+		std::printf("Usage: test_ocs <data directory>\n");
+		return 2;
+	}
+
+	PredictWithoutLine();
+
+	for (const char* name : START_FILES) {
+		Start start;
+		if (!LoadStart(std::string(argv[1]) + "/" + name, start)) {
+			std::printf("FAIL %s: could not be loaded\n", name);
+			failures++;
+			continue;
+		}
+		ReplayStart(name, start);
+		ReplayWithoutGun(name, start);
+	}
+
+	std::printf("%s, %d failures\n", failures == 0 ? "Passed" : "Failed", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Loopback tests of the NMEA 0183 server
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// TCP clients and a UDP receiver on the loopback interface, checking that every client receives
+// the flushed blocks intact, that datagrams end at the end of a sentence, and that a client
+// that stops reading is dropped while the other clients carry on.
+
+#include "racing_server.h"
+#include "racing_socket.h"
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Same limits as the server
+const size_t MAXIMUM_QUEUED_BLOCKS = 64;
+const size_t MAXIMUM_DATAGRAM = 1400;
+
+// How long to wait for the server thread (milliseconds)
+const int WAIT_TIMEOUT = 10000;
+
+// Blocks large enough that the loopback socket buffers cannot hold the blocks queued for a
+// client that has stopped reading
+const size_t LARGE_BLOCK = 64 * 1024;
+const int LARGE_BLOCKS = 4 * MAXIMUM_QUEUED_BLOCKS;
+
+static int failures = 0;
+
+static void Fail(const char* test, const char* message) {
+	std::printf("FAIL %s: %s\n", test, message);
+	failures++;
+}
+
+static bool WaitFor(const std::function<bool(void)>& condition) {
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT);
+	while (!condition()) {
+		if (std::chrono::steady_clock::now() > end) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	return true;
+}
+
+static sockaddr_in LoopbackAddress(uint16_t port) {
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = port;
+	return address;
+}
+
+// A socket bound to a free loopback port, returned in host byte order
+static SocketHandle OpenBound(int type, int& port) {
+	SocketHandle socketHandle = socket(AF_INET, type, 0);
+	sockaddr_in address = LoopbackAddress(0);
+	SocketLength length = sizeof(address);
+	if ((socketHandle == NO_SOCKET) || (bind(socketHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) ||
+		(getsockname(socketHandle, reinterpret_cast<sockaddr*>(&address), &length) != 0)) {
+		if (socketHandle != NO_SOCKET) {
+			CloseSocket(socketHandle);
+		}
+		return NO_SOCKET;
+	}
+	port = ntohs(address.sin_port);
+	return socketHandle;
+}
+
+static int FindFreePort(void) {
+	int port = 0;
+	SocketHandle socketHandle = OpenBound(SOCK_STREAM, port);
+	if (socketHandle != NO_SOCKET) {
+		CloseSocket(socketHandle);
+	}
+	return port;
+}
+
+// A receive buffer of zero leaves the system's default
+static SocketHandle Connect(int port, int receiveBuffer = 0) {
+	SocketHandle client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client == NO_SOCKET) {
+		return NO_SOCKET;
+	}
+	// Must be set before connecting to limit the window advertised to the server
+	if (receiveBuffer > 0) {
+		setsockopt(client, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&receiveBuffer), sizeof(receiveBuffer));
+	}
+	sockaddr_in address = LoopbackAddress(htons(static_cast<uint16_t>(port)));
+	if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		CloseSocket(client);
+		return NO_SOCKET;
+	}
+	return client;
+}
+
+// Wait for some data, returns the number of bytes received, zero once closed or -1 after a timeout
+static int Receive(SocketHandle socketHandle, char* buffer, size_t length) {
+	PollDescriptor descriptor;
+	descriptor.fd = socketHandle;
+	descriptor.events = POLLIN;
+	descriptor.revents = 0;
+	if (PollSockets(&descriptor, 1, WAIT_TIMEOUT) <= 0) {
+		return -1;
+	}
+	int received = recv(socketHandle, buffer, static_cast<int>(length), 0);
+	return received < 0 ? 0 : received;
+}
+
+// Receive from a stream until a number of bytes have arrived, the connection closes or a timeout
+static std::string ReceiveStream(SocketHandle socketHandle, size_t length) {
+	std::string data;
+	std::vector<char> buffer(LARGE_BLOCK);
+	while (data.size() < length) {
+		int received = Receive(socketHandle, buffer.data(), buffer.size());
+		if (received <= 0) {
+			break;
+		}
+		data.append(buffer.data(), received);
+	}
+	return data;
+}
+
+// Sentences of around 80 characters, each with a distinct sequence number
+static std::string MakeSentences(int first, int count) {
+	std::string sentences;
+	char sentence[96];
+	for (int i = first; i < first + count; i++) {
+		std::snprintf(sentence, sizeof(sentence), "$IIXDR,G,%06d,,RACING_TEST_SENTENCE_PADDED_TO_AROUND_EIGHTY_CHARACTERS*00\r\n", i);
+		sentences.append(sentence);
+	}
+	return sentences;
+}
+
+// Every client receives the same blocks, whichever way they were appended
+static void TestTcpClients(void) {
+	const char* test = "TCP clients";
+	int port = FindFreePort();
+	NmeaServer server;
+	if ((port == 0) || (!server.Start(port, "", 0))) {
+		Fail(test, "server did not start");
+		return;
+	}
+
+	SocketHandle clients[] = { Connect(port), Connect(port) };
+	if ((clients[0] == NO_SOCKET) || (clients[1] == NO_SOCKET) || (!WaitFor([&]() { return server.GetClientCount() == 2; }))) {
+		Fail(test, "clients did not connect");
+	}
+	else {
+		std::string expected;
+		for (int block = 0; block < 10; block++) {
+			std::string sentences = MakeSentences(1 + (block * 5), 5);
+			for (size_t start = 0; start < sentences.size(); start += sentences.size() / 5) {
+				server.Append(sentences.data() + start, sentences.size() / 5);
+			}
+			server.Flush();
+			expected.append(sentences);
+		}
+		for (SocketHandle client : clients) {
+			if (ReceiveStream(client, expected.size()) != expected) {
+				Fail(test, "blocks not received intact");
+			}
+		}
+	}
+
+	for (SocketHandle client : clients) {
+		if (client != NO_SOCKET) {
+			CloseSocket(client);
+		}
+	}
+	if (!WaitFor([&]() { return server.GetClientCount() == 0; })) {
+		Fail(test, "closed clients not removed");
+	}
+	if (server.GetDroppedClients() != 0) {
+		Fail(test, "clients dropped");
+	}
+	server.Stop();
+}
+
+// A block larger than a datagram is split at the end of a sentence
+static void TestUdp(void) {
+	const char* test = "UDP";
+	int port = 0;
+	SocketHandle receiver = OpenBound(SOCK_DGRAM, port);
+	NmeaServer server;
+	if ((receiver == NO_SOCKET) || (!server.Start(0, "127.0.0.1", port))) {
+		Fail(test, "server did not start");
+		if (receiver != NO_SOCKET) {
+			CloseSocket(receiver);
+		}
+		return;
+	}
+
+	std::string expected = MakeSentences(0, 60);
+	server.Append(expected.data(), expected.size());
+	server.Flush();
+
+	std::string received;
+	int datagrams = 0;
+	char buffer[65536];
+	while (received.size() < expected.size()) {
+		int length = Receive(receiver, buffer, sizeof(buffer));
+		if (length <= 0) {
+			break;
+		}
+		if ((static_cast<size_t>(length) > MAXIMUM_DATAGRAM) || (buffer[length - 1] != '\n')) {
+			Fail(test, "datagram too large or not ending with a sentence");
+		}
+		received.append(buffer, length);
+		datagrams++;
+	}
+	if (received != expected) {
+		Fail(test, "datagrams not received intact");
+	}
+	if (datagrams < static_cast<int>((expected.size() + MAXIMUM_DATAGRAM - 1) / MAXIMUM_DATAGRAM)) {
+		Fail(test, "block not split");
+	}
+
+	server.Stop();
+	CloseSocket(receiver);
+}
+
+// A client that stops reading is dropped once more than MAXIMUM_QUEUED_BLOCKS are waiting for
+// it, while a client that keeps reading receives every block
+static void TestSlowClient(void) {
+	const char* test = "slow client";
+	int port = FindFreePort();
+	NmeaServer server;
+	if ((port == 0) || (!server.Start(port, "", 0))) {
+		Fail(test, "server did not start");
+		return;
+	}
+
+	SocketHandle reader = Connect(port);
+	SocketHandle stalled = Connect(port, 4096);
+	if ((reader == NO_SOCKET) || (stalled == NO_SOCKET) || (!WaitFor([&]() { return server.GetClientCount() == 2; }))) {
+		Fail(test, "clients did not connect");
+		server.Stop();
+		return;
+	}
+
+	// Small blocks fit in the socket buffers, so nothing is waiting and the client is kept
+	std::string expected;
+	for (int block = 0; block < static_cast<int>(MAXIMUM_QUEUED_BLOCKS) / 2; block++) {
+		std::string sentences = MakeSentences(block, 1);
+		server.Append(sentences.data(), sentences.size());
+		server.Flush();
+		expected.append(sentences);
+	}
+	if (ReceiveStream(reader, expected.size()) != expected) {
+		Fail(test, "small blocks not received intact");
+	}
+	if ((server.GetDroppedClients() != 0) || (server.GetClientCount() != 2)) {
+		Fail(test, "client dropped while its blocks fit in the socket buffers");
+	}
+
+	// The reader drains its blocks on another thread while the stalled client falls behind
+	std::string largeBlock = MakeSentences(0, static_cast<int>(LARGE_BLOCK / 80));
+	size_t largeLength = largeBlock.size() * LARGE_BLOCKS;
+	std::string readerReceived;
+	std::thread readerThread([&]() { readerReceived = ReceiveStream(reader, largeLength); });
+	for (int block = 0; block < LARGE_BLOCKS; block++) {
+		server.Append(largeBlock.data(), largeBlock.size());
+		server.Flush();
+		// Pace the blocks so only the stalled client falls behind
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	readerThread.join();
+
+	if (!WaitFor([&]() { return server.GetDroppedClients() == 1; })) {
+		Fail(test, "stalled client not dropped");
+	}
+	if (server.GetClientCount() != 1) {
+		Fail(test, "reader not kept");
+	}
+	if ((readerReceived.size() != largeLength) || (readerReceived.compare(0, largeBlock.size(), largeBlock) != 0)) {
+		Fail(test, "reader did not receive every block");
+	}
+
+	// Having started reading again, the stalled client finds its connection closed, short of the blocks
+	std::string stalledReceived = ReceiveStream(stalled, largeLength);
+	if (stalledReceived.size() >= largeLength) {
+		Fail(test, "stalled client received every block");
+	}
+
+	CloseSocket(reader);
+	CloseSocket(stalled);
+	server.Stop();
+}
+
+int main(void) {
+	if (!StartSockets()) {
+		std::printf("FAIL sockets could not be started\n");
+		return 1;
+	}
+
+	TestTcpClients();
+	TestUdp();
+	TestSlowClient();
+
+	FinishSockets();
+	std::printf("%s, %d failures\n", failures == 0 ? "Passed" : "Failed", failures);
+	return failures == 0 ? 0 : 1;
+}
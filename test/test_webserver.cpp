@@ -0,0 +1,290 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Load test of the live data server
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// Usage: test_webserver [seconds]
+// Connects 50 WebSocket clients to /live on the loopback interface and publishes 10 snapshots a
+// second, the size of those the plugin publishes. Every client must receive every snapshot, in
+// order. Reports the latency from publishing to receiving and the CPU time used by the process,
+// the server and the clients together.
+
+#include "racing_webserver.h"
+#include "racing_socket.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int CLIENTS = 50;
+const int SNAPSHOTS_PER_SECOND = 10;
+const int DEFAULT_SECONDS = 5;
+
+// Fields other than the sequence & time, so a snapshot is the size of the plugin's
+const int PADDING_FIELDS = 16;
+
+// How long to wait for the server thread (milliseconds)
+const int WAIT_TIMEOUT = 10000;
+
+// The example from RFC 6455
+const char WEBSOCKET_KEY[] = "dGhlIHNhbXBsZSBub25jZQ==";
+const char WEBSOCKET_ACCEPT[] = "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
+
+struct Client {
+	SocketHandle socket;
+	// Frames not yet parsed
+	std::string input;
+	double lastSequence;
+	int received;
+	bool isOutOfOrder;
+};
+
+static int failures = 0;
+
+static void Fail(const char* message) {
+	std::printf("FAIL %s\n", message);
+	failures++;
+}
+
+static std::chrono::steady_clock::time_point startTime;
+
+static long long ElapsedMicroseconds(void) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+static int FindFreePort(void) {
+	SocketHandle socketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	SocketLength length = sizeof(address);
+	int port = 0;
+	if ((socketHandle != NO_SOCKET) && (bind(socketHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) &&
+		(getsockname(socketHandle, reinterpret_cast<sockaddr*>(&address), &length) == 0)) {
+		port = ntohs(address.sin_port);
+	}
+	if (socketHandle != NO_SOCKET) {
+		CloseSocket(socketHandle);
+	}
+	return port;
+}
+
+// Connect and upgrade to a WebSocket on /live, returns NO_SOCKET if the server did not accept it
+static SocketHandle ConnectWebSocket(int port) {
+	SocketHandle client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client == NO_SOCKET) {
+		return NO_SOCKET;
+	}
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	std::string request = std::string("GET /live HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n") +
+		"Sec-WebSocket-Key: " + WEBSOCKET_KEY + "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+	if ((connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) ||
+		(send(client, request.data(), static_cast<int>(request.size()), SEND_FLAGS) != static_cast<int>(request.size()))) {
+		CloseSocket(client);
+		return NO_SOCKET;
+	}
+
+	// Read the response a byte at a time, so no frame following it is consumed
+	std::string response;
+	char character;
+	while (response.find("\r\n\r\n") == std::string::npos) {
+		PollDescriptor descriptor;
+		descriptor.fd = client;
+		descriptor.events = POLLIN;
+		descriptor.revents = 0;
+		if ((PollSockets(&descriptor, 1, WAIT_TIMEOUT) <= 0) || (recv(client, &character, 1, 0) != 1)) {
+			CloseSocket(client);
+			return NO_SOCKET;
+		}
+		response.push_back(character);
+	}
+	if ((response.compare(0, 12, "HTTP/1.1 101") != 0) || (response.find(WEBSOCKET_ACCEPT) == std::string::npos)) {
+		CloseSocket(client);
+		return NO_SOCKET;
+	}
+	return client;
+}
+
+static double ParseNumber(const std::string& json, const char* name) {
+	size_t start = json.find(std::string("\"") + name + "\":");
+	if (start == std::string::npos) {
+		return -1.0;
+	}
+	return std::atof(json.c_str() + start + std::strlen(name) + 3);
+}
+
+// Parse the complete frames received, each an unmasked text frame with a snapshot
+static void ParseFrames(Client& client, long long now, std::vector<long long>& latencies) {
+	while (client.input.size() >= 2) {
+		size_t length = static_cast<unsigned char>(client.input[1]) & 0x7F;
+		size_t headerLength = 2;
+		if (length == 126) {
+			if (client.input.size() < 4) {
+				return;
+			}
+			length = (static_cast<size_t>(static_cast<unsigned char>(client.input[2])) << 8) | static_cast<unsigned char>(client.input[3]);
+			headerLength = 4;
+		}
+		if (client.input.size() < headerLength + length) {
+			return;
+		}
+		std::string json = client.input.substr(headerLength, length);
+		client.input.erase(0, headerLength + length);
+
+		double sequence = ParseNumber(json, "sequence");
+		if (sequence <= client.lastSequence) {
+			client.isOutOfOrder = true;
+		}
+		client.lastSequence = sequence;
+		client.received++;
+		latencies.push_back(now - static_cast<long long>(ParseNumber(json, "time")));
+	}
+}
+
+int main(int argc, char* argv[]) {
+	int seconds = argc > 1 ? std::atoi(argv[1]) : DEFAULT_SECONDS;
+	int snapshots = std::max(1, seconds * SNAPSHOTS_PER_SECOND);
+
+	if (!StartSockets()) {
+		std::printf("FAIL sockets could not be started\n");
+		return 1;
+	}
+
+	int port = FindFreePort();
+	LiveDataServer server;
+	if ((port == 0) || (!server.Start(port))) {
+		std::printf("FAIL server did not start\n");
+		return 1;
+	}
+
+	std::vector<Client> clients;
+	for (int i = 0; i < CLIENTS; i++) {
+		SocketHandle socketHandle = ConnectWebSocket(port);
+		if (socketHandle == NO_SOCKET) {
+			Fail("client not upgraded to a WebSocket");
+			continue;
+		}
+		clients.push_back({ socketHandle, "", 0.0, 0, false });
+	}
+	std::chrono::steady_clock::time_point waitEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT);
+	while ((server.GetClientCount() != CLIENTS) && (std::chrono::steady_clock::now() < waitEnd)) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	if (server.GetClientCount() != CLIENTS) {
+		Fail("clients not connected");
+	}
+
+	// The clients are read by a single thread, until every one has the last snapshot
+	startTime = std::chrono::steady_clock::now();
+	std::vector<long long> latencies;
+	std::thread reader([&]() {
+		std::vector<PollDescriptor> descriptors(clients.size());
+		char buffer[65536];
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() +
+			std::chrono::seconds(seconds) + std::chrono::milliseconds(WAIT_TIMEOUT);
+		while (std::chrono::steady_clock::now() < end) {
+			bool isComplete = true;
+			for (size_t i = 0; i < clients.size(); i++) {
+				descriptors[i].fd = clients[i].socket;
+				descriptors[i].events = POLLIN;
+				descriptors[i].revents = 0;
+				isComplete &= clients[i].lastSequence == snapshots;
+			}
+			if (isComplete) {
+				return;
+			}
+			if (PollSockets(descriptors.data(), static_cast<unsigned long>(descriptors.size()), 100) <= 0) {
+				continue;
+			}
+			long long now = ElapsedMicroseconds();
+			for (size_t i = 0; i < clients.size(); i++) {
+				if (descriptors[i].revents & POLLIN) {
+					int received = recv(clients[i].socket, buffer, sizeof(buffer), 0);
+					if (received > 0) {
+						clients[i].input.append(buffer, received);
+						ParseFrames(clients[i], now, latencies);
+					}
+				}
+			}
+		}
+	});
+
+	std::clock_t cpuStart = std::clock();
+	JsonWriter writer;
+	for (int sequence = 1; sequence <= snapshots; sequence++) {
+		std::this_thread::sleep_until(startTime + std::chrono::milliseconds(sequence * 1000 / SNAPSHOTS_PER_SECOND));
+		writer.Begin();
+		writer.AddField("sequence", static_cast<double>(sequence), 0);
+		writer.AddField("time", static_cast<double>(ElapsedMicroseconds()), 0);
+		for (int field = 0; field < PADDING_FIELDS; field++) {
+			char name[16];
+			std::snprintf(name, sizeof(name), "field%d", field);
+			writer.AddField(name, 1000.0 * field / 7.0, 2);
+		}
+		writer.End();
+		server.Publish(writer.GetText());
+	}
+	reader.join();
+	double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+	for (const Client& client : clients) {
+		if (client.isOutOfOrder) {
+			Fail("snapshots received out of order");
+		}
+		if (client.received != snapshots) {
+			std::printf("FAIL client received %d of %d snapshots\n", client.received, snapshots);
+			failures++;
+		}
+	}
+	if (server.GetDroppedClients() != 0) {
+		Fail("clients dropped");
+	}
+
+	if (!latencies.empty()) {
+		std::sort(latencies.begin(), latencies.end());
+		std::printf("%d clients, %d snapshots: latency median %.2f ms, worst %.2f ms, CPU %.0f ms over %d s\n",
+			static_cast<int>(clients.size()), snapshots, latencies[latencies.size() / 2] / 1000.0,
+			latencies.back() / 1000.0, cpuSeconds * 1000.0, seconds);
+	}
+
+	for (const Client& client : clients) {
+		CloseSocket(client.socket);
+	}
+	server.Stop();
+	FinishSockets();
+
+	std::printf("%s, %d failures\n", failures == 0 ? "Passed" : "Failed", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Headless benchmark of the Wind Wizard gauge
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// Usage: gauge_benchmark [frames] [snapshot directory]
+// Renders the gauge into a wxMemoryDC at several sizes, by day and night and at display scales of
+// 1x, 2x and 3x, without a window or OpenCPN. For each it reports the first frame, which builds the
+// cached layers, and the average time and number of heap allocations per frame thereafter, with
+// the wind and boat moving and the heading turning a degree every ten frames.
+// A snapshot of each is then rendered with fixed values and saved as a PNG, eg.
+// gauge_400_night_2x.png, to be compared pixel by pixel against those of a previous build.
+// On Linux without a display, run it under xvfb-run.
+
+#include "racing_gauge.h"
+
+#include <wx/image.h>
+#include <wx/filename.h>
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Logical sizes of the gauge, from the control's minimum size upwards
+const int GAUGE_SIZES[] = { 250, 400, 800 };
+
+// Physical pixels per logical pixel
+const double DISPLAY_SCALES[] = { 1.0, 2.0, 3.0 };
+
+const int DEFAULT_FRAMES = 200;
+
+// Heap allocations made through operator new, ie. by the gauge and by wxWidgets' C++ classes.
+// Allocations made by the platform's drawing libraries with malloc are not counted
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void* block = std::malloc(size == 0 ? 1 : size);
+	if (block == nullptr) {
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void operator delete(void* block) noexcept {
+	std::free(block);
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete[](void* block) noexcept {
+	operator delete(block);
+}
+
+static int frameCount = DEFAULT_FRAMES;
+static wxString snapshotDirectory = ".";
+
+// Typical values on a beat, so every part of the gauge is drawn
+static void SetValues(GaugeValues& values, bool nightMode) {
+	values.magneticHeading = 42.0;
+	values.trueHeading = 40.0;
+	values.bearingToWaypoint = 75.0;
+	values.apparentWindAngle = 32.0;
+	values.trueWindAngle = 45.0;
+	values.apparentWindSpeed = 16.4;
+	values.trueWindSpeed = 12.1;
+	values.boatSpeed = 6.3;
+	values.waterDepth = 12.5;
+	values.courseOverGround = 47.0;
+	values.speedOverGround = 6.1;
+	values.driftAngle = 190.0;
+	values.driftSpeed = 0.4;
+	values.velocityMadeGood = 4.5;
+	values.nightMode = nightMode;
+	values.displayBearingToWaypoint = true;
+	values.timeToBurn = 12.0;
+	values.probabilityOver = 0.15;
+	values.displayStartPrediction = true;
+}
+
+static double ElapsedMicroseconds(std::chrono::steady_clock::time_point start) {
+	return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
+static bool RunBenchmark(int size, bool nightMode, double scale) {
+	// As many pixels as the display, measured in logical pixels, as for a window on that display
+	wxBitmap bitmap;
+	bitmap.CreateScaled(size, size, wxBITMAP_SCREEN_DEPTH, scale);
+	wxMemoryDC dc(bitmap);
+	if (!dc.IsOk()) {
+		std::printf("Could not create a %d pixel memory DC at %.0fx\n", size, scale);
+		return false;
+	}
+
+	WindWizardRenderer renderer;
+	SetValues(renderer.values, nightMode);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	renderer.Render(dc, wxSize(size, size));
+	double firstFrame = ElapsedMicroseconds(start);
+
+	long long allocationsBefore = allocationCount.load();
+	start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < frameCount; frame++) {
+		renderer.values.apparentWindAngle = 32.0 + (5.0 * ((frame % 20) - 10) / 10.0);
+		renderer.values.trueWindAngle = 45.0 + (3.0 * ((frame % 30) - 15) / 15.0);
+		renderer.values.apparentWindSpeed = 16.4 + (0.1 * (frame % 15));
+		renderer.values.boatSpeed = 6.3 + (0.1 * (frame % 7));
+		renderer.values.magneticHeading = 42.0 + (frame / 10);
+		renderer.Render(dc, wxSize(size, size));
+	}
+	double frameTime = ElapsedMicroseconds(start) / frameCount;
+	double frameAllocations = static_cast<double>(allocationCount.load() - allocationsBefore) / frameCount;
+
+	std::printf("%4d px %-5s %.0fx: first frame %8.0f us, %8.1f us/frame, %6.1f allocations/frame\n",
+		size, nightMode ? "night" : "day", scale, firstFrame, frameTime, frameAllocations);
+
+	// The same values for every build, so snapshots can be compared
+	SetValues(renderer.values, nightMode);
+	renderer.Render(dc, wxSize(size, size));
+	dc.SelectObject(wxNullBitmap);
+	wxFileName snapshot(snapshotDirectory, wxString::Format("gauge_%d_%s_%.0fx.png", size, nightMode ? "night" : "day", scale));
+	if (!bitmap.ConvertToImage().SaveFile(snapshot.GetFullPath(), wxBITMAP_TYPE_PNG)) {
+		std::printf("Could not save %s\n", static_cast<const char*>(snapshot.GetFullPath().utf8_str()));
+		return false;
+	}
+	return true;
+}
+
+// A GUI application, so the platform's drawing is initialised, but without a window
+class GaugeBenchmarkApp : public wxApp {
+public:
+	bool OnInit() override {
+		wxInitAllImageHandlers();
+		return true;
+	}
+
+	int OnRun() override {
+		bool isOk = true;
+		for (int size : GAUGE_SIZES) {
+			for (int night = 0; night < 2; night++) {
+				for (double scale : DISPLAY_SCALES) {
+					isOk &= RunBenchmark(size, night != 0, scale);
+				}
+			}
+		}
+		return isOk ? 0 : 1;
+	}
+};
+
+wxIMPLEMENT_APP_NO_MAIN(GaugeBenchmarkApp);
+
+int main(int argc, char* argv[]) {
+	if (argc > 1) {
+		frameCount = std::max(1, std::atoi(argv[1]));
+	}
+	if (argc > 2) {
+		snapshotDirectory = argv[2];
+	}
+	// Let wxWidgets see only the program name
+	int wxArgc = 1;
+	return wxEntry(wxArgc, argv);
+}
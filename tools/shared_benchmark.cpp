@@ -0,0 +1,129 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Benchmark of the shared memory export
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// Usage: shared_benchmark [seconds]
+// Measures the samples written per second, first with no reader and then with a reader on another
+// thread mapping the segment as an analysis tool would. Every field of a sample is written with
+// the same value, so a read that mixes two samples is counted as torn.
+
+#include "racing_shared.h"
+#include "shared_reader.h"
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// Not the default name, so a running plugin is not disturbed
+const char BENCHMARK_NAME[] = "opencpn-racing-benchmark";
+
+const int DEFAULT_SECONDS = 2;
+
+// Every field of the sample is set to the same value
+static void FillSample(SharedSample& sample, long long value) {
+	double* fields = reinterpret_cast<double*>(&sample.latitude);
+	const size_t fieldCount = (sizeof(SharedSample) - offsetof(SharedSample, latitude)) / sizeof(double);
+	sample.utcMilliseconds = value;
+	for (size_t i = 0; i < fieldCount; i++) {
+		fields[i] = static_cast<double>(value);
+	}
+}
+
+static bool IsConsistent(const SharedSample& sample) {
+	const double* fields = reinterpret_cast<const double*>(&sample.latitude);
+	const size_t fieldCount = (sizeof(SharedSample) - offsetof(SharedSample, latitude)) / sizeof(double);
+	for (size_t i = 0; i < fieldCount; i++) {
+		if (fields[i] != static_cast<double>(sample.utcMilliseconds)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Write for a number of seconds, returns the number of samples written
+static long long RunWriter(SharedMemoryExport& exporter, int seconds, long long first) {
+	SharedSample sample;
+	long long written = 0;
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+	// Check the clock every so often, so it is not what is measured
+	while (std::chrono::steady_clock::now() < end) {
+		for (int i = 0; i < 1000; i++) {
+			FillSample(sample, first + written);
+			exporter.Write(sample);
+			written++;
+		}
+	}
+	return written;
+}
+
+int main(int argc, char* argv[]) {
+	int seconds = argc > 1 ? std::atoi(argv[1]) : DEFAULT_SECONDS;
+
+	SharedMemoryExport exporter;
+	if (!exporter.Open(BENCHMARK_NAME)) {
+		std::printf("Could not open %s\n", BENCHMARK_NAME);
+		return 1;
+	}
+
+	long long written = RunWriter(exporter, seconds, 0);
+	std::printf("Writer alone: %.2f M samples/s\n", written / (seconds * 1e6));
+
+	const SharedHeader* shared = MapSharedSegment(BENCHMARK_NAME);
+	if ((shared == nullptr) || (!IsSharedLayout(shared))) {
+		std::printf("Could not map %s for reading\n", BENCHMARK_NAME);
+		return 1;
+	}
+
+	std::atomic<bool> isStopping(false);
+	long long reads = 0;
+	long long torn = 0;
+	unsigned long long retries = 0;
+	std::thread reader([&]() {
+		SharedSample sample;
+		while (!isStopping.load(std::memory_order_relaxed)) {
+			if (ReadSharedSample(shared, sample, &retries)) {
+				if (!IsConsistent(sample)) {
+					torn++;
+				}
+				reads++;
+			}
+		}
+	});
+	written = RunWriter(exporter, seconds, written);
+	isStopping = true;
+	reader.join();
+
+	std::printf("Writer with a reader: %.2f M samples/s\n", written / (seconds * 1e6));
+	std::printf("Reader: %.2f M reads/s, %.2f retries per read, %lld torn reads\n",
+		reads / (seconds * 1e6), reads > 0 ? static_cast<double>(retries) / reads : 0.0, torn);
+
+	UnmapSharedSegment(shared);
+	exporter.Close();
+	return torn == 0 ? 0 : 1;
+}
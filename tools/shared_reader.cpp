@@ -0,0 +1,81 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Project: Racing Plugin
+// Description: Example reader of the shared memory export
+// Owner: twocanplugin@hotmail.com
+// Date: 18/10/2026
+// Version History:
+// 1.0 Initial Release
+//
+
+// Usage: shared_reader [segment name] [samples]
+// Prints the plugin's current state once a second, mapping the segment again whenever the
+// plugin closes and reopens it.
+
+#include "shared_reader.h"
+
+// STL
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+	std::string name = argc > 1 ? argv[1] : SHARED_DEFAULT_NAME;
+	int samples = argc > 2 ? std::atoi(argv[2]) : 0;
+
+	const SharedHeader* shared = nullptr;
+	for (int printed = 0; (samples == 0) || (printed < samples); ) {
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+
+		if (shared == nullptr) {
+			shared = MapSharedSegment(name);
+			if (shared == nullptr) {
+				std::printf("Waiting for %s\n", name.c_str());
+				continue;
+			}
+		}
+
+		// Nothing else is used until the layout is known to be ours
+		if (!IsSharedLayout(shared)) {
+			std::printf("%s was not written by this version of the plugin\n", name.c_str());
+			UnmapSharedSegment(shared);
+			shared = nullptr;
+			continue;
+		}
+
+		SharedSample sample;
+		if (!ReadSharedSample(shared, sample)) {
+			std::printf("%s was closed by the plugin\n", name.c_str());
+			UnmapSharedSegment(shared);
+			shared = nullptr;
+			continue;
+		}
+
+		std::printf("%lld: SOG %.1f kn, COG %.0f, TWS %.1f kn, TWA %.0f, line %.1f m, burn %.1f s, P(over) %.2f\n",
+			static_cast<long long>(sample.utcMilliseconds), sample.speedOverGround, sample.courseOverGround,
+			sample.trueWindSpeed, sample.trueWindAngle, sample.lineDistance, sample.timeToBurn, sample.probabilityOver);
+		printed++;
+	}
+
+	if (shared != nullptr) {
+		UnmapSharedSegment(shared);
+	}
+	return 0;
+}
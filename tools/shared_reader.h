@@ -0,0 +1,102 @@
+// Copyright(C) 2026 by Steven Adler
+//
+// This file is part of Racing plugin for OpenCPN.
+//
+// Racing plugin for OpenCPN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Racing plugin for OpenCPN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with the Racing plugin for OpenCPN. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SHARED_READER_H
+#define SHARED_READER_H
+
+// Reads the segment written by the plugin's shared memory export. An example for analysis tools,
+// used by the shared_reader example and the shared memory benchmark
+
+#include "racing_shared.h"
+
+#if defined (_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// STL
+#include <atomic>
+#include <cstring>
+#include <string>
+
+// Map a segment read only, eg. "opencpn-racing". Returns nullptr if it does not exist,
+// or is too small to have been created by this version of the plugin
+inline const SharedHeader* MapSharedSegment(const std::string& name) {
+#if defined (_WIN32)
+	HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Local\\" + name).c_str());
+	if (mapping == nullptr) {
+		return nullptr;
+	}
+	// The view keeps the mapping open
+	void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(SharedHeader));
+	CloseHandle(mapping);
+	return static_cast<const SharedHeader*>(address);
+#else
+	int descriptor = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+	if (descriptor == -1) {
+		return nullptr;
+	}
+	// Reading beyond the end of a smaller segment would raise SIGBUS
+	struct stat status;
+	void* address = MAP_FAILED;
+	if ((fstat(descriptor, &status) == 0) && (status.st_size >= static_cast<off_t>(sizeof(SharedHeader)))) {
+		address = mmap(nullptr, sizeof(SharedHeader), PROT_READ, MAP_SHARED, descriptor, 0);
+	}
+	close(descriptor);
+	return address == MAP_FAILED ? nullptr : static_cast<const SharedHeader*>(address);
+#endif
+}
+
+inline void UnmapSharedSegment(const SharedHeader* shared) {
+#if defined (_WIN32)
+	UnmapViewOfFile(shared);
+#else
+	munmap(const_cast<SharedHeader*>(shared), sizeof(SharedHeader));
+#endif
+}
+
+// Whether the layout is the one we were built with. The magic and version do not change once
+// the plugin has opened the segment, so are checked before anything else is used
+inline bool IsSharedLayout(const SharedHeader* shared) {
+	return (shared->magic == SHARED_MAGIC) && (shared->version == SHARED_VERSION) &&
+		(shared->sampleSize == sizeof(SharedSample)) && (shared->ringSize == SHARED_RING_SIZE);
+}
+
+// Copy the current sample, retrying while the plugin is writing it. Returns false if the plugin
+// has closed the segment, in which case map it again later. Counts the retries, if given
+inline bool ReadSharedSample(const SharedHeader* shared, SharedSample& sample, unsigned long long* retries = nullptr) {
+	uint32_t before, after, isActive;
+	while (true) {
+		before = shared->sequence.load(std::memory_order_acquire);
+		std::memcpy(&sample, &shared->current, sizeof(sample));
+		isActive = shared->isActive;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		after = shared->sequence.load(std::memory_order_relaxed);
+		if (((before & 1) == 0) && (before == after)) {
+			return isActive != 0;
+		}
+		if (retries != nullptr) {
+			(*retries)++;
+		}
+	}
+}
+
+#endif